@@ -9,9 +9,9 @@ public class GenAIExample : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 	
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "UMG" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "UMG", "HTTP" });
 
-		PrivateDependencyModuleNames.AddRange(new string[] { "AudioMixer", "AudioCapture" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "AudioMixer", "AudioCapture", "AudioCaptureCore", "ImageWrapper", "RenderCore", "RHI", "Json" });
 
 		// Check if the GenAIForUnreal plugin directory exists as a project or engine plugin
 		string projectGenAiPluginPath = Path.Combine(ModuleDirectory, "..", "..", "Plugins", "GenAIForUnreal");
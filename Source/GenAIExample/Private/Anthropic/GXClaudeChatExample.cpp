@@ -5,6 +5,7 @@
 #if WITH_GENAI_MODULE
 #include "Models/Anthropic/GenClaudeChat.h"
 #include "Utilities/GenUtils.h"
+#include "Common/GXModelRouter.h"
 #include "Misc/Paths.h"
 #endif
 
@@ -19,7 +20,10 @@ AGXClaudeChatExample::AGXClaudeChatExample()
 
 void AGXClaudeChatExample::ClearConversation()
 {
+    SentImages.Empty();
+
 #if WITH_GENAI_MODULE
+    ++PrepareGeneration;
     ConversationHistory.Empty();
     ConversationHistory.Add(FGenClaudeChatMessage(TEXT("system"), TEXT("You are Claude, a helpful AI assistant integrated into an Unreal Engine application.")));
 #else
@@ -28,8 +32,58 @@ void AGXClaudeChatExample::ClearConversation()
 }
 
 void AGXClaudeChatExample::RequestNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, UTexture2D* Image)
+{
+    TArray<UTexture2D*> Images;
+    if (Image != nullptr)
+    {
+        Images.Add(Image);
+    }
+    RequestNonStreamingChatWithImages(UserMessage, ModelName, SystemPrompt, Images);
+}
+
+void AGXClaudeChatExample::RequestNonStreamingChatWithImages(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<UTexture2D*>& Images)
 {
 #if WITH_GENAI_MODULE
+    const uint32 Generation = ++PrepareGeneration;
+    if (Images.Num() == 0)
+    {
+        SendNonStreamingChat(UserMessage, ModelName, SystemPrompt, {});
+        return;
+    }
+
+    // The attachments are resized concurrently off the game thread; the request goes out once all of them are ready.
+    TWeakObjectPtr<AGXClaudeChatExample> WeakThis(this);
+    FGXImagePreprocessor::PrepareAllAsync(this, Images, EGXChatProvider::Anthropic, ModelName, ImagePreprocessing,
+        [WeakThis, Generation, UserMessage, ModelName, SystemPrompt](TArray<FGXImagePreprocessStats>&& Prepared)
+        {
+            // A later send or ClearConversation superseded this turn while its images were being prepared;
+            // the UI is told, so it does not wait on a reply that will never come.
+            AGXClaudeChatExample* Self = WeakThis.Get();
+            if (Self && Self->PrepareGeneration == Generation)
+            {
+                Self->SendNonStreamingChat(UserMessage, ModelName, SystemPrompt, Prepared);
+            }
+            else if (Self)
+            {
+                Self->OnUINonStreamingResponse.Broadcast(TEXT("Cancelled: a newer message or ClearConversation replaced this one before it was sent."), false);
+            }
+        });
+#else
+    // Dummy implementation
+    UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestNonStreamingChatWithImages will do nothing."));
+#endif
+}
+
+#if WITH_GENAI_MODULE
+void AGXClaudeChatExample::SendNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<FGXImagePreprocessStats>& Images)
+{
+    // Fail fast instead of hammering an endpoint whose circuit breaker is open.
+    if (!UGXModelRouter::TryAcquireFor(this, EGXChatProvider::Anthropic, ModelName))
+    {
+        OnUINonStreamingResponse.Broadcast(FString::Printf(TEXT("%s is unavailable (circuit open). Try again later."), *ModelName), false);
+        return;
+    }
+
     if (!SystemPrompt.IsEmpty())
     {
         if (ConversationHistory.Num() > 0 && ConversationHistory[0].Role == TEXT("system"))
@@ -46,9 +100,11 @@ void AGXClaudeChatExample::RequestNonStreamingChat(const FString& UserMessage, c
     TArray<FGenAIMessageContent> MessageContent;
     MessageContent.Add(FGenAIMessageContent::FromText(UserMessage));
     
-    if (Image != nullptr)
+    for (const FGXImagePreprocessStats& Prepared : Images)
     {
-        MessageContent.Add(FGenAIMessageContent::FromTexture2D(Image, EGenAIImageDetail::Auto));
+        MessageContent.Add(FGXImagePreprocessor::MakeImageContent(Prepared, EGXChatProvider::Anthropic, ImagePreprocessing));
+        SentImages.Add(Prepared.SentTexture);
+        OnImagePreprocessed.Broadcast(Prepared);
     }
 
     // 2. Add the user message to history
@@ -62,12 +118,18 @@ void AGXClaudeChatExample::RequestNonStreamingChat(const FString& UserMessage, c
     ChatSettings.bStreamResponse = false;
 
     // 4. Send the request
-    ActiveRequestNonStreaming = UGenClaudeChat::SendChatRequest(
+    const uint32 Generation = NonStreamingWatchdog.Begin();
+    const FHttpRequestPtr Request = UGenClaudeChat::SendChatRequest(
         ChatSettings,
         FOnClaudeChatCompletionResponse::CreateLambda(
-            [this](const FString& Response, const FString& ErrorMessage, bool bSuccess)
+            [this, ModelName, Generation](const FString& Response, const FString& ErrorMessage, bool bSuccess)
             {
                 if (!UGenUtils::IsContextStillValid(this)) return;
+                // The watchdog already gave up on this request and cleaned up after it.
+                if (!NonStreamingWatchdog.IsCurrent(Generation)) return;
+                NonStreamingWatchdog.Stop();
+
+                UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::Anthropic, ModelName, bSuccess);
 
                 if (bSuccess)
                 {
@@ -85,15 +147,26 @@ void AGXClaudeChatExample::RequestNonStreamingChat(const FString& UserMessage, c
                 ActiveRequestNonStreaming.Reset();
             })
     );
-#else
-    // Dummy implementation
-    UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestNonStreamingChat will do nothing."));
-#endif
+
+    // 5. Enforce the deadlines; on expiry the request is cancelled and the turn rolled back
+    if (NonStreamingWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveRequestNonStreaming = Request;
+        NonStreamingWatchdog.Watch(ActiveRequestNonStreaming, RequestTimeouts, false, [this, ModelName](EGXTimeoutKind Kind)
+        {
+            UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::Anthropic, ModelName, false, true);
+            OnUINonStreamingResponse.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind), false);
+            ConversationHistory.Pop();
+            ActiveRequestNonStreaming.Reset();
+        });
+    }
 }
+#endif
 
 void AGXClaudeChatExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 #if WITH_GENAI_MODULE
+    NonStreamingWatchdog.Stop();
     // Cancel any active requests
     if (ActiveRequestNonStreaming.IsValid())
     {
@@ -0,0 +1,281 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXAudioConverter.h"
+#include "HAL/IConsoleManager.h"
+
+#if WITH_GENAI_MODULE
+#include "Utilities/GenAIAudioUtils.h"
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXAudioConverter, Log, All);
+
+namespace
+{
+	/** Filter length in input samples. A multiple of 4 for the vector dot product. */
+	constexpr int32 GTapsPerPhase = 32;
+	constexpr int32 GHistory = GTapsPerPhase - 1;
+
+	/** Passband as a fraction of the lower Nyquist frequency; the rest is the transition band. */
+	constexpr double GPassband = 0.9;
+
+	int32 GreatestCommonDivisor(int32 A, int32 B)
+	{
+		while (B != 0)
+		{
+			const int32 Remainder = A % B;
+			A = B;
+			B = Remainder;
+		}
+		return A;
+	}
+
+	float HorizontalSum(VectorRegister4Float Vec)
+	{
+		Vec = VectorAdd(Vec, VectorSwizzle(Vec, 2, 3, 0, 1));
+		Vec = VectorAdd(Vec, VectorSwizzle(Vec, 1, 0, 3, 2));
+		return VectorGetComponent(Vec, 0);
+	}
+}
+
+void FGXAudioConverter::Configure(int32 InSampleRate, int32 InNumChannels, int32 OutSampleRate)
+{
+	check(InSampleRate > 0 && OutSampleRate > 0);
+
+	InputSampleRate = InSampleRate;
+	NumChannels = FMath::Max(1, InNumChannels);
+	OutputSampleRate = OutSampleRate;
+
+	const int32 Divisor = GreatestCommonDivisor(InSampleRate, OutSampleRate);
+	UpFactor = OutSampleRate / Divisor;
+	DownFactor = InSampleRate / Divisor;
+
+	// One windowed-sinc low-pass on the fine grid, cut below the lower of the two Nyquist frequencies,
+	// split into UpFactor phases. The UpFactor gain makes up for the zeros the fine grid inserts.
+	const int32 Length = UpFactor * GTapsPerPhase;
+	const double Cutoff = GPassband * 0.5 / FMath::Max(UpFactor, DownFactor);
+	const double Centre = (Length - 1) * 0.5;
+
+	TArray<double> Prototype;
+	Prototype.SetNumUninitialized(Length);
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		const double X = 2.0 * Cutoff * (Index - Centre);
+		const double Sinc = FMath::IsNearlyZero(X) ? 1.0 : FMath::Sin(UE_DOUBLE_PI * X) / (UE_DOUBLE_PI * X);
+		const double Phase = 2.0 * UE_DOUBLE_PI * Index / (Length - 1);
+		const double Blackman = 0.42 - 0.5 * FMath::Cos(Phase) + 0.08 * FMath::Cos(2.0 * Phase);
+		Prototype[Index] = UpFactor * 2.0 * Cutoff * Sinc * Blackman;
+	}
+
+	Coefficients.SetNumUninitialized(Length);
+	for (int32 Phase = 0; Phase < UpFactor; ++Phase)
+	{
+		for (int32 Tap = 0; Tap < GTapsPerPhase; ++Tap)
+		{
+			Coefficients[Phase * GTapsPerPhase + Tap] = static_cast<float>(Prototype[Phase + (GTapsPerPhase - 1 - Tap) * UpFactor]);
+		}
+	}
+
+	Reset();
+
+	UE_LOG(LogGXAudioConverter, Log, TEXT("Converting %d Hz x%d to %d Hz mono (%d/%d polyphase, %d taps per phase)."),
+		InputSampleRate, NumChannels, OutputSampleRate, UpFactor, DownFactor, GTapsPerPhase);
+}
+
+void FGXAudioConverter::Reset()
+{
+	Work.SetNumZeroed(FMath::Max(Work.Num(), GHistory), false);
+	FMemory::Memzero(Work.GetData(), GHistory * sizeof(float));
+	NumWork = GHistory;
+	Position = static_cast<int64>(GHistory) * UpFactor;
+}
+
+void FGXAudioConverter::Convert(const float* InAudio, int32 NumSamples, TArray<uint8>& OutPCM16)
+{
+	check(IsConfigured());
+
+	const int32 NumFrames = NumSamples / NumChannels;
+	if (NumFrames <= 0)
+	{
+		OutPCM16.Reset();
+		return;
+	}
+
+	if (UpFactor == DownFactor)
+	{
+		Resampled.SetNumUninitialized(FMath::Max(Resampled.Num(), NumFrames), false);
+		Downmix(InAudio, NumFrames, NumChannels, Resampled.GetData());
+		OutPCM16.SetNumUninitialized(NumFrames * sizeof(int16), false);
+		FloatToPCM16(Resampled.GetData(), NumFrames, reinterpret_cast<int16*>(OutPCM16.GetData()));
+		return;
+	}
+
+	// Grow only, so a steady stream stops allocating after its first buffer.
+	Work.SetNumUninitialized(FMath::Max(Work.Num(), NumWork + NumFrames), false);
+	Downmix(InAudio, NumFrames, NumChannels, Work.GetData() + NumWork);
+	NumWork += NumFrames;
+
+	const int32 MaxOut = static_cast<int32>(static_cast<int64>(NumFrames) * UpFactor / DownFactor) + 2;
+	Resampled.SetNumUninitialized(FMath::Max(Resampled.Num(), MaxOut), false);
+	const int32 NumOut = Resample(Resampled.GetData());
+
+	OutPCM16.SetNumUninitialized(NumOut * sizeof(int16), false);
+	FloatToPCM16(Resampled.GetData(), NumOut, reinterpret_cast<int16*>(OutPCM16.GetData()));
+}
+
+int32 FGXAudioConverter::Resample(float* Out)
+{
+	int32 NumOut = 0;
+	const int64 End = static_cast<int64>(NumWork) * UpFactor;
+	const float* Input = Work.GetData();
+
+	while (Position < End)
+	{
+		const int32 Base = static_cast<int32>(Position / UpFactor);
+		const int32 Phase = static_cast<int32>(Position % UpFactor);
+		const float* X = Input + Base - GHistory;
+		const float* C = Coefficients.GetData() + Phase * GTapsPerPhase;
+
+		VectorRegister4Float Acc = VectorZeroFloat();
+		for (int32 Tap = 0; Tap < GTapsPerPhase; Tap += 4)
+		{
+			Acc = VectorMultiplyAdd(VectorLoad(X + Tap), VectorLoad(C + Tap), Acc);
+		}
+		Out[NumOut++] = HorizontalSum(Acc);
+
+		Position += DownFactor;
+	}
+
+	// Keep the newest samples as the next buffer's history.
+	const int32 Consumed = NumWork - GHistory;
+	FMemory::Memmove(Work.GetData(), Work.GetData() + Consumed, GHistory * sizeof(float));
+	NumWork = GHistory;
+	Position -= static_cast<int64>(Consumed) * UpFactor;
+
+	return NumOut;
+}
+
+void FGXAudioConverter::Downmix(const float* In, int32 NumFrames, int32 NumChannels, float* Out)
+{
+	if (NumChannels == 1)
+	{
+		if (Out != In)
+		{
+			FMemory::Memcpy(Out, In, NumFrames * sizeof(float));
+		}
+		return;
+	}
+
+	int32 Frame = 0;
+	if (NumChannels == 2)
+	{
+		const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+		for (; Frame + 4 <= NumFrames; Frame += 4)
+		{
+			const VectorRegister4Float A = VectorLoad(In + Frame * 2);
+			const VectorRegister4Float B = VectorLoad(In + Frame * 2 + 4);
+			const VectorRegister4Float Left = VectorShuffle(A, B, 0, 2, 0, 2);
+			const VectorRegister4Float Right = VectorShuffle(A, B, 1, 3, 1, 3);
+			VectorStore(VectorMultiply(VectorAdd(Left, Right), Half), Out + Frame);
+		}
+	}
+
+	const float Scale = 1.f / NumChannels;
+	for (; Frame < NumFrames; ++Frame)
+	{
+		const float* Samples = In + Frame * NumChannels;
+		float Sum = 0.f;
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			Sum += Samples[Channel];
+		}
+		Out[Frame] = Sum * Scale;
+	}
+}
+
+void FGXAudioConverter::FloatToPCM16(const float* In, int32 Num, int16* Out)
+{
+	int32 Index = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	const float32x4_t Scale = vdupq_n_f32(32767.f);
+	const float32x4_t One = vdupq_n_f32(1.f);
+	const float32x4_t MinusOne = vdupq_n_f32(-1.f);
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		const float32x4_t Low = vmulq_f32(vmaxq_f32(vminq_f32(vld1q_f32(In + Index), One), MinusOne), Scale);
+		const float32x4_t High = vmulq_f32(vmaxq_f32(vminq_f32(vld1q_f32(In + Index + 4), One), MinusOne), Scale);
+		vst1q_s16(Out + Index, vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(Low)), vqmovn_s32(vcvtnq_s32_f32(High))));
+	}
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+	const __m128 Scale = _mm_set1_ps(32767.f);
+	const __m128 One = _mm_set1_ps(1.f);
+	const __m128 MinusOne = _mm_set1_ps(-1.f);
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		const __m128 Low = _mm_mul_ps(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(In + Index), One), MinusOne), Scale);
+		const __m128 High = _mm_mul_ps(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(In + Index + 4), One), MinusOne), Scale);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Out + Index), _mm_packs_epi32(_mm_cvtps_epi32(Low), _mm_cvtps_epi32(High)));
+	}
+#endif
+
+	for (; Index < Num; ++Index)
+	{
+		Out[Index] = static_cast<int16>(FMath::RoundToInt(FMath::Clamp(In[Index], -1.f, 1.f) * 32767.f));
+	}
+}
+
+namespace
+{
+	void BenchmarkConverter(const TArray<FString>& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 2000;
+
+		// What the realtime example receives with the project's mixer settings: 1024 stereo frames at 48 kHz.
+		constexpr int32 Frames = 1024;
+		constexpr int32 Channels = 2;
+		constexpr int32 SampleRate = 48000;
+
+		TArray<float> Input;
+		Input.SetNumUninitialized(Frames * Channels);
+		FRandomStream Random(1234);
+		for (int32 Frame = 0; Frame < Frames; ++Frame)
+		{
+			const float Tone = 0.5f * FMath::Sin(2.f * UE_PI * 440.f * Frame / SampleRate);
+			Input[Frame * 2] = Tone + Random.FRandRange(-0.05f, 0.05f);
+			Input[Frame * 2 + 1] = Tone + Random.FRandRange(-0.05f, 0.05f);
+		}
+
+		FGXAudioConverter Converter;
+		Converter.Configure(SampleRate, Channels, 24000);
+		TArray<uint8> Output;
+		int64 Bytes = 0;
+
+		double Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Converter.Convert(Input.GetData(), Input.Num(), Output);
+			Bytes += Output.Num();
+		}
+		const double ConverterUs = (FPlatformTime::Seconds() - Start) * 1e6 / Iterations;
+
+#if WITH_GENAI_MODULE
+		Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const TArray<uint8> PluginOutput = UGenAIAudioUtils::ConvertAudioToPCM16Mono24kHz(Input.GetData(), Input.Num(), Channels);
+			Bytes += PluginOutput.Num();
+		}
+		const double PluginUs = (FPlatformTime::Seconds() - Start) * 1e6 / Iterations;
+
+		UE_LOG(LogGXAudioConverter, Display, TEXT("%d buffers of %d frames: FGXAudioConverter %.2f us/buffer, ConvertAudioToPCM16Mono24kHz %.2f us/buffer (%.1fx). [%lld bytes]"),
+			Iterations, Frames, ConverterUs, PluginUs, PluginUs / FMath::Max(ConverterUs, 1e-3), Bytes);
+#else
+		UE_LOG(LogGXAudioConverter, Display, TEXT("%d buffers of %d frames: FGXAudioConverter %.2f us/buffer. [%lld bytes]"), Iterations, Frames, ConverterUs, Bytes);
+#endif
+	}
+
+	FAutoConsoleCommand GBenchmarkConverterCommand(
+		TEXT("GenAI.Audio.BenchmarkConverter"),
+		TEXT("Times FGXAudioConverter against the plugin's ConvertAudioToPCM16Mono24kHz on 1024-frame stereo 48 kHz buffers. Argument: iterations (default 2000)."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkConverter));
+}
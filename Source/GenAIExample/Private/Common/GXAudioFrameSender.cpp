@@ -0,0 +1,153 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXAudioFrameSender.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXAudioFrameSender, Log, All);
+
+FGXAudioFrameSender::~FGXAudioFrameSender()
+{
+	Shutdown(false);
+	if (WakeEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	}
+}
+
+bool FGXAudioFrameSender::Start(int32 SampleRate, int32 FrameMs, float BufferSeconds, FSendFrame InSend, FOnFlushed InOnFlushed)
+{
+	Shutdown(false);
+
+	if (SampleRate <= 0 || FrameMs <= 0 || !InSend)
+	{
+		return false;
+	}
+
+	FrameSamples = FMath::Max(1, SampleRate * FrameMs / 1000);
+	// Wake at least twice per frame even if a trigger is missed, so a frame is never held back long.
+	WaitMs = FMath::Max(1, FrameMs / 2);
+	FrameBuffer.SetNumUninitialized(FrameSamples * sizeof(int16));
+	Ring.Reserve(FMath::Max(FrameSamples * 2, FMath::CeilToInt(BufferSeconds * SampleRate)));
+	Send = MoveTemp(InSend);
+	OnFlushed = MoveTemp(InOnFlushed);
+	bStopping.store(false, std::memory_order_relaxed);
+	bFlushRequested.store(false, std::memory_order_relaxed);
+	bFlushOnStop = false;
+	DroppedSamples.store(0, std::memory_order_relaxed);
+
+	// Kept until destruction so a late Push() racing Shutdown() never sees it returned to the pool.
+	if (!WakeEvent)
+	{
+		WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	}
+	Thread = FRunnableThread::Create(this, TEXT("GXAudioFrameSender"), 0, TPri_AboveNormal);
+	if (!Thread)
+	{
+		UE_LOG(LogGXAudioFrameSender, Error, TEXT("Could not create the audio sender thread."));
+		return false;
+	}
+	bAccepting.store(true, std::memory_order_release);
+
+	UE_LOG(LogGXAudioFrameSender, Log, TEXT("Sending %d ms frames (%d samples at %d Hz), buffering up to %d samples."),
+		FrameMs, FrameSamples, SampleRate, Ring.GetCapacity());
+	return true;
+}
+
+void FGXAudioFrameSender::Shutdown(bool bFlush)
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	bAccepting.store(false, std::memory_order_release);
+	bFlushOnStop = bFlush;
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+	Send = nullptr;
+	OnFlushed = nullptr;
+
+	if (const int64 Dropped = GetDroppedSamples())
+	{
+		UE_LOG(LogGXAudioFrameSender, Warning, TEXT("The sender fell behind; %lld samples of audio were dropped."), Dropped);
+	}
+}
+
+void FGXAudioFrameSender::Push(const int16* Samples, int32 NumSamples)
+{
+	if (!bAccepting.load(std::memory_order_acquire) || NumSamples <= 0)
+	{
+		return;
+	}
+
+	const int32 Written = Ring.Write(Samples, NumSamples);
+	if (Written < NumSamples)
+	{
+		DroppedSamples.fetch_add(NumSamples - Written, std::memory_order_relaxed);
+	}
+	if (Ring.Num() >= FrameSamples)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FGXAudioFrameSender::Flush()
+{
+	if (bAccepting.load(std::memory_order_acquire))
+	{
+		bFlushRequested.store(true, std::memory_order_release);
+		WakeEvent->Trigger();
+	}
+}
+
+uint32 FGXAudioFrameSender::Run()
+{
+	while (!bStopping.load(std::memory_order_acquire))
+	{
+		WakeEvent->Wait(WaitMs);
+
+		// Acquiring the request makes every sample pushed before Flush() visible to this drain.
+		const bool bFlush = bFlushRequested.exchange(false, std::memory_order_acq_rel);
+		Drain(bFlush);
+		if (bFlush && OnFlushed)
+		{
+			OnFlushed();
+		}
+	}
+	Drain(bFlushOnStop);
+	return 0;
+}
+
+void FGXAudioFrameSender::Stop()
+{
+	bStopping.store(true, std::memory_order_release);
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FGXAudioFrameSender::Drain(bool bIncludePartial)
+{
+	int16* Frame = reinterpret_cast<int16*>(FrameBuffer.GetData());
+	while (Ring.Num() >= FrameSamples)
+	{
+		Ring.Read(Frame, FrameSamples);
+		Send(FrameBuffer);
+	}
+
+	if (bIncludePartial)
+	{
+		if (const int32 Remaining = Ring.Read(Frame, FrameSamples))
+		{
+			// Shrinking without reallocating keeps the buffer's capacity for the next Start().
+			FrameBuffer.SetNum(Remaining * sizeof(int16), false);
+			Send(FrameBuffer);
+			FrameBuffer.SetNumUninitialized(FrameSamples * sizeof(int16), false);
+		}
+	}
+}
@@ -0,0 +1,414 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXBlockCompressor.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	/** One 4x4 block. Colours are (R, G, B, unused) in 0-255. */
+	struct FBlock
+	{
+		VectorRegister4Float Colors[16];
+		uint8 Alpha[16];
+	};
+
+	/** Weight of endpoint 0 for each BC1 index: c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1. */
+	constexpr float GIndexWeights[4] = { 1.f, 0.f, 2.f / 3.f, 1.f / 3.f };
+
+	/** Reads a block, repeating the last row and column where a small mip is not a whole block. */
+	void LoadBlock(const uint8* Pixels, int32 Width, int32 Height, int32 BlockX, int32 BlockY, FBlock& OutBlock)
+	{
+		for (int32 Y = 0; Y < 4; ++Y)
+		{
+			const int32 SourceY = FMath::Min(BlockY * 4 + Y, Height - 1);
+			for (int32 X = 0; X < 4; ++X)
+			{
+				const int32 SourceX = FMath::Min(BlockX * 4 + X, Width - 1);
+				const uint8* Pixel = Pixels + (static_cast<int64>(SourceY) * Width + SourceX) * 4;
+				OutBlock.Colors[Y * 4 + X] = MakeVectorRegisterFloat(static_cast<float>(Pixel[2]), static_cast<float>(Pixel[1]), static_cast<float>(Pixel[0]), 0.f);
+				OutBlock.Alpha[Y * 4 + X] = Pixel[3];
+			}
+		}
+	}
+
+	VectorRegister4Float ClampColor(const VectorRegister4Float& Color)
+	{
+		return VectorMin(VectorMax(Color, VectorZeroFloat()), VectorSetFloat1(255.f));
+	}
+
+	uint16 QuantizeRGB565(const VectorRegister4Float& Color)
+	{
+		alignas(16) float Components[4];
+		VectorStoreAligned(ClampColor(Color), Components);
+		const uint32 R = FMath::RoundToInt(Components[0] * (31.f / 255.f));
+		const uint32 G = FMath::RoundToInt(Components[1] * (63.f / 255.f));
+		const uint32 B = FMath::RoundToInt(Components[2] * (31.f / 255.f));
+		return static_cast<uint16>((R << 11) | (G << 5) | B);
+	}
+
+	/** The colour the GPU reconstructs from a 565 endpoint. */
+	VectorRegister4Float ExpandRGB565(uint16 Packed)
+	{
+		const uint32 R = (Packed >> 11) & 31;
+		const uint32 G = (Packed >> 5) & 63;
+		const uint32 B = Packed & 31;
+		return MakeVectorRegisterFloat(static_cast<float>((R << 3) | (R >> 2)), static_cast<float>((G << 2) | (G >> 4)), static_cast<float>((B << 3) | (B >> 2)), 0.f);
+	}
+
+	float DistanceSquared(const VectorRegister4Float& A, const VectorRegister4Float& B)
+	{
+		const VectorRegister4Float Delta = VectorSubtract(A, B);
+		return VectorGetComponent(VectorDot3(Delta, Delta), 0);
+	}
+
+	/** Picks the nearest palette entry for every pixel. Returns the packed indices; OutError receives the summed squared error. */
+	uint32 SelectColorIndices(const FBlock& Block, uint16 Color0, uint16 Color1, float& OutError)
+	{
+		const VectorRegister4Float End0 = ExpandRGB565(Color0);
+		const VectorRegister4Float End1 = ExpandRGB565(Color1);
+		const VectorRegister4Float Third = VectorSetFloat1(1.f / 3.f);
+		const VectorRegister4Float Palette[4] =
+		{
+			End0,
+			End1,
+			VectorMultiply(VectorAdd(VectorAdd(End0, End0), End1), Third),
+			VectorMultiply(VectorAdd(VectorAdd(End1, End1), End0), Third)
+		};
+
+		uint32 Indices = 0;
+		OutError = 0.f;
+		for (int32 Pixel = 0; Pixel < 16; ++Pixel)
+		{
+			uint32 BestIndex = 0;
+			float BestError = DistanceSquared(Block.Colors[Pixel], Palette[0]);
+			for (uint32 Index = 1; Index < 4; ++Index)
+			{
+				const float Error = DistanceSquared(Block.Colors[Pixel], Palette[Index]);
+				if (Error < BestError)
+				{
+					BestError = Error;
+					BestIndex = Index;
+				}
+			}
+			Indices |= BestIndex << (Pixel * 2);
+			OutError += BestError;
+		}
+		return Indices;
+	}
+
+	/** Endpoints at the extremes of the block's colours along its principal axis. */
+	void FindPrincipalEndpoints(const FBlock& Block, const VectorRegister4Float& MinColor, const VectorRegister4Float& MaxColor, VectorRegister4Float& OutStart, VectorRegister4Float& OutEnd)
+	{
+		VectorRegister4Float Mean = VectorZeroFloat();
+		for (const VectorRegister4Float& Color : Block.Colors)
+		{
+			Mean = VectorAdd(Mean, Color);
+		}
+		Mean = VectorMultiply(Mean, VectorSetFloat1(1.f / 16.f));
+
+		// Rows of the (symmetric) colour covariance matrix.
+		VectorRegister4Float CovR = VectorZeroFloat();
+		VectorRegister4Float CovG = VectorZeroFloat();
+		VectorRegister4Float CovB = VectorZeroFloat();
+		for (const VectorRegister4Float& Color : Block.Colors)
+		{
+			const VectorRegister4Float Delta = VectorSubtract(Color, Mean);
+			CovR = VectorMultiplyAdd(Delta, VectorReplicate(Delta, 0), CovR);
+			CovG = VectorMultiplyAdd(Delta, VectorReplicate(Delta, 1), CovG);
+			CovB = VectorMultiplyAdd(Delta, VectorReplicate(Delta, 2), CovB);
+		}
+
+		// A few power iterations from the bounding-box diagonal converge for all but degenerate blocks.
+		VectorRegister4Float Axis = VectorSubtract(MaxColor, MinColor);
+		for (int32 Iteration = 0; Iteration < 4; ++Iteration)
+		{
+			Axis = VectorMultiplyAdd(CovR, VectorReplicate(Axis, 0), VectorMultiplyAdd(CovG, VectorReplicate(Axis, 1), VectorMultiply(CovB, VectorReplicate(Axis, 2))));
+			const float LengthSquared = VectorGetComponent(VectorDot3(Axis, Axis), 0);
+			if (LengthSquared < UE_SMALL_NUMBER)
+			{
+				// Flat block: every pixel is the mean.
+				OutStart = OutEnd = Mean;
+				return;
+			}
+			Axis = VectorMultiply(Axis, VectorSetFloat1(FMath::InvSqrt(LengthSquared)));
+		}
+
+		float MinProjection = UE_BIG_NUMBER;
+		float MaxProjection = -UE_BIG_NUMBER;
+		for (const VectorRegister4Float& Color : Block.Colors)
+		{
+			const float Projection = VectorGetComponent(VectorDot3(VectorSubtract(Color, Mean), Axis), 0);
+			MinProjection = FMath::Min(MinProjection, Projection);
+			MaxProjection = FMath::Max(MaxProjection, Projection);
+		}
+		OutStart = VectorMultiplyAdd(Axis, VectorSetFloat1(MaxProjection), Mean);
+		OutEnd = VectorMultiplyAdd(Axis, VectorSetFloat1(MinProjection), Mean);
+	}
+
+	/** Least-squares endpoints for a fixed set of indices. Returns false if the indices do not constrain both endpoints. */
+	bool RefineEndpoints(const FBlock& Block, uint32 Indices, VectorRegister4Float& OutStart, VectorRegister4Float& OutEnd)
+	{
+		float AlphaSquared = 0.f;
+		float BetaSquared = 0.f;
+		float AlphaBeta = 0.f;
+		VectorRegister4Float AlphaColor = VectorZeroFloat();
+		VectorRegister4Float BetaColor = VectorZeroFloat();
+		for (int32 Pixel = 0; Pixel < 16; ++Pixel)
+		{
+			const float Alpha = GIndexWeights[(Indices >> (Pixel * 2)) & 3];
+			const float Beta = 1.f - Alpha;
+			AlphaSquared += Alpha * Alpha;
+			BetaSquared += Beta * Beta;
+			AlphaBeta += Alpha * Beta;
+			AlphaColor = VectorMultiplyAdd(Block.Colors[Pixel], VectorSetFloat1(Alpha), AlphaColor);
+			BetaColor = VectorMultiplyAdd(Block.Colors[Pixel], VectorSetFloat1(Beta), BetaColor);
+		}
+
+		const float Determinant = AlphaSquared * BetaSquared - AlphaBeta * AlphaBeta;
+		if (FMath::Abs(Determinant) < UE_KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+		const VectorRegister4Float InvDeterminant = VectorSetFloat1(1.f / Determinant);
+		OutStart = ClampColor(VectorMultiply(VectorSubtract(VectorMultiply(AlphaColor, VectorSetFloat1(BetaSquared)), VectorMultiply(BetaColor, VectorSetFloat1(AlphaBeta))), InvDeterminant));
+		OutEnd = ClampColor(VectorMultiply(VectorSubtract(VectorMultiply(BetaColor, VectorSetFloat1(AlphaSquared)), VectorMultiply(AlphaColor, VectorSetFloat1(AlphaBeta))), InvDeterminant));
+		return true;
+	}
+
+	/** Writes an 8-byte BC1 colour block, always in four-colour mode so it is also valid inside BC3. */
+	void EncodeColorBlock(const FBlock& Block, EGXCompressionQuality Quality, uint8* Out)
+	{
+		VectorRegister4Float MinColor = Block.Colors[0];
+		VectorRegister4Float MaxColor = Block.Colors[0];
+		for (int32 Pixel = 1; Pixel < 16; ++Pixel)
+		{
+			MinColor = VectorMin(MinColor, Block.Colors[Pixel]);
+			MaxColor = VectorMax(MaxColor, Block.Colors[Pixel]);
+		}
+
+		VectorRegister4Float Start = MaxColor;
+		VectorRegister4Float End = MinColor;
+		if (Quality != EGXCompressionQuality::Fast)
+		{
+			FindPrincipalEndpoints(Block, MinColor, MaxColor, Start, End);
+		}
+
+		// Pull the endpoints in slightly: the interpolated colours then cover the block's spread better.
+		const VectorRegister4Float Inset = VectorMultiply(VectorSubtract(Start, End), VectorSetFloat1(1.f / 16.f));
+		uint16 Color0 = QuantizeRGB565(VectorSubtract(Start, Inset));
+		uint16 Color1 = QuantizeRGB565(VectorAdd(End, Inset));
+
+		float Error = 0.f;
+		uint32 Indices = SelectColorIndices(Block, Color0, Color1, Error);
+
+		if (Quality == EGXCompressionQuality::High)
+		{
+			for (int32 Iteration = 0; Iteration < 2 && Error > 0.f; ++Iteration)
+			{
+				VectorRegister4Float RefinedStart;
+				VectorRegister4Float RefinedEnd;
+				if (!RefineEndpoints(Block, Indices, RefinedStart, RefinedEnd)) break;
+
+				const uint16 RefinedColor0 = QuantizeRGB565(RefinedStart);
+				const uint16 RefinedColor1 = QuantizeRGB565(RefinedEnd);
+				float RefinedError = 0.f;
+				const uint32 RefinedIndices = SelectColorIndices(Block, RefinedColor0, RefinedColor1, RefinedError);
+				if (RefinedError >= Error) break;
+
+				Color0 = RefinedColor0;
+				Color1 = RefinedColor1;
+				Indices = RefinedIndices;
+				Error = RefinedError;
+			}
+		}
+
+		// Four-colour mode needs Color0 > Color1. Swapping the endpoints swaps index 0 with 1 and 2 with 3.
+		if (Color0 < Color1)
+		{
+			Swap(Color0, Color1);
+			Indices ^= 0x55555555;
+		}
+		else if (Color0 == Color1)
+		{
+			Indices = 0;
+		}
+
+		Out[0] = static_cast<uint8>(Color0);
+		Out[1] = static_cast<uint8>(Color0 >> 8);
+		Out[2] = static_cast<uint8>(Color1);
+		Out[3] = static_cast<uint8>(Color1 >> 8);
+		for (int32 Byte = 0; Byte < 4; ++Byte)
+		{
+			Out[4 + Byte] = static_cast<uint8>(Indices >> (Byte * 8));
+		}
+	}
+
+	/** Writes an 8-byte BC3 alpha block in eight-value mode. */
+	void EncodeAlphaBlock(const FBlock& Block, uint8* Out)
+	{
+		uint8 MinAlpha = Block.Alpha[0];
+		uint8 MaxAlpha = Block.Alpha[0];
+		for (int32 Pixel = 1; Pixel < 16; ++Pixel)
+		{
+			MinAlpha = FMath::Min(MinAlpha, Block.Alpha[Pixel]);
+			MaxAlpha = FMath::Max(MaxAlpha, Block.Alpha[Pixel]);
+		}
+		Out[0] = MaxAlpha;
+		Out[1] = MinAlpha;
+
+		uint64 Indices = 0;
+		if (MaxAlpha > MinAlpha)
+		{
+			// The palette is an even ramp from MaxAlpha (step 0) to MinAlpha (step 7); step 0 is index 0,
+			// step 7 is index 1 and the steps between are indices 2 to 7.
+			const float StepScale = 7.f / static_cast<float>(MaxAlpha - MinAlpha);
+			for (int32 Pixel = 0; Pixel < 16; ++Pixel)
+			{
+				const int32 Step = FMath::RoundToInt(static_cast<float>(MaxAlpha - Block.Alpha[Pixel]) * StepScale);
+				const uint64 Index = Step == 0 ? 0 : (Step == 7 ? 1 : Step + 1);
+				Indices |= Index << (Pixel * 3);
+			}
+		}
+		for (int32 Byte = 0; Byte < 6; ++Byte)
+		{
+			Out[2 + Byte] = static_cast<uint8>(Indices >> (Byte * 8));
+		}
+	}
+
+	void EncodeLevel(const TArray64<uint8>& Pixels, int32 Width, int32 Height, EPixelFormat Format, EGXCompressionQuality Quality, TArray64<uint8>& OutBlocks)
+	{
+		const int32 BlocksX = FMath::DivideAndRoundUp(Width, 4);
+		const int32 BlocksY = FMath::DivideAndRoundUp(Height, 4);
+		const int32 BlockBytes = Format == PF_DXT1 ? 8 : 16;
+		OutBlocks.SetNumUninitialized(static_cast<int64>(BlocksX) * BlocksY * BlockBytes);
+
+		ParallelFor(BlocksY, [&Pixels, &OutBlocks, Width, Height, Format, Quality, BlocksX, BlockBytes](int32 BlockY)
+		{
+			FBlock Block;
+			uint8* Out = OutBlocks.GetData() + static_cast<int64>(BlockY) * BlocksX * BlockBytes;
+			for (int32 BlockX = 0; BlockX < BlocksX; ++BlockX, Out += BlockBytes)
+			{
+				LoadBlock(Pixels.GetData(), Width, Height, BlockX, BlockY, Block);
+				if (Format == PF_DXT5)
+				{
+					EncodeAlphaBlock(Block, Out);
+					EncodeColorBlock(Block, Quality, Out + 8);
+				}
+				else
+				{
+					EncodeColorBlock(Block, Quality, Out);
+				}
+			}
+		}, BlocksY < 16 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+}
+
+int64 FGXCompressedImage::GetSizeBytes() const
+{
+	int64 Bytes = 0;
+	for (const TArray64<uint8>& Mip : Mips)
+	{
+		Bytes += Mip.Num();
+	}
+	return Bytes;
+}
+
+bool FGXBlockCompressor::Compress(TArray64<uint8>&& Pixels, int32 Width, int32 Height, const FGXTextureCompressionSettings& Settings, FGXCompressedImage& OutImage)
+{
+	// Block-compressed textures need a whole number of blocks in the top mip.
+	if (Width <= 0 || Height <= 0 || Width % 4 != 0 || Height % 4 != 0 || Pixels.Num() != static_cast<int64>(Width) * Height * 4)
+	{
+		return false;
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	EPixelFormat Format = PF_B8G8R8A8;
+	switch (Settings.Compression)
+	{
+	case EGXTextureCompression::BC1:  Format = PF_DXT1; break;
+	case EGXTextureCompression::BC3:  Format = PF_DXT5; break;
+	case EGXTextureCompression::Auto: Format = IsOpaque(Pixels) ? PF_DXT1 : PF_DXT5; break;
+	default: break;
+	}
+
+	TArray<TArray64<uint8>> Mips;
+	if (Settings.bGenerateMips)
+	{
+		Mips = BuildMipChain(MoveTemp(Pixels), Width, Height);
+	}
+	else
+	{
+		Mips.Add(MoveTemp(Pixels));
+	}
+
+	if (Format != PF_B8G8R8A8)
+	{
+		for (int32 Level = 0; Level < Mips.Num(); ++Level)
+		{
+			TArray64<uint8> Blocks;
+			EncodeLevel(Mips[Level], FMath::Max(1, Width >> Level), FMath::Max(1, Height >> Level), Format, Settings.Quality, Blocks);
+			Mips[Level] = MoveTemp(Blocks);
+		}
+	}
+
+	OutImage.Format = Format;
+	OutImage.Width = Width;
+	OutImage.Height = Height;
+	OutImage.Mips = MoveTemp(Mips);
+	OutImage.CompressMs = static_cast<float>((FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	return true;
+}
+
+TArray<TArray64<uint8>> FGXBlockCompressor::BuildMipChain(TArray64<uint8>&& Pixels, int32 Width, int32 Height)
+{
+	const int32 MipCount = FMath::FloorLog2(FMath::Max(Width, Height)) + 1;
+	TArray<TArray64<uint8>> Mips;
+	Mips.SetNum(MipCount);
+	Mips[0] = MoveTemp(Pixels);
+
+	for (int32 Level = 1; Level < MipCount; ++Level)
+	{
+		const TArray64<uint8>& Source = Mips[Level - 1];
+		const int32 SourceWidth = FMath::Max(1, Width >> (Level - 1));
+		const int32 SourceHeight = FMath::Max(1, Height >> (Level - 1));
+		const int32 DestWidth = FMath::Max(1, Width >> Level);
+		const int32 DestHeight = FMath::Max(1, Height >> Level);
+		TArray64<uint8>& Dest = Mips[Level];
+		Dest.SetNumUninitialized(static_cast<int64>(DestWidth) * DestHeight * 4);
+
+		// 2x2 box filter. Odd edges reuse the last row or column.
+		ParallelFor(DestHeight, [&Source, &Dest, SourceWidth, SourceHeight, DestWidth](int32 Y)
+		{
+			const int32 Y0 = FMath::Min(Y * 2, SourceHeight - 1);
+			const int32 Y1 = FMath::Min(Y * 2 + 1, SourceHeight - 1);
+			for (int32 X = 0; X < DestWidth; ++X)
+			{
+				const int32 X0 = FMath::Min(X * 2, SourceWidth - 1);
+				const int32 X1 = FMath::Min(X * 2 + 1, SourceWidth - 1);
+				const uint8* P00 = &Source[(static_cast<int64>(Y0) * SourceWidth + X0) * 4];
+				const uint8* P01 = &Source[(static_cast<int64>(Y0) * SourceWidth + X1) * 4];
+				const uint8* P10 = &Source[(static_cast<int64>(Y1) * SourceWidth + X0) * 4];
+				const uint8* P11 = &Source[(static_cast<int64>(Y1) * SourceWidth + X1) * 4];
+				uint8* Out = &Dest[(static_cast<int64>(Y) * DestWidth + X) * 4];
+				for (int32 Channel = 0; Channel < 4; ++Channel)
+				{
+					Out[Channel] = static_cast<uint8>((P00[Channel] + P01[Channel] + P10[Channel] + P11[Channel] + 2) >> 2);
+				}
+			}
+		}, DestHeight < 64 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+	return Mips;
+}
+
+bool FGXBlockCompressor::IsOpaque(const TArray64<uint8>& Pixels)
+{
+	for (int64 Index = 3; Index < Pixels.Num(); Index += 4)
+	{
+		if (Pixels[Index] != 255)
+		{
+			return false;
+		}
+	}
+	return true;
+}
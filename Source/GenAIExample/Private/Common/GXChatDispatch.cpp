@@ -0,0 +1,267 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXChatDispatch.h"
+#include "Common/GXImagePreprocessor.h"
+
+#if WITH_GENAI_MODULE
+#include "Data/GenAIMessageStructs.h"
+#include "Data/OpenAI/GenOAIStreamStructs.h"
+#include "Data/Anthropic/GenClaudeChatStructs.h"
+#include "Data/Google/GenGeminiChatStructs.h"
+#include "Data/Google/GenGeminiStreamStructs.h"
+#include "Data/XAI/GenXAIChatStructs.h"
+#include "Data/XAI/GenXAIChatStreamStructs.h"
+#include "Data/DeepSeek/GenDeepSeekStructs.h"
+#include "Models/OpenAI/GenOAIChatStream.h"
+#include "Models/Anthropic/GenClaudeChat.h"
+#include "Models/Google/GenGeminiChatStream.h"
+#include "Models/XAI/GenXAIChatStream.h"
+#include "Models/DeepSeek/GenDSeekChatStream.h"
+#endif
+
+#if WITH_GENAI_MODULE
+namespace
+{
+	/** Shared between the delegate copies so completion is reported once and text is accumulated in one place. */
+	struct FDispatchState
+	{
+		FGXChatDispatchCallbacks Callbacks;
+		FString Accumulated;
+		bool bCompleted = false;
+
+		void Delta(const FString& Text)
+		{
+			if (bCompleted || Text.IsEmpty()) return;
+			Accumulated += Text;
+			if (Callbacks.OnDelta) Callbacks.OnDelta(Text);
+		}
+
+		void Complete(const FString& Response, const FString& Error, bool bSuccess)
+		{
+			if (bCompleted) return;
+			bCompleted = true;
+			if (Callbacks.OnComplete) Callbacks.OnComplete(Response, Error, bSuccess);
+		}
+	};
+
+	TArray<FGenAIMessageContent> BuildContent(const FGXChatTurn& Turn, const FGXModelEndpoint& Endpoint, bool bWithImages)
+	{
+		TArray<FGenAIMessageContent> Content;
+		Content.Add(FGenAIMessageContent::FromText(Turn.Text));
+		if (bWithImages)
+		{
+			for (UTexture2D* Image : Turn.Images)
+			{
+				if (Image != nullptr)
+				{
+					// Resized copies are cached, so resending the history does not redo the work.
+					Content.Add(FGXImagePreprocessor::MakeImageContent(Image, Endpoint.Provider, Endpoint.Model, FGXImagePreprocessSettings()));
+				}
+			}
+		}
+		return Content;
+	}
+
+	FHttpRequestPtr SendOpenAI(const FGXModelEndpoint& Endpoint, const FString& SystemPrompt, const TArray<FGXChatTurn>& Turns, TSharedRef<FDispatchState> State)
+	{
+		const bool bVision = Endpoint.HasCapabilities(static_cast<int32>(EGXModelCapability::Vision));
+
+		FGenOpenAIChatSettings ChatSettings;
+		ChatSettings.Model = Endpoint.Model;
+		ChatSettings.bStream = true;
+		if (!SystemPrompt.IsEmpty())
+		{
+			ChatSettings.Messages.Add(FGenChatMessage(TEXT("system"), SystemPrompt));
+		}
+		for (const FGXChatTurn& Turn : Turns)
+		{
+			ChatSettings.Messages.Add(FGenChatMessage(Turn.Role, BuildContent(Turn, Endpoint, bVision)));
+		}
+
+		return UGenOAIChatStream::SendStreamChatRequest(ChatSettings, FOnOpenAIChatStreamResponse::CreateLambda(
+			[State](const FGenOpenAIStreamEvent& StreamEvent)
+			{
+				if (!StreamEvent.bSuccess)
+				{
+					State->Complete(FString(), StreamEvent.ErrorMessage, false);
+					return;
+				}
+				switch (StreamEvent.EventType)
+				{
+					case EOpenAIStreamEventType::ResponseOutputTextDelta:
+						State->Delta(StreamEvent.DeltaContent);
+						break;
+					case EOpenAIStreamEventType::ResponseCompleted:
+						State->Complete(StreamEvent.DeltaContent.IsEmpty() ? State->Accumulated : StreamEvent.DeltaContent, FString(), true);
+						break;
+					case EOpenAIStreamEventType::ResponseFailed:
+					case EOpenAIStreamEventType::Error:
+						State->Complete(FString(), StreamEvent.ErrorMessage, false);
+						break;
+					default:
+						break;
+				}
+			}));
+	}
+
+	FHttpRequestPtr SendClaude(const FGXModelEndpoint& Endpoint, const FString& SystemPrompt, const TArray<FGXChatTurn>& Turns, TSharedRef<FDispatchState> State)
+	{
+		const bool bVision = Endpoint.HasCapabilities(static_cast<int32>(EGXModelCapability::Vision));
+
+		FGenClaudeChatSettings ChatSettings;
+		ChatSettings.Model = Endpoint.Model;
+		ChatSettings.MaxTokens = 1500;
+		ChatSettings.bStreamResponse = false;
+		if (!SystemPrompt.IsEmpty())
+		{
+			ChatSettings.Messages.Add(FGenClaudeChatMessage(TEXT("system"), SystemPrompt));
+		}
+		for (const FGXChatTurn& Turn : Turns)
+		{
+			ChatSettings.Messages.Add(FGenClaudeChatMessage(Turn.Role, BuildContent(Turn, Endpoint, bVision)));
+		}
+
+		return UGenClaudeChat::SendChatRequest(ChatSettings, FOnClaudeChatCompletionResponse::CreateLambda(
+			[State](const FString& Response, const FString& ErrorMessage, bool bSuccess)
+			{
+				State->Complete(Response, ErrorMessage, bSuccess);
+			}));
+	}
+
+	FHttpRequestPtr SendGemini(const FGXModelEndpoint& Endpoint, const FString& SystemPrompt, const TArray<FGXChatTurn>& Turns, TSharedRef<FDispatchState> State)
+	{
+		FGenGoogleChatSettings ChatSettings;
+		ChatSettings.Model = Endpoint.Model;
+		// Gemini prefers the 'user'/'model' role cycle, so the system prompt becomes an acknowledged first exchange.
+		if (!SystemPrompt.IsEmpty())
+		{
+			ChatSettings.Messages.Add(FGenGeminiMessage(TEXT("user"), SystemPrompt));
+			ChatSettings.Messages.Add(FGenGeminiMessage(TEXT("model"), FString(TEXT("Okay, I will follow these instructions."))));
+		}
+		for (const FGXChatTurn& Turn : Turns)
+		{
+			ChatSettings.Messages.Add(FGenGeminiMessage(Turn.Role == TEXT("assistant") ? TEXT("model") : TEXT("user"), Turn.Text));
+		}
+
+		return UGenGeminiChatStream::SendStreamChatRequest(ChatSettings, FOnGeminiChatStreamResponse::CreateLambda(
+			[State](EGoogleGeminiStreamEventType EventType, const FGeminiGenerateContentResponseChunk& Chunk, const FString& ErrorMessage, bool bSuccess)
+			{
+				if (!bSuccess)
+				{
+					State->Complete(FString(), ErrorMessage, false);
+					return;
+				}
+				switch (EventType)
+				{
+					case EGoogleGeminiStreamEventType::ChunkReceived:
+						if (Chunk.Candidates.Num() > 0 && Chunk.Candidates[0].Content.Parts.Num() > 0)
+						{
+							State->Delta(Chunk.Candidates[0].Content.Parts[0].Text);
+						}
+						break;
+					case EGoogleGeminiStreamEventType::Completed:
+						State->Complete(State->Accumulated, FString(), true);
+						break;
+					case EGoogleGeminiStreamEventType::Error:
+						State->Complete(FString(), ErrorMessage, false);
+						break;
+					default:
+						break;
+				}
+			}));
+	}
+
+	FHttpRequestPtr SendXAI(const FGXModelEndpoint& Endpoint, const FString& SystemPrompt, const TArray<FGXChatTurn>& Turns, TSharedRef<FDispatchState> State)
+	{
+		const bool bVision = Endpoint.HasCapabilities(static_cast<int32>(EGXModelCapability::Vision));
+
+		FGenXAIChatSettings ChatSettings;
+		ChatSettings.Model = Endpoint.Model;
+		if (!SystemPrompt.IsEmpty())
+		{
+			ChatSettings.Messages.Add(FGenXAIMessage(TEXT("system"), {FGenAIMessageContent::FromText(SystemPrompt)}));
+		}
+		for (const FGXChatTurn& Turn : Turns)
+		{
+			ChatSettings.Messages.Add(FGenXAIMessage(Turn.Role, BuildContent(Turn, Endpoint, bVision)));
+		}
+
+		return UGenXAIChatStream::SendStreamChatRequest(ChatSettings, FOnXAIChatStreamResponse::CreateLambda(
+			[State](EXAIStreamEventType EventType, const FString& Payload, bool bSuccess)
+			{
+				if (!bSuccess || EventType == EXAIStreamEventType::Error)
+				{
+					State->Complete(FString(), Payload, false);
+					return;
+				}
+				if (EventType == EXAIStreamEventType::ContentDelta)
+				{
+					State->Delta(Payload);
+				}
+				else if (EventType == EXAIStreamEventType::Completion)
+				{
+					State->Complete(Payload, FString(), true);
+				}
+			}));
+	}
+
+	FHttpRequestPtr SendDeepSeek(const FGXModelEndpoint& Endpoint, const FString& SystemPrompt, const TArray<FGXChatTurn>& Turns, TSharedRef<FDispatchState> State)
+	{
+		FGenDeepSeekChatSettings ChatSettings;
+		ChatSettings.Model = Endpoint.Model;
+		if (!SystemPrompt.IsEmpty())
+		{
+			ChatSettings.Messages.Add(FGenChatMessage(TEXT("system"), {FGenAIMessageContent::FromText(SystemPrompt)}));
+		}
+		for (const FGXChatTurn& Turn : Turns)
+		{
+			// DeepSeek has no vision input; attachments are dropped.
+			ChatSettings.Messages.Add(FGenChatMessage(Turn.Role, {FGenAIMessageContent::FromText(Turn.Text)}));
+		}
+
+		return UGenDSeekChatStream::SendStreamChatRequest(ChatSettings, FOnDSeekChatStreamResponse::CreateLambda(
+			[State](EDeepSeekStreamEventType EventType, const FString& Payload, bool bSuccess)
+			{
+				if (!bSuccess || EventType == EDeepSeekStreamEventType::Error)
+				{
+					State->Complete(FString(), Payload, false);
+					return;
+				}
+				if (EventType == EDeepSeekStreamEventType::ContentUpdate)
+				{
+					State->Delta(Payload);
+				}
+				else if (EventType == EDeepSeekStreamEventType::Completion)
+				{
+					State->Complete(Payload, FString(), true);
+				}
+			}));
+	}
+}
+#endif
+
+FHttpRequestPtr FGXChatDispatch::Send(const FGXModelEndpoint& Endpoint, const FString& SystemPrompt, const TArray<FGXChatTurn>& Turns, FGXChatDispatchCallbacks Callbacks)
+{
+#if WITH_GENAI_MODULE
+	TSharedRef<FDispatchState> State = MakeShared<FDispatchState>();
+	State->Callbacks = MoveTemp(Callbacks);
+
+	switch (Endpoint.Provider)
+	{
+		case EGXChatProvider::OpenAI:    return SendOpenAI(Endpoint, SystemPrompt, Turns, State);
+		case EGXChatProvider::Anthropic: return SendClaude(Endpoint, SystemPrompt, Turns, State);
+		case EGXChatProvider::Google:    return SendGemini(Endpoint, SystemPrompt, Turns, State);
+		case EGXChatProvider::XAI:       return SendXAI(Endpoint, SystemPrompt, Turns, State);
+		case EGXChatProvider::DeepSeek:  return SendDeepSeek(Endpoint, SystemPrompt, Turns, State);
+	}
+	return nullptr;
+#else
+	UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. FGXChatDispatch::Send will do nothing."));
+	return nullptr;
+#endif
+}
+
+bool FGXChatDispatch::SupportsStreaming(EGXChatProvider Provider)
+{
+	return Provider != EGXChatProvider::Anthropic;
+}
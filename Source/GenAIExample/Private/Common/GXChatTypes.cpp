@@ -0,0 +1,16 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXChatTypes.h"
+
+FString GXChatProviderToString(EGXChatProvider Provider)
+{
+	switch (Provider)
+	{
+		case EGXChatProvider::OpenAI:    return TEXT("OpenAI");
+		case EGXChatProvider::Anthropic: return TEXT("Anthropic");
+		case EGXChatProvider::Google:    return TEXT("Google");
+		case EGXChatProvider::XAI:       return TEXT("XAI");
+		case EGXChatProvider::DeepSeek:  return TEXT("DeepSeek");
+	}
+	return TEXT("Unknown");
+}
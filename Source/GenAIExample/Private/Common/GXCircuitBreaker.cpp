@@ -0,0 +1,96 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXCircuitBreaker.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXCircuitBreaker, Log, All);
+
+EGXCircuitState FGXCircuitBreaker::GetState(const FGXCircuitBreakerSettings& Settings, double NowSeconds) const
+{
+	if (State == EGXCircuitState::Open && NowSeconds - OpenedAtSeconds >= Settings.OpenDurationSeconds)
+	{
+		return EGXCircuitState::HalfOpen;
+	}
+	return State;
+}
+
+bool FGXCircuitBreaker::TryAcquire(const FGXCircuitBreakerSettings& Settings, double NowSeconds)
+{
+	State = GetState(Settings, NowSeconds);
+	switch (State)
+	{
+		case EGXCircuitState::Closed:
+			return true;
+
+		case EGXCircuitState::HalfOpen:
+			// A probe whose outcome never arrived (cancelled request) must not block the endpoint forever.
+			if (ProbesInFlight < Settings.HalfOpenMaxProbes || NowSeconds - LastProbeSeconds >= Settings.OpenDurationSeconds)
+			{
+				ProbesInFlight = FMath::Min(ProbesInFlight + 1, Settings.HalfOpenMaxProbes);
+				LastProbeSeconds = NowSeconds;
+				return true;
+			}
+			return false;
+
+		case EGXCircuitState::Open:
+		default:
+			return false;
+	}
+}
+
+void FGXCircuitBreaker::RecordOutcome(const FGXCircuitBreakerSettings& Settings, bool bSuccess, bool bTimedOut, double NowSeconds)
+{
+	State = GetState(Settings, NowSeconds);
+
+	if (State == EGXCircuitState::HalfOpen)
+	{
+		ProbesInFlight = FMath::Max(0, ProbesInFlight - 1);
+		if (bSuccess)
+		{
+			Reset();
+		}
+		else
+		{
+			Trip(NowSeconds);
+		}
+		return;
+	}
+
+	if (State == EGXCircuitState::Open)
+	{
+		// A late result from a request sent before the breaker tripped; it changes nothing.
+		return;
+	}
+
+	const int32 Window = FMath::Clamp(Settings.WindowSize, 1, 64);
+	FailureBits = (FailureBits << 1) | (bSuccess ? 0ull : 1ull);
+	if (Window < 64)
+	{
+		FailureBits &= (1ull << Window) - 1;
+	}
+	WindowCount = FMath::Min(WindowCount + 1, Window);
+	ConsecutiveTimeouts = bTimedOut ? ConsecutiveTimeouts + 1 : 0;
+
+	const bool bErrorRateTrip = WindowCount >= Settings.MinimumSamples && GetWindowErrorRate() >= Settings.ErrorRateThreshold;
+	const bool bTimeoutTrip = ConsecutiveTimeouts >= Settings.ConsecutiveTimeoutThreshold;
+	if (bErrorRateTrip || bTimeoutTrip)
+	{
+		UE_LOG(LogGXCircuitBreaker, Warning, TEXT("Circuit opened (error rate %.2f over %d, %d consecutive timeouts)."), GetWindowErrorRate(), WindowCount, ConsecutiveTimeouts);
+		Trip(NowSeconds);
+	}
+}
+
+void FGXCircuitBreaker::Trip(double NowSeconds)
+{
+	State = EGXCircuitState::Open;
+	OpenedAtSeconds = NowSeconds;
+	ProbesInFlight = 0;
+}
+
+void FGXCircuitBreaker::Reset()
+{
+	State = EGXCircuitState::Closed;
+	FailureBits = 0;
+	WindowCount = 0;
+	ConsecutiveTimeouts = 0;
+	ProbesInFlight = 0;
+}
@@ -0,0 +1,502 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXConversationArchive.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "ImageUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Modules/ModuleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXConversationArchive, Log, All);
+
+namespace
+{
+	struct FHeader
+	{
+		uint32 Magic;
+		uint16 Version;
+		uint16 HeaderSize;
+		uint32 TurnCount;
+		uint32 AttachmentCount;
+		uint32 SystemPromptOffset;
+		uint32 BlobSize;
+		/** CRC32 of everything after the header. Only checked on full decode so Open() stays lazy. */
+		uint32 PayloadCrc;
+		uint32 Reserved;
+	};
+	static_assert(sizeof(FHeader) == 32, "Archive header layout changed");
+
+	struct FTurnEntry
+	{
+		uint8 Role;
+		uint8 Reserved;
+		uint16 AttachmentCount;
+		uint32 TextOffset;
+		uint32 FirstAttachment;
+		/** Only used for ERoleCode::Custom. */
+		uint32 RoleOffset;
+	};
+	static_assert(sizeof(FTurnEntry) == 16, "Archive turn entry layout changed");
+
+	constexpr int32 AttachmentEntrySize = 20;
+	constexpr uint32 InvalidOffset = MAX_uint32;
+
+	enum class ERoleCode : uint8
+	{
+		System,
+		User,
+		Assistant,
+		Model,
+		Tool,
+		Custom = 0xFF
+	};
+
+	const TCHAR* const GRoleNames[] = { TEXT("system"), TEXT("user"), TEXT("assistant"), TEXT("model"), TEXT("tool") };
+
+	ERoleCode EncodeRole(const FString& Role)
+	{
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(GRoleNames); ++Index)
+		{
+			if (Role.Equals(GRoleNames[Index], ESearchCase::IgnoreCase))
+			{
+				return static_cast<ERoleCode>(Index);
+			}
+		}
+		return ERoleCode::Custom;
+	}
+
+	/** Appends a [uint32 length][UTF-8] record and returns its offset in the blob. */
+	uint32 AppendString(TArray<uint8>& Blob, const FString& Text)
+	{
+		const FTCHARToUTF8 Utf8(*Text);
+		const uint32 Length = static_cast<uint32>(Utf8.Length());
+		const uint32 Offset = static_cast<uint32>(Blob.Num());
+		Blob.AddUninitialized(sizeof(uint32) + Length);
+		FMemory::Memcpy(Blob.GetData() + Offset, &Length, sizeof(uint32));
+		FMemory::Memcpy(Blob.GetData() + Offset + sizeof(uint32), Utf8.Get(), Length);
+		return Offset;
+	}
+
+	/** Encodes mip 0 of an uncompressed BGRA8 texture as PNG. */
+	bool EncodeTextureAsPNG(UTexture2D* Texture, TArray64<uint8>& OutPNG)
+	{
+		FTexturePlatformData* PlatformData = Texture ? Texture->GetPlatformData() : nullptr;
+		if (!PlatformData || PlatformData->Mips.Num() == 0 || PlatformData->PixelFormat != PF_B8G8R8A8)
+		{
+			return false;
+		}
+
+		FTexture2DMipMap& Mip = PlatformData->Mips[0];
+		const void* Pixels = Mip.BulkData.Lock(LOCK_READ_ONLY);
+
+		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+		if (Pixels && ImageWrapper.IsValid() && ImageWrapper->SetRaw(Pixels, Mip.BulkData.GetBulkDataSize(), Mip.SizeX, Mip.SizeY, ERGBFormat::BGRA, 8))
+		{
+			OutPNG = ImageWrapper->GetCompressed();
+		}
+
+		Mip.BulkData.Unlock();
+		return OutPNG.Num() > 0;
+	}
+
+	FString GetAttachmentPathForHash(const FSHAHash& Hash)
+	{
+		return FGXConversationArchive::GetAttachmentDirectory() / Hash.ToString() + TEXT(".png");
+	}
+
+	enum class EStoreResult : uint8
+	{
+		Stored,
+		/** The texture has no CPU copy that can be encoded. */
+		Unsupported,
+		WriteFailed
+	};
+
+	/** Writes the attachment under its content hash unless an identical file already exists. */
+	EStoreResult StoreAttachment(UTexture2D* Texture, FSHAHash& OutHash)
+	{
+		TArray64<uint8> PNG;
+		if (!EncodeTextureAsPNG(Texture, PNG))
+		{
+			return EStoreResult::Unsupported;
+		}
+
+		FSHA1::HashBuffer(PNG.GetData(), PNG.Num(), OutHash.Hash);
+		const FString Path = GetAttachmentPathForHash(OutHash);
+		if (IFileManager::Get().FileExists(*Path))
+		{
+			// Refreshes the timestamp, so CollectAttachments does not delete it under a Save in progress.
+			IFileManager::Get().SetTimeStamp(*Path, FDateTime::UtcNow());
+			return EStoreResult::Stored;
+		}
+		return FFileHelper::SaveArrayToFile(PNG, *Path) ? EStoreResult::Stored : EStoreResult::WriteFailed;
+	}
+}
+
+FString FGXConversationArchive::GetDefaultDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GenAI") / TEXT("Conversations");
+}
+
+FString FGXConversationArchive::GetAttachmentDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GenAI") / TEXT("Attachments");
+}
+
+FString FGXConversationArchive::GetSlotPath(const FString& SlotName)
+{
+	return GetDefaultDirectory() / FPaths::MakeValidFileName(SlotName) + TEXT(".gxconv");
+}
+
+bool FGXConversationArchive::Save(const FString& FilePath, const FString& SystemPrompt, const TArray<FGXChatTurn>& Turns, FString& OutError)
+{
+	TArray<uint8> Blob;
+	TArray<FTurnEntry> Entries;
+	TArray<FSHAHash> Attachments;
+	Entries.Reserve(Turns.Num());
+
+	const uint32 SystemPromptOffset = SystemPrompt.IsEmpty() ? InvalidOffset : AppendString(Blob, SystemPrompt);
+
+	for (const FGXChatTurn& Turn : Turns)
+	{
+		FTurnEntry& Entry = Entries.AddZeroed_GetRef();
+		const ERoleCode Role = EncodeRole(Turn.Role);
+		Entry.Role = static_cast<uint8>(Role);
+		Entry.RoleOffset = Role == ERoleCode::Custom ? AppendString(Blob, Turn.Role) : InvalidOffset;
+		Entry.TextOffset = AppendString(Blob, Turn.Text);
+		Entry.FirstAttachment = static_cast<uint32>(Attachments.Num());
+
+		for (UTexture2D* Image : Turn.Images)
+		{
+			FSHAHash Hash;
+			const EStoreResult Result = StoreAttachment(Image, Hash);
+			if (Result == EStoreResult::Stored)
+			{
+				Attachments.Add(Hash);
+				++Entry.AttachmentCount;
+			}
+			else if (Result == EStoreResult::Unsupported)
+			{
+				// Compressed or streamed textures have no CPU copy to encode; the text is still worth keeping.
+				UE_LOG(LogGXConversationArchive, Warning, TEXT("Skipping attachment %s: only uncompressed BGRA8 textures can be saved."), *GetNameSafe(Image));
+			}
+			else
+			{
+				// Attachments already written are left for CollectAttachments.
+				OutError = FString::Printf(TEXT("Failed to write attachment %s to %s."), *GetNameSafe(Image), *GetAttachmentPathForHash(Hash));
+				return false;
+			}
+		}
+	}
+
+	FHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.HeaderSize = sizeof(FHeader);
+	Header.TurnCount = static_cast<uint32>(Entries.Num());
+	Header.AttachmentCount = static_cast<uint32>(Attachments.Num());
+	Header.SystemPromptOffset = SystemPromptOffset;
+	Header.BlobSize = static_cast<uint32>(Blob.Num());
+
+	TArray<uint8> FileBytes;
+	FileBytes.Reserve(sizeof(FHeader) + Entries.Num() * sizeof(FTurnEntry) + Attachments.Num() * AttachmentEntrySize + Blob.Num());
+	FileBytes.AddZeroed(sizeof(FHeader));
+	FileBytes.Append(reinterpret_cast<const uint8*>(Entries.GetData()), Entries.Num() * sizeof(FTurnEntry));
+	for (const FSHAHash& Hash : Attachments)
+	{
+		FileBytes.Append(Hash.Hash, AttachmentEntrySize);
+	}
+	FileBytes.Append(Blob);
+
+	Header.PayloadCrc = FCrc::MemCrc32(FileBytes.GetData() + sizeof(FHeader), FileBytes.Num() - static_cast<int32>(sizeof(FHeader)));
+	FMemory::Memcpy(FileBytes.GetData(), &Header, sizeof(FHeader));
+
+	// Write next to the target and move into place so a crash never leaves a truncated archive behind.
+	const FString TempPath = FilePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(FileBytes, *TempPath) || !IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+	{
+		IFileManager::Get().Delete(*TempPath);
+		OutError = FString::Printf(TEXT("Failed to write conversation archive %s."), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+int32 FGXConversationArchive::CollectAttachments(FTimespan MinAge)
+{
+	TSet<FString> Referenced;
+	int32 UnreadableArchives = 0;
+	IFileManager::Get().IterateDirectoryRecursively(*GetDefaultDirectory(), [&Referenced, &UnreadableArchives](const TCHAR* Path, bool bIsDirectory)
+	{
+		if (!bIsDirectory && FPaths::GetExtension(Path) == TEXT("gxconv"))
+		{
+			FGXConversationArchiveReader Reader;
+			FString Error;
+			if (!Reader.Open(Path, Error))
+			{
+				++UnreadableArchives;
+				return true;
+			}
+			for (int32 Index = 0; Index < Reader.GetAttachmentCount(); ++Index)
+			{
+				Referenced.Add(FPaths::GetCleanFilename(Reader.GetAttachmentPath(Index)));
+			}
+		}
+		return true;
+	});
+
+	// An archive that cannot be read may still refer to anything; deleting nothing is the safe answer.
+	if (UnreadableArchives > 0)
+	{
+		UE_LOG(LogGXConversationArchive, Warning, TEXT("Not collecting attachments: %d conversation archive(s) could not be read."), UnreadableArchives);
+		return 0;
+	}
+
+	const FDateTime Cutoff = FDateTime::UtcNow() - MinAge;
+	TArray<FString> Orphans;
+	IFileManager::Get().IterateDirectoryStat(*GetAttachmentDirectory(), [&Referenced, &Cutoff, &Orphans](const TCHAR* Path, const FFileStatData& Stat)
+	{
+		if (!Stat.bIsDirectory && FPaths::GetExtension(Path) == TEXT("png") && Stat.ModificationTime < Cutoff
+			&& !Referenced.Contains(FPaths::GetCleanFilename(Path)))
+		{
+			Orphans.Add(Path);
+		}
+		return true;
+	});
+
+	int32 Deleted = 0;
+	for (const FString& Path : Orphans)
+	{
+		Deleted += IFileManager::Get().Delete(*Path, false, false, true) ? 1 : 0;
+	}
+	UE_LOG(LogGXConversationArchive, Log, TEXT("Deleted %d unreferenced attachment(s); %d still in use."), Deleted, Referenced.Num());
+	return Deleted;
+}
+
+FGXConversationArchiveReader::FGXConversationArchiveReader() = default;
+
+FGXConversationArchiveReader::~FGXConversationArchiveReader()
+{
+	Close();
+}
+
+void FGXConversationArchiveReader::Close()
+{
+	// The region must be released before the handle it was mapped from.
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	FallbackBuffer.Empty();
+	Data = nullptr;
+	Size = 0;
+	TurnCount = 0;
+	AttachmentCount = 0;
+}
+
+bool FGXConversationArchiveReader::Open(const FString& FilePath, FString& OutError)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	MappedHandle.Reset(PlatformFile.OpenMapped(*FilePath));
+	if (MappedHandle.IsValid())
+	{
+		MappedRegion.Reset(MappedHandle->MapRegion());
+	}
+
+	if (MappedRegion.IsValid())
+	{
+		Data = MappedRegion->GetMappedPtr();
+		Size = MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		// Not every platform file implementation supports mapping; fall back to a plain read.
+		MappedHandle.Reset();
+		if (!FFileHelper::LoadFileToArray(FallbackBuffer, *FilePath, FILEREAD_Silent))
+		{
+			OutError = FString::Printf(TEXT("Conversation archive %s could not be opened."), *FilePath);
+			return false;
+		}
+		Data = FallbackBuffer.GetData();
+		Size = FallbackBuffer.Num();
+	}
+
+	FHeader Header;
+	if (Size < static_cast<int64>(sizeof(FHeader)))
+	{
+		OutError = TEXT("Conversation archive is truncated.");
+		Close();
+		return false;
+	}
+	FMemory::Memcpy(&Header, Data, sizeof(FHeader));
+
+	if (Header.Magic != FGXConversationArchive::Magic || Header.Version != FGXConversationArchive::Version || Header.HeaderSize < sizeof(FHeader))
+	{
+		OutError = FString::Printf(TEXT("%s is not a version %d conversation archive."), *FilePath, FGXConversationArchive::Version);
+		Close();
+		return false;
+	}
+
+	TurnTableOffset = Header.HeaderSize;
+	AttachmentTableOffset = TurnTableOffset + static_cast<int64>(Header.TurnCount) * sizeof(FTurnEntry);
+	BlobOffset = AttachmentTableOffset + static_cast<int64>(Header.AttachmentCount) * AttachmentEntrySize;
+	BlobSize = Header.BlobSize;
+	if (BlobOffset + BlobSize > Size || Header.TurnCount > MAX_int32 || Header.AttachmentCount > MAX_int32)
+	{
+		OutError = TEXT("Conversation archive tables exceed the file size.");
+		Close();
+		return false;
+	}
+
+	TurnCount = static_cast<int32>(Header.TurnCount);
+	AttachmentCount = static_cast<int32>(Header.AttachmentCount);
+	SystemPromptOffset = Header.SystemPromptOffset;
+	PayloadCrc = Header.PayloadCrc;
+	return true;
+}
+
+bool FGXConversationArchiveReader::ReadString(uint32 BlobRelativeOffset, FString& OutString) const
+{
+	if (static_cast<int64>(BlobRelativeOffset) + static_cast<int64>(sizeof(uint32)) > BlobSize)
+	{
+		return false;
+	}
+
+	uint32 Length = 0;
+	FMemory::Memcpy(&Length, Data + BlobOffset + BlobRelativeOffset, sizeof(uint32));
+	if (static_cast<int64>(BlobRelativeOffset) + sizeof(uint32) + Length > BlobSize)
+	{
+		return false;
+	}
+
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + BlobOffset + BlobRelativeOffset + sizeof(uint32)), Length);
+	OutString = FString(Converted.Length(), Converted.Get());
+	return true;
+}
+
+FString FGXConversationArchiveReader::GetSystemPrompt() const
+{
+	FString Result;
+	if (IsOpen() && SystemPromptOffset != InvalidOffset)
+	{
+		ReadString(SystemPromptOffset, Result);
+	}
+	return Result;
+}
+
+FString FGXConversationArchiveReader::GetTurnRole(int32 TurnIndex) const
+{
+	if (!IsOpen() || TurnIndex < 0 || TurnIndex >= TurnCount) return FString();
+
+	FTurnEntry Entry;
+	FMemory::Memcpy(&Entry, Data + TurnTableOffset + TurnIndex * sizeof(FTurnEntry), sizeof(FTurnEntry));
+	if (Entry.Role < UE_ARRAY_COUNT(GRoleNames))
+	{
+		return GRoleNames[Entry.Role];
+	}
+
+	FString Role;
+	ReadString(Entry.RoleOffset, Role);
+	return Role;
+}
+
+FString FGXConversationArchiveReader::GetTurnText(int32 TurnIndex) const
+{
+	if (!IsOpen() || TurnIndex < 0 || TurnIndex >= TurnCount) return FString();
+
+	FTurnEntry Entry;
+	FMemory::Memcpy(&Entry, Data + TurnTableOffset + TurnIndex * sizeof(FTurnEntry), sizeof(FTurnEntry));
+	FString Text;
+	ReadString(Entry.TextOffset, Text);
+	return Text;
+}
+
+FString FGXConversationArchiveReader::GetAttachmentPath(int32 AttachmentIndex) const
+{
+	if (!IsOpen() || AttachmentIndex < 0 || AttachmentIndex >= AttachmentCount) return FString();
+
+	FSHAHash Hash;
+	FMemory::Memcpy(Hash.Hash, Data + AttachmentTableOffset + static_cast<int64>(AttachmentIndex) * AttachmentEntrySize, AttachmentEntrySize);
+	return GetAttachmentPathForHash(Hash);
+}
+
+bool FGXConversationArchiveReader::DecodeTurns(TArray<FGXChatTurn>& OutTurns, bool bLoadAttachments, FString& OutError) const
+{
+	if (!IsOpen())
+	{
+		OutError = TEXT("Conversation archive is not open.");
+		return false;
+	}
+
+	const int64 PayloadSize = Size - TurnTableOffset;
+	if (PayloadSize > MAX_int32 || FCrc::MemCrc32(Data + TurnTableOffset, static_cast<int32>(PayloadSize)) != PayloadCrc)
+	{
+		OutError = TEXT("Conversation archive is corrupt (checksum mismatch).");
+		return false;
+	}
+
+	TArray<FGXChatTurn> Turns;
+	Turns.Reserve(TurnCount);
+	for (int32 TurnIndex = 0; TurnIndex < TurnCount; ++TurnIndex)
+	{
+		FTurnEntry Entry;
+		FMemory::Memcpy(&Entry, Data + TurnTableOffset + TurnIndex * sizeof(FTurnEntry), sizeof(FTurnEntry));
+
+		FGXChatTurn& Turn = Turns.AddDefaulted_GetRef();
+		Turn.Role = GetTurnRole(TurnIndex);
+		if (!ReadString(Entry.TextOffset, Turn.Text) || Turn.Role.IsEmpty())
+		{
+			OutError = FString::Printf(TEXT("Conversation archive turn %d is invalid."), TurnIndex);
+			return false;
+		}
+
+		if (!bLoadAttachments) continue;
+
+		const int64 LastAttachment = static_cast<int64>(Entry.FirstAttachment) + Entry.AttachmentCount;
+		if (LastAttachment > AttachmentCount)
+		{
+			OutError = FString::Printf(TEXT("Conversation archive turn %d references missing attachments."), TurnIndex);
+			return false;
+		}
+
+		for (int64 AttachmentIndex = Entry.FirstAttachment; AttachmentIndex < LastAttachment; ++AttachmentIndex)
+		{
+			const FString Path = GetAttachmentPath(static_cast<int32>(AttachmentIndex));
+			TArray<uint8> PNG;
+			UTexture2D* Image = FFileHelper::LoadFileToArray(PNG, *Path, FILEREAD_Silent) ? FImageUtils::ImportBufferAsTexture2D(PNG) : nullptr;
+			if (Image)
+			{
+				Turn.Images.Add(Image);
+			}
+			else
+			{
+				UE_LOG(LogGXConversationArchive, Warning, TEXT("Attachment %s is missing; resuming without it."), *Path);
+			}
+		}
+	}
+
+	OutTurns = MoveTemp(Turns);
+	return true;
+}
+
+namespace
+{
+	void CollectAttachmentsCommand(const TArray<FString>& Args)
+	{
+		const double MinAgeHours = Args.Num() > 0 ? FCString::Atod(*Args[0]) : 1.0;
+		FGXConversationArchive::CollectAttachments(FTimespan::FromHours(FMath::Max(0.0, MinAgeHours)));
+	}
+
+	FAutoConsoleCommand GCollectAttachmentsCommand(
+		TEXT("GenAI.Conversations.CollectAttachments"),
+		TEXT("Deletes saved chat attachments that no conversation archive refers to. Argument: minimum age in hours (default 1)."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&CollectAttachmentsCommand));
+}
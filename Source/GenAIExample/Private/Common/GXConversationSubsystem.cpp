@@ -0,0 +1,630 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXConversationSubsystem.h"
+#include "Common/GXChatDispatch.h"
+#include "Common/GXConversationArchive.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXConversations, Log, All);
+
+namespace
+{
+	/** [uint8 bAssistant][uint32 ByteLength] precedes every UTF-8 record. */
+	constexpr int32 TurnRecordHeaderSize = 1 + sizeof(uint32);
+
+	/** Archiving writes files; spread it over scans so a crowd going idle together does not hitch a frame. */
+	constexpr int32 MaxArchivesPerScan = 16;
+	constexpr float ArchiveScanIntervalSeconds = 5.f;
+
+	uint32 ReadRecordLength(const uint8* Record)
+	{
+		uint32 Length = 0;
+		FMemory::Memcpy(&Length, Record + 1, sizeof(uint32));
+		return Length;
+	}
+
+	FString ReadRecordText(const uint8* Record)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Record + TurnRecordHeaderSize), ReadRecordLength(Record));
+		return FString(Converted.Length(), Converted.Get());
+	}
+}
+
+void UGXConversationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	StartTimeSeconds = FPlatformTime::Seconds();
+}
+
+void UGXConversationSubsystem::Deinitialize()
+{
+	for (TUniquePtr<FRequestSlot>& Slot : Slots)
+	{
+		CancelSlot(*Slot);
+	}
+
+	// Archives are swap space for this world only.
+	for (int32 Index = 0; Index < Flags.Num(); ++Index)
+	{
+		if (Flags[Index] & Session_Archived)
+		{
+			IFileManager::Get().Delete(*GetArchivePath(Index), false, false, true);
+		}
+	}
+	Super::Deinitialize();
+}
+
+bool UGXConversationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UGXConversationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGXConversationSubsystem, STATGROUP_Tickables);
+}
+
+UGXConversationSubsystem* UGXConversationSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGXConversationSubsystem>() : nullptr;
+}
+
+void UGXConversationSubsystem::Tick(float DeltaTime)
+{
+	if (PendingCachedReplies.Num() > 0)
+	{
+		TArray<FCachedReply> Replies = MoveTemp(PendingCachedReplies);
+		for (const FCachedReply& Reply : Replies)
+		{
+			if (IsValidSession(Reply.Handle))
+			{
+				OnConversationReply.Broadcast(Reply.Handle, Reply.Response, true);
+			}
+		}
+	}
+
+	ArchiveScanAccumulator += DeltaTime;
+	if (ArchiveAfterIdleSeconds <= 0.f || ArchiveScanAccumulator < ArchiveScanIntervalSeconds)
+	{
+		return;
+	}
+	ArchiveScanAccumulator = 0.f;
+
+	// A linear scan over two small arrays; this is what the structure-of-arrays layout is for.
+	const float IdleBefore = GetNowSeconds() - ArchiveAfterIdleSeconds;
+	int32 Archived = 0;
+	for (int32 Index = 0; Index < Flags.Num() && Archived < MaxArchivesPerScan; ++Index)
+	{
+		if (Flags[Index] == Session_Live && LastActiveSeconds[Index] < IdleBefore && TurnCounts[Index] > 0)
+		{
+			Archived += ArchiveSessionIndex(Index) ? 1 : 0;
+		}
+	}
+}
+
+FGXConversationHandle UGXConversationSubsystem::CreateSession(const FString& SystemPrompt, const FGXRoutingPolicy& Policy)
+{
+	int32 Index;
+	if (FreeIndices.Num() > 0)
+	{
+		Index = FreeIndices.Pop(false);
+	}
+	else
+	{
+		Index = Generations.Add(0);
+		Flags.Add(0);
+		TurnCounts.Add(0);
+		PromptIds.Add(INDEX_NONE);
+		PolicyIds.Add(INDEX_NONE);
+		LastActiveSeconds.Add(0.f);
+		Histories.AddDefaulted();
+	}
+
+	Flags[Index] = Session_Live;
+	TurnCounts[Index] = 0;
+	PromptIds[Index] = InternPrompt(SystemPrompt);
+	PolicyIds[Index] = InternPolicy(Policy);
+	LastActiveSeconds[Index] = GetNowSeconds();
+	++Stats.LiveSessions;
+	return MakeHandle(Index);
+}
+
+void UGXConversationSubsystem::DestroySession(FGXConversationHandle Handle)
+{
+	int32 Index;
+	if (!ResolveHandle(Handle, Index)) return;
+
+	if (Flags[Index] & Session_InFlight)
+	{
+		for (TUniquePtr<FRequestSlot>& Slot : Slots)
+		{
+			if (Slot->Session == Index)
+			{
+				CancelSlot(*Slot);
+			}
+		}
+	}
+	if (Flags[Index] & Session_Queued)
+	{
+		// The queue entry stays behind and is skipped by PumpQueue because the generation no longer matches.
+		--Stats.QueuedRequests;
+	}
+	if (Flags[Index] & Session_Archived)
+	{
+		IFileManager::Get().Delete(*GetArchivePath(Index), false, false, true);
+		--Stats.ArchivedSessions;
+	}
+
+	FreeHistory(Index);
+	Flags[Index] = 0;
+	++Generations[Index];
+	FreeIndices.Add(Index);
+	--Stats.LiveSessions;
+}
+
+bool UGXConversationSubsystem::IsValidSession(FGXConversationHandle Handle) const
+{
+	int32 Index;
+	return ResolveHandle(Handle, Index);
+}
+
+bool UGXConversationSubsystem::IsBusy(FGXConversationHandle Handle) const
+{
+	int32 Index;
+	return ResolveHandle(Handle, Index) && (Flags[Index] & (Session_Queued | Session_InFlight)) != 0;
+}
+
+bool UGXConversationSubsystem::SendMessage(FGXConversationHandle Handle, const FString& UserMessage)
+{
+	int32 Index;
+	if (!ResolveHandle(Handle, Index) || (Flags[Index] & (Session_Queued | Session_InFlight)) || UserMessage.IsEmpty())
+	{
+		return false;
+	}
+	if (!EnsureResident(Index))
+	{
+		return false;
+	}
+
+	AppendTurn(Index, false, UserMessage);
+	TrimHistory(Index);
+	LastActiveSeconds[Index] = GetNowSeconds();
+
+	// An opening line has no context beyond the shared persona, so identical ones get identical replies.
+	if (TurnCounts[Index] == 1 && ResponseCacheCapacity > 0)
+	{
+		if (const FString* Cached = ResponseCache.Find(MakeCacheKey(Index, UserMessage)))
+		{
+			AppendTurn(Index, true, *Cached);
+			++Stats.CacheHits;
+			PendingCachedReplies.Add({ Handle, *Cached });
+			return true;
+		}
+	}
+
+	const int32 QueuedNow = Queue.Num() - QueueHead;
+	if (QueuedNow >= MaxQueuedRequests && Stats.InFlightRequests >= MaxConcurrentRequests)
+	{
+		RemoveLastTurn(Index);
+		return false;
+	}
+
+	Flags[Index] |= Session_Queued;
+	Queue.Add({ Index, Generations[Index] });
+	++Stats.QueuedRequests;
+	PumpQueue();
+	return true;
+}
+
+TArray<FGXChatTurn> UGXConversationSubsystem::GetHistory(FGXConversationHandle Handle)
+{
+	TArray<FGXChatTurn> Turns;
+	int32 Index;
+	if (ResolveHandle(Handle, Index) && EnsureResident(Index))
+	{
+		DecodeHistory(Index, Turns);
+	}
+	return Turns;
+}
+
+bool UGXConversationSubsystem::ArchiveSession(FGXConversationHandle Handle)
+{
+	int32 Index;
+	return ResolveHandle(Handle, Index) && ArchiveSessionIndex(Index);
+}
+
+bool UGXConversationSubsystem::ResolveHandle(FGXConversationHandle Handle, int32& OutIndex) const
+{
+	if (!Flags.IsValidIndex(Handle.Index) || !(Flags[Handle.Index] & Session_Live) || Generations[Handle.Index] != static_cast<uint32>(Handle.Generation))
+	{
+		return false;
+	}
+	OutIndex = Handle.Index;
+	return true;
+}
+
+FGXConversationHandle UGXConversationSubsystem::MakeHandle(int32 Index) const
+{
+	FGXConversationHandle Handle;
+	Handle.Index = Index;
+	Handle.Generation = static_cast<int32>(Generations[Index]);
+	return Handle;
+}
+
+int32 UGXConversationSubsystem::InternPrompt(const FString& SystemPrompt)
+{
+	if (const int32* Existing = PromptLookup.Find(SystemPrompt))
+	{
+		return *Existing;
+	}
+	const int32 Id = SharedPrompts.Add(SystemPrompt);
+	PromptLookup.Add(SystemPrompt, Id);
+	return Id;
+}
+
+int32 UGXConversationSubsystem::InternPolicy(const FGXRoutingPolicy& Policy)
+{
+	const int32 Existing = SharedPolicies.IndexOfByPredicate([&Policy](const FGXRoutingPolicy& Other)
+	{
+		return Other.LatencyTargetMs == Policy.LatencyTargetMs && Other.CostCeilingPer1kTokens == Policy.CostCeilingPer1kTokens
+			&& Other.RequiredCapabilities == Policy.RequiredCapabilities && Other.ShortPromptMaxChars == Policy.ShortPromptMaxChars;
+	});
+	return Existing != INDEX_NONE ? Existing : SharedPolicies.Add(Policy);
+}
+
+void UGXConversationSubsystem::AppendTurn(int32 Index, bool bAssistant, const FString& Text)
+{
+	const FTCHARToUTF8 Utf8(*Text);
+	const uint32 Length = static_cast<uint32>(Utf8.Length());
+
+	TArray<uint8>& History = Histories[Index];
+	const int32 Offset = History.Num();
+	History.AddUninitialized(TurnRecordHeaderSize + Length);
+	History[Offset] = bAssistant ? 1 : 0;
+	FMemory::Memcpy(History.GetData() + Offset + 1, &Length, sizeof(uint32));
+	FMemory::Memcpy(History.GetData() + Offset + TurnRecordHeaderSize, Utf8.Get(), Length);
+
+	TurnCounts[Index] = static_cast<uint16>(FMath::Min<int32>(TurnCounts[Index] + 1, MAX_uint16));
+	Stats.HistoryBytes += TurnRecordHeaderSize + Length;
+}
+
+void UGXConversationSubsystem::RemoveLastTurn(int32 Index)
+{
+	TArray<uint8>& History = Histories[Index];
+	int32 Offset = 0;
+	int32 LastOffset = INDEX_NONE;
+	while (Offset < History.Num())
+	{
+		LastOffset = Offset;
+		Offset += TurnRecordHeaderSize + ReadRecordLength(History.GetData() + Offset);
+	}
+	if (LastOffset == INDEX_NONE) return;
+
+	Stats.HistoryBytes -= History.Num() - LastOffset;
+	History.SetNum(LastOffset, false);
+	--TurnCounts[Index];
+}
+
+void UGXConversationSubsystem::TrimHistory(int32 Index)
+{
+	TArray<uint8>& History = Histories[Index];
+	int32 Cut = 0;
+	int32 Turns = TurnCounts[Index];
+
+	// Drop the oldest turns, and keep going past a leading assistant turn: several providers
+	// reject a conversation that does not start with the user.
+	while (Cut < History.Num() && (Turns > MaxHistoryTurns || History[Cut] != 0))
+	{
+		Cut += TurnRecordHeaderSize + ReadRecordLength(History.GetData() + Cut);
+		--Turns;
+	}
+	if (Cut == 0) return;
+
+	History.RemoveAt(0, Cut, false);
+	Stats.HistoryBytes -= Cut;
+	TurnCounts[Index] = static_cast<uint16>(Turns);
+}
+
+void UGXConversationSubsystem::DecodeHistory(int32 Index, TArray<FGXChatTurn>& OutTurns) const
+{
+	const TArray<uint8>& History = Histories[Index];
+	OutTurns.Reset(TurnCounts[Index]);
+	for (int32 Offset = 0; Offset < History.Num(); Offset += TurnRecordHeaderSize + ReadRecordLength(History.GetData() + Offset))
+	{
+		const uint8* Record = History.GetData() + Offset;
+		OutTurns.Emplace(Record[0] ? TEXT("assistant") : TEXT("user"), ReadRecordText(Record));
+	}
+}
+
+FString UGXConversationSubsystem::GetLastTurnText(int32 Index) const
+{
+	const TArray<uint8>& History = Histories[Index];
+	int32 LastOffset = INDEX_NONE;
+	for (int32 Offset = 0; Offset < History.Num(); Offset += TurnRecordHeaderSize + ReadRecordLength(History.GetData() + Offset))
+	{
+		LastOffset = Offset;
+	}
+	return LastOffset != INDEX_NONE ? ReadRecordText(History.GetData() + LastOffset) : FString();
+}
+
+void UGXConversationSubsystem::FreeHistory(int32 Index)
+{
+	Stats.HistoryBytes -= Histories[Index].Num();
+	Histories[Index].Empty();
+	TurnCounts[Index] = 0;
+}
+
+FString UGXConversationSubsystem::GetArchivePath(int32 Index) const
+{
+	const UWorld* World = GetWorld();
+	const FString WorldName = World ? World->GetName() : TEXT("World");
+	return FGXConversationArchive::GetDefaultDirectory() / TEXT("Sessions") / FString::Printf(TEXT("%s_%d_%u.gxconv"), *WorldName, Index, Generations[Index]);
+}
+
+bool UGXConversationSubsystem::ArchiveSessionIndex(int32 Index)
+{
+	if (Flags[Index] != Session_Live) return false;
+
+	TArray<FGXChatTurn> Turns;
+	DecodeHistory(Index, Turns);
+
+	// The system prompt is interned and stays in memory; the archive holds the history only.
+	FString Error;
+	if (!FGXConversationArchive::Save(GetArchivePath(Index), FString(), Turns, Error))
+	{
+		UE_LOG(LogGXConversations, Warning, TEXT("Failed to archive session %d: %s"), Index, *Error);
+		return false;
+	}
+
+	FreeHistory(Index);
+	Histories[Index].Shrink();
+	Flags[Index] |= Session_Archived;
+	++Stats.ArchivedSessions;
+	return true;
+}
+
+bool UGXConversationSubsystem::EnsureResident(int32 Index)
+{
+	if (!(Flags[Index] & Session_Archived)) return true;
+
+	const FString Path = GetArchivePath(Index);
+	FGXConversationArchiveReader Reader;
+	TArray<FGXChatTurn> Turns;
+	FString Error;
+	if (!Reader.Open(Path, Error) || !Reader.DecodeTurns(Turns, false, Error))
+	{
+		UE_LOG(LogGXConversations, Error, TEXT("Failed to restore session %d: %s"), Index, *Error);
+		return false;
+	}
+	Reader.Close();
+
+	for (const FGXChatTurn& Turn : Turns)
+	{
+		AppendTurn(Index, Turn.Role != TEXT("user"), Turn.Text);
+	}
+	IFileManager::Get().Delete(*Path, false, false, true);
+	Flags[Index] &= ~Session_Archived;
+	--Stats.ArchivedSessions;
+	return true;
+}
+
+UGXConversationSubsystem::FResponseCacheKey UGXConversationSubsystem::MakeCacheKey(int32 Index, const FString& UserMessage) const
+{
+	FResponseCacheKey Key;
+	Key.PromptId = PromptIds[Index];
+	Key.PolicyId = PolicyIds[Index];
+	Key.UserMessage = UserMessage;
+	return Key;
+}
+
+void UGXConversationSubsystem::PumpQueue()
+{
+	// Completions and replies can re-enter through delegates; the outermost call drains the queue.
+	if (bPumpingQueue) return;
+	TGuardValue<bool> PumpGuard(bPumpingQueue, true);
+
+	while (QueueHead < Queue.Num())
+	{
+		int32 FreeSlot = Slots.IndexOfByPredicate([](const TUniquePtr<FRequestSlot>& Slot) { return Slot->Session == INDEX_NONE; });
+		if (FreeSlot == INDEX_NONE || FreeSlot >= MaxConcurrentRequests)
+		{
+			if (Slots.Num() >= MaxConcurrentRequests) break;
+			FreeSlot = Slots.Add(MakeUnique<FRequestSlot>());
+		}
+
+		const FQueuedMessage Message = Queue[QueueHead++];
+		const int32 Index = Message.Session;
+		if (!Flags.IsValidIndex(Index) || Generations[Index] != Message.Generation || !(Flags[Index] & Session_Queued))
+		{
+			// Destroyed while queued; already uncounted by DestroySession.
+			continue;
+		}
+
+		--Stats.QueuedRequests;
+		Flags[Index] &= ~Session_Queued;
+		Flags[Index] |= Session_InFlight;
+		++Stats.InFlightRequests;
+
+		if (!EnsureResident(Index) || !StartRequest(*Slots[FreeSlot], FreeSlot, Index))
+		{
+			Flags[Index] &= ~Session_InFlight;
+			--Stats.InFlightRequests;
+			RemoveLastTurn(Index);
+			++Stats.FailedRequests;
+			OnConversationReply.Broadcast(MakeHandle(Index), TEXT("No endpoint is available."), false);
+		}
+	}
+
+	if (QueueHead > 0 && QueueHead * 2 >= Queue.Num())
+	{
+		Queue.RemoveAt(0, QueueHead, false);
+		QueueHead = 0;
+	}
+}
+
+bool UGXConversationSubsystem::StartRequest(FRequestSlot& Slot, int32 SlotIndex, int32 Index)
+{
+	UGXModelRouter* Router = UGXModelRouter::Get(this);
+	if (!Router) return false;
+
+	// Take the best endpoint whose breaker admits a request.
+	const FGXRoutingPolicy& Policy = SharedPolicies[PolicyIds[Index]];
+	const FString Prompt = GetLastTurnText(Index);
+	TSet<FString> Excluded;
+	FGXModelEndpoint Endpoint;
+	bool bAcquired = false;
+	while (Router->SelectEndpointExcluding(Policy, Prompt, Excluded, Endpoint))
+	{
+		if (Router->TryAcquireEndpoint(Endpoint))
+		{
+			bAcquired = true;
+			break;
+		}
+		Excluded.Add(Endpoint.GetKey());
+	}
+	if (!bAcquired) return false;
+
+	TArray<FGXChatTurn> Turns;
+	DecodeHistory(Index, Turns);
+
+	Slot.Session = Index;
+	Slot.SessionGeneration = Generations[Index];
+	Slot.Endpoint = Endpoint;
+	Slot.StartSeconds = FPlatformTime::Seconds();
+	Slot.bFirstTokenReported = false;
+	Slot.bCacheable = TurnCounts[Index] == 1 && ResponseCacheCapacity > 0;
+	Slot.CacheKey = Slot.bCacheable ? MakeCacheKey(Index, Prompt) : FResponseCacheKey();
+
+	const uint32 RequestGeneration = Slot.Watchdog.Begin();
+	TWeakObjectPtr<UGXConversationSubsystem> WeakThis(this);
+	FGXChatDispatchCallbacks Callbacks;
+	Callbacks.OnDelta = [WeakThis, SlotIndex, RequestGeneration](const FString& Delta)
+	{
+		if (!WeakThis.IsValid()) return;
+		FRequestSlot& ActiveSlot = *WeakThis->Slots[SlotIndex];
+		if (!ActiveSlot.Watchdog.IsCurrent(RequestGeneration)) return;
+
+		ActiveSlot.Watchdog.NotifyActivity();
+		if (!ActiveSlot.bFirstTokenReported)
+		{
+			ActiveSlot.bFirstTokenReported = true;
+			if (UGXModelRouter* ActiveRouter = UGXModelRouter::Get(WeakThis.Get()))
+			{
+				ActiveRouter->ReportFirstToken(ActiveSlot.Endpoint, static_cast<float>((FPlatformTime::Seconds() - ActiveSlot.StartSeconds) * 1000.0));
+			}
+		}
+	};
+	Callbacks.OnComplete = [WeakThis, SlotIndex, RequestGeneration](const FString& Response, const FString& Error, bool bSuccess)
+	{
+		if (!WeakThis.IsValid() || !WeakThis->Slots[SlotIndex]->Watchdog.IsCurrent(RequestGeneration)) return;
+		WeakThis->CompleteRequest(SlotIndex, Response, Error, bSuccess, false);
+	};
+
+	const FHttpRequestPtr Request = FGXChatDispatch::Send(Endpoint, SharedPrompts[PromptIds[Index]], Turns, MoveTemp(Callbacks));
+	if (Slot.Session == INDEX_NONE || !Slot.Watchdog.IsCurrent(RequestGeneration))
+	{
+		// Completed synchronously inside Send, which already accounted for it and may have reused the slot.
+		return true;
+	}
+	if (!Request.IsValid())
+	{
+		Router->ReportOutcome(Endpoint, false);
+		Slot.Watchdog.Stop();
+		Slot.Session = INDEX_NONE;
+		return false;
+	}
+
+	Slot.Request = Request;
+	if (!FGXRequestWatchdog::IsInFlight(Request))
+	{
+		// Finished inside Send but its completion is still to be delivered.
+		return true;
+	}
+	Slot.Watchdog.Watch(Request, RequestTimeouts, FGXChatDispatch::SupportsStreaming(Endpoint.Provider), [this, SlotIndex](EGXTimeoutKind Kind)
+	{
+		CompleteRequest(SlotIndex, FString(), FGXRequestWatchdog::DescribeTimeout(Kind), false, true);
+	});
+	return true;
+}
+
+void UGXConversationSubsystem::CompleteRequest(int32 SlotIndex, const FString& Response, const FString& Error, bool bSuccess, bool bTimedOut)
+{
+	FRequestSlot& Slot = *Slots[SlotIndex];
+	const int32 Index = Slot.Session;
+	if (Index == INDEX_NONE) return;
+
+	Slot.Watchdog.Stop();
+	Slot.Request.Reset();
+	Slot.Session = INDEX_NONE;
+	--Stats.InFlightRequests;
+
+	const float LatencyMs = static_cast<float>((FPlatformTime::Seconds() - Slot.StartSeconds) * 1000.0);
+	Stats.AverageLatencyMs = Stats.AverageLatencyMs > 0.f ? FMath::Lerp(Stats.AverageLatencyMs, LatencyMs, 0.1f) : LatencyMs;
+	if (UGXModelRouter* Router = UGXModelRouter::Get(this))
+	{
+		if (bSuccess && !Slot.bFirstTokenReported)
+		{
+			Router->ReportFirstToken(Slot.Endpoint, LatencyMs);
+		}
+		Router->ReportOutcome(Slot.Endpoint, bSuccess, bTimedOut);
+	}
+
+	if (bSuccess)
+	{
+		++Stats.CompletedRequests;
+	}
+	else
+	{
+		++Stats.FailedRequests;
+	}
+
+	if (bSuccess && Slot.bCacheable && !ResponseCache.Contains(Slot.CacheKey))
+	{
+		if (CacheOrder.Num() >= ResponseCacheCapacity && CacheOrder.Num() > 0)
+		{
+			ResponseCache.Remove(CacheOrder[0]);
+			CacheOrder.RemoveAt(0, 1, false);
+		}
+		ResponseCache.Add(Slot.CacheKey, Response);
+		CacheOrder.Add(Slot.CacheKey);
+	}
+
+	// The session may have been destroyed (and its slot reused) while the request was in flight.
+	if (Flags.IsValidIndex(Index) && Generations[Index] == Slot.SessionGeneration && (Flags[Index] & Session_InFlight))
+	{
+		Flags[Index] &= ~Session_InFlight;
+		if (bSuccess)
+		{
+			AppendTurn(Index, true, Response);
+		}
+		else
+		{
+			// Keep the history balanced so the message can simply be sent again.
+			RemoveLastTurn(Index);
+		}
+		LastActiveSeconds[Index] = GetNowSeconds();
+		OnConversationReply.Broadcast(MakeHandle(Index), bSuccess ? Response : Error, bSuccess);
+	}
+
+	PumpQueue();
+}
+
+void UGXConversationSubsystem::CancelSlot(FRequestSlot& Slot)
+{
+	if (Slot.Session == INDEX_NONE) return;
+
+	// Begin() invalidates the callbacks of the cancelled request before it is cancelled. No outcome is
+	// reported: a cancel says nothing about the endpoint, and the breaker expires a held probe on its own.
+	Slot.Watchdog.Begin();
+	if (Slot.Request.IsValid() && Slot.Request->GetStatus() == EHttpRequestStatus::Processing)
+	{
+		Slot.Request->CancelRequest();
+	}
+	Slot.Request.Reset();
+	Slot.Session = INDEX_NONE;
+	--Stats.InFlightRequests;
+}
@@ -0,0 +1,286 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXImageCache.h"
+#include "Async/Async.h"
+#include "Common/GXBlockCompressor.h"
+#include "Common/GXTextureDecoder.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXImageCache, Log, All);
+
+namespace
+{
+	struct FHeader
+	{
+		uint32 Magic;
+		uint16 Version;
+		uint16 MipCount;
+		uint32 Width;
+		uint32 Height;
+		/** EPixelFormat of the payloads. */
+		uint32 PixelFormat;
+		/** CRC32 of this header, with Checksum zeroed, followed by the mip table. */
+		uint32 Checksum;
+		uint32 Reserved[2];
+	};
+	static_assert(sizeof(FHeader) == 32, "Image cache header layout changed");
+
+	struct FMipEntry
+	{
+		uint64 Offset;
+		uint64 Size;
+		/** CRC32 of the payload, checked only for the levels that are loaded. */
+		uint32 Checksum;
+		uint32 Reserved;
+	};
+	static_assert(sizeof(FMipEntry) == 24, "Image cache mip entry layout changed");
+
+	uint32 ComputeHeaderChecksum(FHeader Header, const TArray<FMipEntry>& Table)
+	{
+		Header.Checksum = 0;
+		const uint32 HeaderCrc = FCrc::MemCrc32(&Header, sizeof(Header));
+		return FCrc::MemCrc32(Table.GetData(), sizeof(FMipEntry) * Table.Num(), HeaderCrc);
+	}
+
+	/** Bytes a level must hold in this format, or zero if the format cannot be stored. */
+	uint64 GetExpectedMipSize(EPixelFormat Format, uint32 Width, uint32 Height, int32 Level)
+	{
+		const FPixelFormatInfo& Info = GPixelFormats[Format];
+		if (!Info.Supported || Info.BlockBytes <= 0 || Info.BlockSizeX <= 0 || Info.BlockSizeY <= 0) return 0;
+
+		const uint64 LevelWidth = FMath::Max(1u, Width >> Level);
+		const uint64 LevelHeight = FMath::Max(1u, Height >> Level);
+		return FMath::DivideAndRoundUp<uint64>(LevelWidth, Info.BlockSizeX) * FMath::DivideAndRoundUp<uint64>(LevelHeight, Info.BlockSizeY) * Info.BlockBytes;
+	}
+
+	/** Stores and evictions can overlap; serialise them so eviction never deletes a file being written. */
+	FCriticalSection GWriteLock;
+
+	FString GetEntryPath(const FString& Key)
+	{
+		return FGXImageCache::GetDirectory() / Key + TEXT(".gxtex");
+	}
+
+	/** Deletes the least recently used entries until the cache fits its budget. */
+	void EvictToBudget()
+	{
+		struct FEntry
+		{
+			FString Path;
+			int64 Size;
+			FDateTime Used;
+		};
+
+		TArray<FEntry> Entries;
+		int64 TotalBytes = 0;
+		IFileManager::Get().IterateDirectoryStat(*FGXImageCache::GetDirectory(), [&Entries, &TotalBytes](const TCHAR* Path, const FFileStatData& Stat)
+		{
+			if (!Stat.bIsDirectory && FPaths::GetExtension(Path) == TEXT("gxtex"))
+			{
+				Entries.Add({ Path, Stat.FileSize, Stat.ModificationTime });
+				TotalBytes += Stat.FileSize;
+			}
+			return true;
+		});
+
+		if (TotalBytes <= FGXImageCache::MaxCacheBytes) return;
+
+		Entries.Sort([](const FEntry& A, const FEntry& B) { return A.Used < B.Used; });
+		for (const FEntry& Entry : Entries)
+		{
+			if (TotalBytes <= FGXImageCache::MaxCacheBytes) break;
+			if (IFileManager::Get().Delete(*Entry.Path, false, false, true))
+			{
+				TotalBytes -= Entry.Size;
+			}
+		}
+	}
+}
+
+FString FGXImageCache::GetDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GenAI") / TEXT("ImageCache");
+}
+
+FString FGXImageCache::MakeKey(const FString& Provider, const FString& Model, const FString& Prompt, const TArray<FString>& Settings)
+{
+	TArray<FString> Words;
+	Prompt.ParseIntoArrayWS(Words);
+
+	// Length-prefixed fields, so no combination of values can collide with another.
+	FString Canonical;
+	const auto AppendField = [&Canonical](const FString& Field)
+	{
+		Canonical += FString::Printf(TEXT("%d:"), Field.Len());
+		Canonical += Field;
+	};
+	AppendField(FString::FromInt(Version));
+	AppendField(Provider.ToLower());
+	AppendField(Model.ToLower());
+	AppendField(FString::Join(Words, TEXT(" ")));
+	for (const FString& Setting : Settings)
+	{
+		AppendField(Setting);
+	}
+
+	const FTCHARToUTF8 Utf8(*Canonical);
+	FSHAHash Hash;
+	FSHA1::HashBuffer(Utf8.Get(), Utf8.Length(), Hash.Hash);
+	return Hash.ToString();
+}
+
+bool FGXImageCache::Contains(const FString& Key)
+{
+	return IFileManager::Get().FileExists(*GetEntryPath(Key));
+}
+
+void FGXImageCache::StoreAsync(const FString& Key, TArray64<uint8> Pixels, int32 Width, int32 Height)
+{
+	if (Width <= 0 || Height <= 0 || Pixels.Num() != static_cast<int64>(Width) * Height * 4) return;
+
+	Async(EAsyncExecution::ThreadPool, [Key, Pixels = MoveTemp(Pixels), Width, Height]() mutable
+	{
+		TArray<TArray64<uint8>> Mips = FGXBlockCompressor::BuildMipChain(MoveTemp(Pixels), Width, Height);
+		const int32 MipCount = Mips.Num();
+
+		FHeader Header = {};
+		Header.Magic = FGXImageCache::Magic;
+		Header.Version = FGXImageCache::Version;
+		Header.MipCount = static_cast<uint16>(MipCount);
+		Header.Width = Width;
+		Header.Height = Height;
+		Header.PixelFormat = PF_B8G8R8A8;
+
+		TArray<FMipEntry> Table;
+		uint64 Offset = sizeof(FHeader) + sizeof(FMipEntry) * MipCount;
+		for (const TArray64<uint8>& Mip : Mips)
+		{
+			Table.Add({ Offset, static_cast<uint64>(Mip.Num()), FCrc::MemCrc32(Mip.GetData(), Mip.Num()), 0 });
+			Offset += Mip.Num();
+		}
+		Header.Checksum = ComputeHeaderChecksum(Header, Table);
+
+		FScopeLock Lock(&GWriteLock);
+		const FString Path = GetEntryPath(Key);
+		const FString TempPath = Path + TEXT(".tmp");
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+		if (!Writer)
+		{
+			UE_LOG(LogGXImageCache, Warning, TEXT("Could not write image cache entry %s"), *TempPath);
+			return;
+		}
+		Writer->Serialize(&Header, sizeof(Header));
+		Writer->Serialize(Table.GetData(), sizeof(FMipEntry) * Table.Num());
+		for (TArray64<uint8>& Mip : Mips)
+		{
+			Writer->Serialize(Mip.GetData(), Mip.Num());
+		}
+		const bool bWritten = Writer->Close() && !Writer->IsError();
+		Writer.Reset();
+
+		if (!bWritten || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+		{
+			IFileManager::Get().Delete(*TempPath);
+			UE_LOG(LogGXImageCache, Warning, TEXT("Could not write image cache entry %s"), *Path);
+			return;
+		}
+		EvictToBudget();
+	});
+}
+
+void FGXImageCache::LoadAsync(const FString& Key, int32 MaxDimension, TFunction<void(UTexture2D*)> OnComplete)
+{
+	check(IsInGameThread());
+
+	Async(EAsyncExecution::ThreadPool, [Key, MaxDimension, OnComplete = MoveTemp(OnComplete)]() mutable
+	{
+		const FString Path = GetEntryPath(Key);
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path, FILEREAD_Silent));
+
+		FHeader Header = {};
+		TArray<FMipEntry> Table;
+		TArray<TArray64<uint8>> Mips;
+		int32 FirstMip = 0;
+		bool bValid = false;
+		if (Reader && Reader->TotalSize() >= static_cast<int64>(sizeof(FHeader)))
+		{
+			Reader->Serialize(&Header, sizeof(Header));
+			bValid = Header.Magic == FGXImageCache::Magic && Header.Version == FGXImageCache::Version && Header.MipCount > 0
+				&& Header.Width > 0 && Header.Height > 0 && Header.PixelFormat < PF_MAX
+				&& Header.MipCount <= FMath::FloorLog2(FMath::Max(Header.Width, Header.Height)) + 1
+				&& Reader->TotalSize() >= static_cast<int64>(sizeof(FHeader) + sizeof(FMipEntry) * Header.MipCount);
+		}
+		if (bValid)
+		{
+			Table.SetNumUninitialized(Header.MipCount);
+			Reader->Serialize(Table.GetData(), sizeof(FMipEntry) * Table.Num());
+			bValid = !Reader->IsError() && ComputeHeaderChecksum(Header, Table) == Header.Checksum;
+		}
+		if (bValid)
+		{
+			// Every level must match its format and dimensions, so a damaged table cannot size an upload wrongly.
+			const EPixelFormat Format = static_cast<EPixelFormat>(Header.PixelFormat);
+			const uint64 FileSize = static_cast<uint64>(Reader->TotalSize());
+			for (int32 Level = 0; Level < Header.MipCount && bValid; ++Level)
+			{
+				const FMipEntry& Entry = Table[Level];
+				const uint64 ExpectedSize = GetExpectedMipSize(Format, Header.Width, Header.Height, Level);
+				bValid = ExpectedSize > 0 && Entry.Size == ExpectedSize && Entry.Size <= FileSize && Entry.Offset <= FileSize - Entry.Size;
+			}
+		}
+		if (bValid)
+		{
+
+			// Skip the levels above the requested resolution; they are never read from disk.
+			while (MaxDimension > 0 && FirstMip + 1 < Header.MipCount && FMath::Max(Header.Width >> FirstMip, Header.Height >> FirstMip) > static_cast<uint32>(MaxDimension))
+			{
+				++FirstMip;
+			}
+
+			Mips.SetNum(Header.MipCount - FirstMip);
+			for (int32 Level = FirstMip; Level < Header.MipCount && bValid; ++Level)
+			{
+				const FMipEntry& Entry = Table[Level];
+				TArray64<uint8>& Mip = Mips[Level - FirstMip];
+				Mip.SetNumUninitialized(Entry.Size);
+				Reader->Seek(Entry.Offset);
+				Reader->Serialize(Mip.GetData(), Mip.Num());
+				bValid = !Reader->IsError() && FCrc::MemCrc32(Mip.GetData(), Mip.Num()) == Entry.Checksum;
+			}
+		}
+		Reader.Reset();
+
+		if (bValid)
+		{
+			// Marks the entry as recently used for eviction.
+			IFileManager::Get().SetTimeStamp(*Path, FDateTime::UtcNow());
+		}
+		else if (IFileManager::Get().FileExists(*Path))
+		{
+			UE_LOG(LogGXImageCache, Warning, TEXT("Discarding damaged image cache entry %s"), *Path);
+			IFileManager::Get().Delete(*Path, false, false, true);
+		}
+
+		const EPixelFormat Format = static_cast<EPixelFormat>(Header.PixelFormat);
+		const int32 Width = FMath::Max(1, static_cast<int32>(Header.Width >> FirstMip));
+		const int32 Height = FMath::Max(1, static_cast<int32>(Header.Height >> FirstMip));
+		AsyncTask(ENamedThreads::GameThread, [bValid, Format, Width, Height, Mips = MoveTemp(Mips), OnComplete = MoveTemp(OnComplete)]() mutable
+		{
+			UTexture2D* Texture = bValid ? FGXTextureDecoder::CreateTextureFromMips(Format, Width, Height, Mips) : nullptr;
+			if (!Texture)
+			{
+				OnComplete(nullptr);
+				return;
+			}
+			FGXTextureDecoder::WhenRenderResourceReady(Texture, [OnComplete = MoveTemp(OnComplete)](UTexture* ReadyTexture)
+			{
+				OnComplete(Cast<UTexture2D>(ReadyTexture));
+			});
+		});
+	});
+}
@@ -0,0 +1,556 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXImagePreprocessor.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Common/GXTextureDecoder.h"
+#include "Common/GXTextureEncoder.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeLock.h"
+#include "Tasks/Task.h"
+#include "UObject/GCObject.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXImagePreprocessor, Log, All);
+
+namespace
+{
+	/** Prepared images are rebuilt from the source on a miss, so a few entries cover a conversation's attachments. */
+	constexpr int32 GMaxCachedImages = 16;
+
+	/**
+	 * Keeps prepared textures alive between sends. Entries are keyed on the source's pixels as well as the source,
+	 * so textures updated in place (pooled or progressive ones) miss instead of returning a stale copy. Written on
+	 * the game thread; resize tasks look keys up under Lock to skip work that is already cached.
+	 */
+	class FPreparedImageCache : public FGCObject
+	{
+	public:
+		struct FEntry
+		{
+			FObjectKey Source;
+			FIntPoint Size;
+			uint64 PixelHash = 0;
+			TObjectPtr<UTexture2D> Texture;
+		};
+
+		/** Most recently used last. */
+		TArray<FEntry> Entries;
+		FCriticalSection Lock;
+
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		{
+			for (FEntry& Entry : Entries)
+			{
+				Collector.AddReferencedObject(Entry.Texture);
+			}
+		}
+
+		virtual FString GetReferencerName() const override
+		{
+			return TEXT("FGXImagePreprocessor");
+		}
+	};
+
+	FPreparedImageCache& GetCache()
+	{
+		static FPreparedImageCache Cache;
+		return Cache;
+	}
+
+	FIntPoint Scaled(const FIntPoint& Size, double Scale)
+	{
+		if (Scale >= 1.0) return Size;
+		// The epsilon keeps exact tile multiples such as 1100 * (1024 / 1100) from landing a pixel short.
+		return FIntPoint(FMath::Max(1, FMath::FloorToInt(Size.X * Scale + 1e-3)), FMath::Max(1, FMath::FloorToInt(Size.Y * Scale + 1e-3)));
+	}
+
+	FIntPoint FitWithin(const FIntPoint& Size, int32 MaxWidth, int32 MaxHeight)
+	{
+		return Scaled(Size, FMath::Min(static_cast<double>(MaxWidth) / Size.X, static_cast<double>(MaxHeight) / Size.Y));
+	}
+
+	int32 TileCount(const FIntPoint& Size, int32 Tile)
+	{
+		return FMath::DivideAndRoundUp(Size.X, Tile) * FMath::DivideAndRoundUp(Size.Y, Tile);
+	}
+
+	/** OpenAI models billed per 32 px patch rather than per 512 px tile, with their token multiplier. */
+	bool IsPatchBilled(const FString& Model, float& OutMultiplier)
+	{
+		if (Model.Contains(TEXT("gpt-4.1-mini")))  { OutMultiplier = 1.62f; return true; }
+		if (Model.Contains(TEXT("gpt-4.1-nano")))  { OutMultiplier = 2.46f; return true; }
+		if (Model.Contains(TEXT("o4-mini")))       { OutMultiplier = 1.72f; return true; }
+		return false;
+	}
+
+	/** The size the provider reduces an image to before the model sees it. */
+	FIntPoint ServerSideSize(EGXChatProvider Provider, const FString& Model, const FIntPoint& Size, bool bLowDetail)
+	{
+		float PatchMultiplier = 1.f;
+		switch (Provider)
+		{
+		case EGXChatProvider::OpenAI:
+			if (IsPatchBilled(Model, PatchMultiplier))
+			{
+				constexpr int32 MaxPatches = 1536;
+				if (TileCount(Size, 32) <= MaxPatches) return Size;
+				FIntPoint Result = Scaled(Size, FMath::Sqrt(32.0 * 32.0 * MaxPatches / (static_cast<double>(Size.X) * Size.Y)));
+				while (TileCount(Result, 32) > MaxPatches)
+				{
+					Result = Scaled(Result, 0.98);
+				}
+				return Result;
+			}
+			if (bLowDetail)
+			{
+				return FitWithin(Size, 512, 512);
+			}
+			{
+				const FIntPoint Fitted = FitWithin(Size, 2048, 2048);
+				return Scaled(Fitted, 768.0 / FMath::Min(Fitted.X, Fitted.Y));
+			}
+
+		case EGXChatProvider::Anthropic:
+		{
+			const FIntPoint Fitted = FitWithin(Size, 1568, 1568);
+			return Scaled(Fitted, FMath::Sqrt(1150000.0 / (static_cast<double>(Fitted.X) * Fitted.Y)));
+		}
+
+		case EGXChatProvider::Google:
+			return FitWithin(Size, 3072, 3072);
+
+		case EGXChatProvider::XAI:
+			return FitWithin(Size, 1024, 1024);
+
+		default:
+			return Size;
+		}
+	}
+
+	/** Tile edge of the provider's billing grid, or zero if billing is not tiled. */
+	int32 BillingTile(EGXChatProvider Provider, const FString& Model, const FIntPoint& Size)
+	{
+		float PatchMultiplier = 1.f;
+		switch (Provider)
+		{
+		case EGXChatProvider::OpenAI: return IsPatchBilled(Model, PatchMultiplier) ? 0 : 512;
+		case EGXChatProvider::Google: return Size.X <= 384 && Size.Y <= 384 ? 0 : 768;
+		case EGXChatProvider::XAI:    return 512;
+		default:                      return 0;
+		}
+	}
+
+	/** Shrinks uniformly by the smallest amount, within Tolerance, that removes a row or column of tiles. */
+	FIntPoint SnapToTiles(const FIntPoint& Size, int32 Tile, float Tolerance)
+	{
+		double BestScale = 0.0;
+		for (const int32 Edge : { Size.X, Size.Y })
+		{
+			const int32 Tiles = FMath::DivideAndRoundUp(Edge, Tile);
+			if (Tiles <= 1 || Edge % Tile == 0) continue;
+			BestScale = FMath::Max(BestScale, static_cast<double>((Tiles - 1) * Tile) / Edge);
+		}
+		return BestScale >= 1.0 - Tolerance ? Scaled(Size, BestScale) : Size;
+	}
+
+	struct FContribution
+	{
+		int32 First = 0;
+		int32 Count = 0;
+		int32 WeightOffset = 0;
+	};
+
+	/** Source pixels covered by each destination pixel of a box (area) filter, with their coverage as weights. */
+	void BuildContributions(int32 SourceSize, int32 DestSize, TArray<FContribution>& OutContributions, TArray<float>& OutWeights)
+	{
+		const double Scale = static_cast<double>(SourceSize) / DestSize;
+		OutContributions.SetNum(DestSize);
+		OutWeights.Reset();
+		for (int32 Dest = 0; Dest < DestSize; ++Dest)
+		{
+			const double Start = Dest * Scale;
+			const double End = FMath::Min((Dest + 1) * Scale, static_cast<double>(SourceSize));
+			FContribution& Contribution = OutContributions[Dest];
+			Contribution.First = FMath::FloorToInt(Start);
+			Contribution.Count = FMath::Max(1, FMath::CeilToInt(End) - Contribution.First);
+			Contribution.WeightOffset = OutWeights.Num();
+			for (int32 Index = 0; Index < Contribution.Count; ++Index)
+			{
+				const double Pixel = Contribution.First + Index;
+				const double Coverage = FMath::Min(End, Pixel + 1.0) - FMath::Max(Start, Pixel);
+				OutWeights.Add(static_cast<float>(Coverage / Scale));
+			}
+		}
+	}
+}
+
+int32 FGXImagePreprocessor::EstimateTokens(EGXChatProvider Provider, const FString& Model, int32 Width, int32 Height, bool bLowDetail)
+{
+	if (Width <= 0 || Height <= 0) return 0;
+	const FIntPoint Size = ServerSideSize(Provider, Model, FIntPoint(Width, Height), bLowDetail);
+
+	float PatchMultiplier = 1.f;
+	switch (Provider)
+	{
+	case EGXChatProvider::OpenAI:
+	{
+		if (IsPatchBilled(Model, PatchMultiplier))
+		{
+			return FMath::CeilToInt(TileCount(Size, 32) * PatchMultiplier);
+		}
+		const bool bMini = Model.Contains(TEXT("4o-mini"));
+		const int32 BaseTokens = bMini ? 2833 : 85;
+		const int32 TileTokens = bMini ? 5667 : 170;
+		return bLowDetail ? BaseTokens : BaseTokens + TileTokens * TileCount(Size, 512);
+	}
+	case EGXChatProvider::Anthropic:
+		return FMath::DivideAndRoundUp(Size.X * Size.Y, 750);
+	case EGXChatProvider::Google:
+		return Size.X <= 384 && Size.Y <= 384 ? 258 : 258 * TileCount(Size, 768);
+	case EGXChatProvider::XAI:
+		return 85 + 170 * TileCount(Size, 512);
+	default:
+		return 0;
+	}
+}
+
+FGXImagePlan FGXImagePreprocessor::PlanImage(EGXChatProvider Provider, const FString& Model, int32 Width, int32 Height, const FGXImagePreprocessSettings& Settings)
+{
+	FGXImagePlan Plan;
+	if (Width <= 0 || Height <= 0) return Plan;
+
+	// Only OpenAI's tiled models have a detail level worth choosing.
+	float PatchMultiplier = 1.f;
+	const bool bHasDetail = Provider == EGXChatProvider::OpenAI && !IsPatchBilled(Model, PatchMultiplier);
+	Plan.bLowDetail = bHasDetail && Settings.Detail == EGXImageDetailPolicy::Low;
+
+	FIntPoint Size = ServerSideSize(Provider, Model, FIntPoint(Width, Height), Plan.bLowDetail);
+	if (Settings.MaxLongEdge > 0)
+	{
+		Size = FitWithin(Size, Settings.MaxLongEdge, Settings.MaxLongEdge);
+	}
+	const int32 Tile = BillingTile(Provider, Model, Size);
+	if (!Plan.bLowDetail && Tile > 0 && Settings.TileSnapTolerance > 0.f)
+	{
+		Size = SnapToTiles(Size, Tile, Settings.TileSnapTolerance);
+	}
+
+	// An image that already fits the low-detail size loses nothing by being sent as one.
+	if (bHasDetail && Settings.Detail == EGXImageDetailPolicy::Auto && Size.X <= 512 && Size.Y <= 512)
+	{
+		Plan.bLowDetail = true;
+	}
+
+	Plan.Width = Size.X;
+	Plan.Height = Size.Y;
+	Plan.EstimatedTokens = EstimateTokens(Provider, Model, Size.X, Size.Y, Plan.bLowDetail);
+	return Plan;
+}
+
+namespace
+{
+	/** One image on its way through Prepare or PrepareAllAsync. */
+	struct FPrepareJob
+	{
+		TWeakObjectPtr<UTexture2D> Source;
+		FObjectKey SourceKey;
+		FGXImagePreprocessStats Stats;
+		FIntPoint PlanSize = FIntPoint::ZeroValue;
+		TArray64<uint8> Pixels;
+		FIntPoint PixelsSize = FIntPoint::ZeroValue;
+		uint64 PixelHash = 0;
+		TArray64<uint8> Resized;
+		FIntPoint ResizedSize = FIntPoint::ZeroValue;
+	};
+
+	int32 FindCachedIndex(const FPreparedImageCache& Cache, const FObjectKey& Source, const FIntPoint& Size, uint64 PixelHash)
+	{
+		return Cache.Entries.IndexOfByPredicate([&Source, &Size, PixelHash](const FPreparedImageCache::FEntry& Entry)
+		{
+			return Entry.Source == Source && Entry.Size == Size && Entry.PixelHash == PixelHash && Entry.Texture;
+		});
+	}
+
+	/** Game thread. */
+	UTexture2D* FindCached(const FObjectKey& Source, const FIntPoint& Size, uint64 PixelHash)
+	{
+		FPreparedImageCache& Cache = GetCache();
+		FScopeLock Lock(&Cache.Lock);
+		const int32 Index = FindCachedIndex(Cache, Source, Size, PixelHash);
+		if (Index == INDEX_NONE) return nullptr;
+
+		FPreparedImageCache::FEntry Entry = Cache.Entries[Index];
+		Cache.Entries.RemoveAt(Index);
+		return Cache.Entries.Add_GetRef(MoveTemp(Entry)).Texture;
+	}
+
+	/** Any thread. The entry can still be evicted before the game thread fetches it. */
+	bool IsCached(const FObjectKey& Source, const FIntPoint& Size, uint64 PixelHash)
+	{
+		FPreparedImageCache& Cache = GetCache();
+		FScopeLock Lock(&Cache.Lock);
+		return FindCachedIndex(Cache, Source, Size, PixelHash) != INDEX_NONE;
+	}
+
+	/**
+	 * Game thread: plans the image; cache hits resolve in FinishJob.
+	 * @return True if the job still needs its pixels read, then ResizeJob and FinishJob.
+	 */
+	bool BeginJob(UTexture2D* Source, EGXChatProvider Provider, const FString& Model, const FGXImagePreprocessSettings& Settings, FPrepareJob& Job)
+	{
+		const int32 Width = Source->GetSizeX();
+		const int32 Height = Source->GetSizeY();
+
+		Job.Source = Source;
+		Job.SourceKey = FObjectKey(Source);
+		FGXImagePreprocessStats& Stats = Job.Stats;
+		Stats.OriginalSize = FIntPoint(Width, Height);
+		Stats.OriginalBytes = static_cast<int64>(Width) * Height * 4;
+		Stats.OriginalTokens = FGXImagePreprocessor::EstimateTokens(Provider, Model, Width, Height, false);
+		Stats.SentSize = Stats.OriginalSize;
+		Stats.SentBytes = Stats.OriginalBytes;
+		Stats.SentTokens = Stats.OriginalTokens;
+		Stats.SentTexture = Source;
+
+		const FGXImagePlan Plan = Settings.bEnabled ? FGXImagePreprocessor::PlanImage(Provider, Model, Width, Height, Settings) : FGXImagePlan();
+		if (Plan.Width <= 0) return false;
+
+		Stats.bLowDetail = Plan.bLowDetail;
+		Stats.SentTokens = Plan.EstimatedTokens;
+		if (Plan.Width >= Width && Plan.Height >= Height) return false;
+
+		// The cache is keyed on the pixels, so they are read even when a prepared copy may exist.
+		Job.PlanSize = FIntPoint(Plan.Width, Plan.Height);
+		return true;
+	}
+
+	/** Any thread. Skips the resize when a copy of these pixels at this size is already cached. */
+	void ResizeJob(FPrepareJob& Job)
+	{
+		if (Job.Pixels.Num() == 0) return;
+
+		Job.PixelHash = CityHash64(reinterpret_cast<const char*>(Job.Pixels.GetData()), Job.Pixels.Num())
+			^ (static_cast<uint64>(Job.PixelsSize.X) << 32 | static_cast<uint32>(Job.PixelsSize.Y));
+		if (IsCached(Job.SourceKey, Job.PlanSize, Job.PixelHash)) return;
+
+		Job.ResizedSize = FIntPoint(FMath::Min(Job.PlanSize.X, Job.PixelsSize.X), FMath::Min(Job.PlanSize.Y, Job.PixelsSize.Y));
+		FGXImagePreprocessor::Downscale(Job.Pixels, Job.PixelsSize.X, Job.PixelsSize.Y, Job.Resized, Job.ResizedSize.X, Job.ResizedSize.Y);
+		Job.Pixels.Empty();
+	}
+
+	/** Game thread: turns resized pixels into the texture to send and caches it. */
+	void FinishJob(FPrepareJob& Job)
+	{
+		UTexture2D* Source = Job.Source.Get();
+		if (!Source) return;
+
+		// The same source may appear twice in one batch; the first to finish wins.
+		UTexture2D* Prepared = FindCached(Job.SourceKey, Job.PlanSize, Job.PixelHash);
+		if (!Prepared)
+		{
+			if (Job.Resized.Num() == 0 && Job.Pixels.Num() > 0)
+			{
+				// The cached copy ResizeJob found was evicted since.
+				Job.ResizedSize = FIntPoint(FMath::Min(Job.PlanSize.X, Job.PixelsSize.X), FMath::Min(Job.PlanSize.Y, Job.PixelsSize.Y));
+				FGXImagePreprocessor::Downscale(Job.Pixels, Job.PixelsSize.X, Job.PixelsSize.Y, Job.Resized, Job.ResizedSize.X, Job.ResizedSize.Y);
+			}
+			if (Job.Resized.Num() == 0)
+			{
+				UE_LOG(LogGXImagePreprocessor, Warning, TEXT("Could not read the pixels of %s; sending it unchanged."), *Source->GetName());
+				return;
+			}
+
+			Prepared = FGXTextureDecoder::CreateTexture(Job.Resized, Job.ResizedSize.X, Job.ResizedSize.Y);
+			if (!Prepared) return;
+
+			FPreparedImageCache& Cache = GetCache();
+			FScopeLock Lock(&Cache.Lock);
+			// A texture updated in place leaves its older copies unreachable; drop them rather than wait for eviction.
+			Cache.Entries.RemoveAll([&Job](const FPreparedImageCache::FEntry& Entry) { return Entry.Source == Job.SourceKey && Entry.Size == Job.PlanSize; });
+			if (Cache.Entries.Num() >= GMaxCachedImages)
+			{
+				Cache.Entries.RemoveAt(0);
+			}
+			Cache.Entries.Add({ Job.SourceKey, Job.PlanSize, Job.PixelHash, Prepared });
+		}
+		Job.Pixels.Empty();
+		Job.Resized.Empty();
+		Job.Stats.SentTexture = Prepared;
+	}
+
+	void LogJob(const FPrepareJob& Job, EGXChatProvider Provider)
+	{
+		const FGXImagePreprocessStats& Stats = Job.Stats;
+		UE_LOG(LogGXImagePreprocessor, Verbose, TEXT("%s image %dx%d -> %dx%d%s: %lld KB and ~%d tokens saved"),
+			*GXChatProviderToString(Provider), Stats.OriginalSize.X, Stats.OriginalSize.Y, Stats.SentSize.X, Stats.SentSize.Y,
+			Stats.bLowDetail ? TEXT(" (low detail)") : TEXT(""), Stats.GetBytesSaved() / 1024, Stats.GetTokensSaved());
+	}
+
+	/** Brings the size fields in line with the texture that is actually sent. */
+	void CompleteStats(FGXImagePreprocessStats& Stats)
+	{
+		if (Stats.SentTexture && Stats.SentSize != FIntPoint(Stats.SentTexture->GetSizeX(), Stats.SentTexture->GetSizeY()))
+		{
+			Stats.SentSize = FIntPoint(Stats.SentTexture->GetSizeX(), Stats.SentTexture->GetSizeY());
+			Stats.SentBytes = static_cast<int64>(Stats.SentSize.X) * Stats.SentSize.Y * 4;
+		}
+	}
+}
+
+UTexture2D* FGXImagePreprocessor::Prepare(UTexture2D* Source, EGXChatProvider Provider, const FString& Model,
+	const FGXImagePreprocessSettings& Settings, FGXImagePreprocessStats* OutStats)
+{
+	check(IsInGameThread());
+	if (!Source) return nullptr;
+
+	FPrepareJob Job;
+	if (BeginJob(Source, Provider, Model, Settings, Job))
+	{
+		FGXTextureEncoder::ReadPixelsBGRA8(Source, Job.Pixels, Job.PixelsSize.X, Job.PixelsSize.Y);
+		ResizeJob(Job);
+		FinishJob(Job);
+	}
+	CompleteStats(Job.Stats);
+	LogJob(Job, Provider);
+
+	if (OutStats)
+	{
+		*OutStats = Job.Stats;
+	}
+	return Job.Stats.SentTexture;
+}
+
+void FGXImagePreprocessor::PrepareAllAsync(UObject* WorldContextObject, const TArray<UTexture2D*>& Sources, EGXChatProvider Provider, const FString& Model,
+	const FGXImagePreprocessSettings& Settings, FGXOnImagesPrepared OnComplete)
+{
+	check(IsInGameThread());
+
+	TSharedRef<TArray<FPrepareJob>, ESPMode::ThreadSafe> Jobs = MakeShared<TArray<FPrepareJob>, ESPMode::ThreadSafe>();
+	Jobs->Reserve(Sources.Num());
+
+	// Reads start here, since they touch the texture; each resize follows its read on a worker, including reads
+	// that go through a GPU readback and land frames later.
+	TArray<UE::Tasks::FTask> ResizeTasks;
+	for (UTexture2D* Source : Sources)
+	{
+		if (!Source) continue;
+		const int32 Index = Jobs->AddDefaulted();
+		if (BeginJob(Source, Provider, Model, Settings, (*Jobs)[Index]))
+		{
+			UE::Tasks::FTaskEvent PixelsRead(UE_SOURCE_LOCATION);
+			ResizeTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [Jobs, Index]()
+			{
+				ResizeJob((*Jobs)[Index]);
+			}, UE::Tasks::Prerequisites(PixelsRead)));
+
+			FGXTextureEncoder::ReadPixelsBGRA8Async(WorldContextObject, Source, [Jobs, Index, PixelsRead](TArray64<uint8>&& Pixels, int32 Width, int32 Height) mutable
+			{
+				FPrepareJob& Job = (*Jobs)[Index];
+				Job.Pixels = MoveTemp(Pixels);
+				Job.PixelsSize = FIntPoint(Width, Height);
+				PixelsRead.Trigger();
+			});
+		}
+	}
+
+	// Joined on the task graph, never by waiting on the game thread.
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Jobs, Provider, OnComplete = MoveTemp(OnComplete)]() mutable
+	{
+		AsyncTask(ENamedThreads::GameThread, [Jobs, Provider, OnComplete = MoveTemp(OnComplete)]()
+		{
+			TArray<FGXImagePreprocessStats> Prepared;
+			Prepared.Reserve(Jobs->Num());
+			for (FPrepareJob& Job : *Jobs)
+			{
+				// Stats.SentTexture is not a GC reference while the job is in flight; a collected source drops out.
+				if (!Job.Source.IsValid()) continue;
+				FinishJob(Job);
+				CompleteStats(Job.Stats);
+				LogJob(Job, Provider);
+				Prepared.Add(MoveTemp(Job.Stats));
+			}
+			OnComplete(MoveTemp(Prepared));
+		});
+	}, UE::Tasks::Prerequisites(ResizeTasks));
+}
+
+void FGXImagePreprocessor::Downscale(const TArray64<uint8>& Source, int32 SourceWidth, int32 SourceHeight, TArray64<uint8>& OutDest, int32 DestWidth, int32 DestHeight)
+{
+	check(DestWidth > 0 && DestHeight > 0 && DestWidth <= SourceWidth && DestHeight <= SourceHeight);
+	check(Source.Num() == static_cast<int64>(SourceWidth) * SourceHeight * 4);
+
+	TArray<FContribution> Columns;
+	TArray<float> ColumnWeights;
+	BuildContributions(SourceWidth, DestWidth, Columns, ColumnWeights);
+	TArray<FContribution> Rows;
+	TArray<float> RowWeights;
+	BuildContributions(SourceHeight, DestHeight, Rows, RowWeights);
+
+	OutDest.SetNumUninitialized(static_cast<int64>(DestWidth) * DestHeight * 4);
+
+	// One BGRA pixel per vector register. Each destination row blends its source rows into a float row,
+	// then blends that row's columns; the two passes are the separable form of the box filter.
+	ParallelFor(DestHeight, [&](int32 DestY)
+	{
+		TArray<VectorRegister4Float> Row;
+		Row.SetNumUninitialized(SourceWidth);
+
+		const FContribution& RowContribution = Rows[DestY];
+		for (int32 Index = 0; Index < RowContribution.Count; ++Index)
+		{
+			const VectorRegister4Float Weight = VectorSetFloat1(RowWeights[RowContribution.WeightOffset + Index]);
+			const uint8* SourceRow = Source.GetData() + static_cast<int64>(RowContribution.First + Index) * SourceWidth * 4;
+			for (int32 X = 0; X < SourceWidth; ++X)
+			{
+				const VectorRegister4Float Pixel = VectorMultiply(VectorLoadByte4(SourceRow + X * 4), Weight);
+				Row[X] = Index == 0 ? Pixel : VectorAdd(Row[X], Pixel);
+			}
+		}
+
+		const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+		uint8* DestRow = OutDest.GetData() + static_cast<int64>(DestY) * DestWidth * 4;
+		for (int32 DestX = 0; DestX < DestWidth; ++DestX)
+		{
+			const FContribution& Column = Columns[DestX];
+			VectorRegister4Float Sum = VectorZeroFloat();
+			for (int32 Index = 0; Index < Column.Count; ++Index)
+			{
+				Sum = VectorMultiplyAdd(Row[Column.First + Index], VectorSetFloat1(ColumnWeights[Column.WeightOffset + Index]), Sum);
+			}
+			VectorStoreByte4(VectorAdd(Sum, Half), DestRow + DestX * 4);
+		}
+	}, DestHeight < 32 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void FGXImagePreprocessor::ClearCache()
+{
+	check(IsInGameThread());
+	FPreparedImageCache& Cache = GetCache();
+	FScopeLock Lock(&Cache.Lock);
+	Cache.Entries.Empty();
+}
+
+#if WITH_GENAI_MODULE
+FGenAIMessageContent FGXImagePreprocessor::MakeImageContent(UTexture2D* Source, EGXChatProvider Provider, const FString& Model,
+	const FGXImagePreprocessSettings& Settings, FGXImagePreprocessStats* OutStats)
+{
+	FGXImagePreprocessStats Stats;
+	Prepare(Source, Provider, Model, Settings, &Stats);
+	if (OutStats)
+	{
+		*OutStats = Stats;
+	}
+	return MakeImageContent(Stats, Provider, Settings);
+}
+
+FGenAIMessageContent FGXImagePreprocessor::MakeImageContent(const FGXImagePreprocessStats& Prepared, EGXChatProvider Provider, const FGXImagePreprocessSettings& Settings)
+{
+	// The plan's choice is explicit, so the provider does not second-guess it; other providers ignore the field.
+	EGenAIImageDetail Detail = EGenAIImageDetail::Auto;
+	if (Settings.bEnabled && Provider == EGXChatProvider::OpenAI)
+	{
+		Detail = Prepared.bLowDetail ? EGenAIImageDetail::Low : EGenAIImageDetail::High;
+	}
+	return FGenAIMessageContent::FromTexture2D(Prepared.SentTexture, Detail);
+}
+#endif
@@ -0,0 +1,274 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXMicrophoneCapture.h"
+#include "AudioCaptureCore.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXMicrophoneCapture, Log, All);
+
+namespace
+{
+	/** Capture callback size. Small enough that the last few milliseconds before Stop() are not lost. */
+	constexpr uint32 GFramesPerCallback = 512;
+
+	constexpr int32 GWavHeaderBytes = 44;
+
+	void WriteU32(uint8*& Cursor, uint32 Value)
+	{
+		Cursor[0] = Value & 0xFF;
+		Cursor[1] = (Value >> 8) & 0xFF;
+		Cursor[2] = (Value >> 16) & 0xFF;
+		Cursor[3] = (Value >> 24) & 0xFF;
+		Cursor += 4;
+	}
+
+	void WriteU16(uint8*& Cursor, uint16 Value)
+	{
+		Cursor[0] = Value & 0xFF;
+		Cursor[1] = (Value >> 8) & 0xFF;
+		Cursor += 2;
+	}
+
+	void WriteTag(uint8*& Cursor, const char (&Tag)[5])
+	{
+		FMemory::Memcpy(Cursor, Tag, 4);
+		Cursor += 4;
+	}
+
+	int16 ToPCM16(float Sample)
+	{
+		return static_cast<int16>(FMath::RoundToInt(FMath::Clamp(Sample, -1.f, 1.f) * 32767.f));
+	}
+}
+
+FGXMicrophoneCapture::FGXMicrophoneCapture() = default;
+
+FGXMicrophoneCapture::~FGXMicrophoneCapture()
+{
+	CloseStream();
+}
+
+bool FGXMicrophoneCapture::Start(float MaxSeconds)
+{
+	CloseStream();
+
+	if (!Capture)
+	{
+		Capture = MakeUnique<Audio::FAudioCapture>();
+	}
+
+	Audio::FCaptureDeviceInfo DeviceInfo;
+	if (!Capture->GetCaptureDeviceInfo(DeviceInfo))
+	{
+		UE_LOG(LogGXMicrophoneCapture, Warning, TEXT("No audio input device is available."));
+		return false;
+	}
+
+	Audio::FAudioCaptureDeviceParams Params;
+	Audio::FOnCaptureFunction OnCapture = [this](const float* Audio, int32 NumFrames, int32 NumChannels, int32 SampleRate, double StreamTime, bool bOverflow)
+	{
+		OnAudioCaptured(Audio, NumFrames, NumChannels, SampleRate);
+	};
+
+	if (!Capture->OpenCaptureStream(Params, MoveTemp(OnCapture), GFramesPerCallback))
+	{
+		UE_LOG(LogGXMicrophoneCapture, Warning, TEXT("Could not open the input device '%s'."), *DeviceInfo.DeviceName);
+		CloseStream();
+		return false;
+	}
+
+	// The opened stream's rate can differ from the device's preferred one; the first buffer has the final say.
+	const int32 StreamSampleRate = Capture->GetSampleRate() > 0 ? Capture->GetSampleRate() : DeviceInfo.PreferredSampleRate;
+	DeviceSampleRate.store(StreamSampleRate, std::memory_order_release);
+	bReceivedAudio = false;
+
+	// Allocated once per take (and kept between takes), so the capture callback never allocates.
+	const int32 Capacity = FMath::Max(1, FMath::CeilToInt(FMath::Max(MaxSeconds, 0.f) * StreamSampleRate));
+	Samples.SetNumUninitialized(Capacity, false);
+	NumSamples.store(0, std::memory_order_relaxed);
+	bTruncated.store(false, std::memory_order_relaxed);
+	bRateChanged.store(false, std::memory_order_relaxed);
+
+	if (!Capture->StartStream())
+	{
+		UE_LOG(LogGXMicrophoneCapture, Warning, TEXT("Could not start the input device '%s'."), *DeviceInfo.DeviceName);
+		CloseStream();
+		return false;
+	}
+
+	bRecording = true;
+	UE_LOG(LogGXMicrophoneCapture, Log, TEXT("Recording '%s' at %d Hz, up to %.0f s."), *DeviceInfo.DeviceName, StreamSampleRate, MaxSeconds);
+	return true;
+}
+
+bool FGXMicrophoneCapture::Stop(int32 SampleRate, TArray<uint8>& OutWav)
+{
+	if (!bRecording)
+	{
+		return false;
+	}
+
+	// Closing joins the capture thread, so every sample it wrote is visible below.
+	CloseStream();
+
+	const int32 Recorded = NumSamples.load(std::memory_order_acquire);
+	if (Recorded == 0)
+	{
+		return false;
+	}
+
+	const int32 RecordedRate = GetSampleRate();
+	if (WasTruncated())
+	{
+		UE_LOG(LogGXMicrophoneCapture, Warning, TEXT("Recording reached its %.1f s limit; the rest was dropped."), static_cast<float>(Samples.Num()) / RecordedRate);
+	}
+	if (bRateChanged.load(std::memory_order_relaxed))
+	{
+		UE_LOG(LogGXMicrophoneCapture, Warning, TEXT("The input device changed its sample rate during the take; audio after the change was dropped."));
+	}
+
+	EncodeWav(Samples.GetData(), Recorded, RecordedRate, SampleRate, OutWav);
+	return true;
+}
+
+void FGXMicrophoneCapture::Stop()
+{
+	CloseStream();
+}
+
+void FGXMicrophoneCapture::Cancel()
+{
+	CloseStream();
+	NumSamples.store(0, std::memory_order_relaxed);
+}
+
+float FGXMicrophoneCapture::GetRecordedSeconds() const
+{
+	const int32 Rate = GetSampleRate();
+	return Rate > 0 ? static_cast<float>(NumSamples.load(std::memory_order_relaxed)) / Rate : 0.f;
+}
+
+void FGXMicrophoneCapture::CloseStream()
+{
+	if (Capture && Capture->IsStreamOpen())
+	{
+		Capture->StopStream();
+		Capture->CloseStream();
+	}
+	bRecording = false;
+}
+
+void FGXMicrophoneCapture::OnAudioCaptured(const float* Audio, int32 NumFrames, int32 NumChannels, int32 SampleRate)
+{
+	// The take is kept at the rate its first buffer reports; the channel count is taken from every buffer below.
+	if (SampleRate > 0 && !bReceivedAudio)
+	{
+		bReceivedAudio = true;
+		DeviceSampleRate.store(SampleRate, std::memory_order_release);
+	}
+	else if (SampleRate > 0 && SampleRate != DeviceSampleRate.load(std::memory_order_relaxed))
+	{
+		bRateChanged.store(true, std::memory_order_relaxed);
+	}
+	if (bRateChanged.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	const int32 Start = NumSamples.load(std::memory_order_relaxed);
+	const int32 Count = FMath::Min(NumFrames, Samples.Num() - Start);
+	if (Count < NumFrames)
+	{
+		bTruncated.store(true, std::memory_order_relaxed);
+	}
+	if (Count <= 0 || NumChannels <= 0)
+	{
+		return;
+	}
+
+	float* Dest = Samples.GetData() + Start;
+	if (NumChannels == 1)
+	{
+		FMemory::Memcpy(Dest, Audio, Count * sizeof(float));
+	}
+	else
+	{
+		const float Scale = 1.f / NumChannels;
+		for (int32 Frame = 0; Frame < Count; ++Frame)
+		{
+			const float* In = Audio + Frame * NumChannels;
+			float Sum = 0.f;
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				Sum += In[Channel];
+			}
+			Dest[Frame] = Sum * Scale;
+		}
+	}
+
+	NumSamples.store(Start + Count, std::memory_order_release);
+}
+
+bool FGXMicrophoneCapture::GetDefaultDeviceFormat(int32& OutSampleRate, int32& OutNumChannels)
+{
+	Audio::FAudioCapture Query;
+	Audio::FCaptureDeviceInfo DeviceInfo;
+	if (!Query.GetCaptureDeviceInfo(DeviceInfo))
+	{
+		return false;
+	}
+	OutSampleRate = DeviceInfo.PreferredSampleRate;
+	OutNumChannels = DeviceInfo.InputChannels;
+	return true;
+}
+
+void FGXMicrophoneCapture::EncodeWav(const float* Samples, int32 NumSamples, int32 SourceRate, int32 SampleRate, TArray<uint8>& OutWav)
+{
+	const double Step = static_cast<double>(SourceRate) / SampleRate;
+	const int32 NumOut = FMath::Max(0, FMath::FloorToInt(NumSamples / Step));
+	const uint32 DataBytes = NumOut * sizeof(int16);
+
+	OutWav.SetNumUninitialized(GWavHeaderBytes + DataBytes);
+	uint8* Cursor = OutWav.GetData();
+
+	WriteTag(Cursor, "RIFF");
+	WriteU32(Cursor, GWavHeaderBytes - 8 + DataBytes);
+	WriteTag(Cursor, "WAVE");
+	WriteTag(Cursor, "fmt ");
+	WriteU32(Cursor, 16);
+	WriteU16(Cursor, 1);				// PCM
+	WriteU16(Cursor, 1);				// Mono
+	WriteU32(Cursor, SampleRate);
+	WriteU32(Cursor, SampleRate * sizeof(int16));
+	WriteU16(Cursor, sizeof(int16));
+	WriteU16(Cursor, 16);
+	WriteTag(Cursor, "data");
+	WriteU32(Cursor, DataBytes);
+
+	int16* Out = reinterpret_cast<int16*>(Cursor);
+	if (Step <= 1.0)
+	{
+		for (int32 Index = 0; Index < NumOut; ++Index)
+		{
+			const double Position = Index * Step;
+			const int32 Left = FMath::FloorToInt(Position);
+			const int32 Right = FMath::Min(Left + 1, NumSamples - 1);
+			const float Alpha = static_cast<float>(Position - Left);
+			Out[Index] = ToPCM16(FMath::Lerp(Samples[Left], Samples[Right], Alpha));
+		}
+	}
+	else
+	{
+		// A box filter over each output sample's span; enough to keep speech from aliasing at 2:1 and similar ratios.
+		for (int32 Index = 0; Index < NumOut; ++Index)
+		{
+			const int32 First = FMath::FloorToInt(Index * Step);
+			const int32 Last = FMath::Min(FMath::FloorToInt((Index + 1) * Step), NumSamples);
+			float Sum = 0.f;
+			for (int32 Source = First; Source < Last; ++Source)
+			{
+				Sum += Samples[Source];
+			}
+			Out[Index] = ToPCM16(Last > First ? Sum / (Last - First) : Samples[First]);
+		}
+	}
+}
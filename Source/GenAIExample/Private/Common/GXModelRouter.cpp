@@ -0,0 +1,278 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXModelRouter.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXRouter, Log, All);
+
+namespace
+{
+	FGXModelEndpoint MakeEndpoint(EGXChatProvider Provider, const TCHAR* Model, EGXModelCapability Caps, float Cost, bool bSmall, float PriorTtftMs)
+	{
+		FGXModelEndpoint Endpoint;
+		Endpoint.Provider = Provider;
+		Endpoint.Model = Model;
+		Endpoint.Capabilities = static_cast<int32>(Caps);
+		Endpoint.CostPer1kTokens = Cost;
+		Endpoint.bIsSmallModel = bSmall;
+		Endpoint.PriorTtftMs = PriorTtftMs;
+		return Endpoint;
+	}
+
+	// Words that usually mean the user wants multi-step thinking rather than a quick label.
+	const TCHAR* GReasoningHints[] = { TEXT("why"), TEXT("explain"), TEXT("prove"), TEXT("step by step"), TEXT("plan"), TEXT("analyze"), TEXT("analyse"), TEXT("compare"), TEXT("derive") };
+
+	/** Case-insensitive match of Word bounded by non-alphanumerics, so "plan" does not match "planet". */
+	bool ContainsWord(const FString& Text, const TCHAR* Word)
+	{
+		const int32 WordLen = FCString::Strlen(Word);
+		int32 Index = Text.Find(Word, ESearchCase::IgnoreCase);
+		while (Index != INDEX_NONE)
+		{
+			const int32 End = Index + WordLen;
+			const bool bStartsWord = Index == 0 || !FChar::IsAlnum(Text[Index - 1]);
+			const bool bEndsWord = End >= Text.Len() || !FChar::IsAlnum(Text[End]);
+			if (bStartsWord && bEndsWord)
+			{
+				return true;
+			}
+			Index = Text.Find(Word, ESearchCase::IgnoreCase, ESearchDir::FromStart, Index + 1);
+		}
+		return false;
+	}
+}
+
+void UGXModelRouter::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (Endpoints.Num() == 0)
+	{
+		// Seed table. Prices and priors are rough and only need to be right relative to each other;
+		// the EWMA takes over after the first few requests.
+		using C = EGXModelCapability;
+		Endpoints.Add(MakeEndpoint(EGXChatProvider::OpenAI,    TEXT("gpt-4.1-nano"),              C::Vision | C::Structured | C::Streaming, 0.0003f, true,  350.f));
+		Endpoints.Add(MakeEndpoint(EGXChatProvider::OpenAI,    TEXT("gpt-4.1"),                   C::Vision | C::Structured | C::Streaming, 0.0050f, false, 700.f));
+		Endpoints.Add(MakeEndpoint(EGXChatProvider::OpenAI,    TEXT("o4-mini"),                   C::Vision | C::Structured | C::Reasoning | C::Streaming, 0.0030f, false, 2500.f));
+		Endpoints.Add(MakeEndpoint(EGXChatProvider::Anthropic, TEXT("claude-3-5-haiku-latest"),   C::Vision, 0.0020f, true,  600.f));
+		Endpoints.Add(MakeEndpoint(EGXChatProvider::Anthropic, TEXT("claude-sonnet-4-0"),         C::Vision | C::Reasoning, 0.0090f, false, 1400.f));
+		Endpoints.Add(MakeEndpoint(EGXChatProvider::Google,    TEXT("gemini-2.5-flash-lite"),     C::Streaming, 0.0002f, true,  400.f));
+		Endpoints.Add(MakeEndpoint(EGXChatProvider::Google,    TEXT("gemini-2.5-pro"),            C::Reasoning | C::Streaming, 0.0060f, false, 2000.f));
+		Endpoints.Add(MakeEndpoint(EGXChatProvider::XAI,       TEXT("grok-3-mini"),               C::Vision | C::Reasoning | C::Streaming, 0.0004f, true, 900.f));
+		Endpoints.Add(MakeEndpoint(EGXChatProvider::DeepSeek,  TEXT("deepseek-chat"),             C::Streaming, 0.0006f, false, 900.f));
+		Endpoints.Add(MakeEndpoint(EGXChatProvider::DeepSeek,  TEXT("deepseek-reasoner"),         C::Reasoning | C::Streaming, 0.0012f, false, 3500.f));
+	}
+}
+
+UGXModelRouter* UGXModelRouter::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UGXModelRouter>() : nullptr;
+}
+
+EGXPromptClass UGXModelRouter::ClassifyPrompt(const FGXRoutingPolicy& Policy, const FString& Prompt)
+{
+	if (Policy.RequiredCapabilities & static_cast<int32>(EGXModelCapability::Reasoning))
+	{
+		return EGXPromptClass::Reasoning;
+	}
+
+	for (const TCHAR* Hint : GReasoningHints)
+	{
+		if (ContainsWord(Prompt, Hint))
+		{
+			return Prompt.Len() > Policy.ShortPromptMaxChars ? EGXPromptClass::Reasoning : EGXPromptClass::General;
+		}
+	}
+
+	const bool bHasCode = Prompt.Contains(TEXT("```"));
+	if (!bHasCode && Prompt.Len() <= Policy.ShortPromptMaxChars)
+	{
+		return EGXPromptClass::Classification;
+	}
+	return EGXPromptClass::General;
+}
+
+float UGXModelRouter::ScoreEndpoint(const FGXModelEndpoint& Endpoint) const
+{
+	const FGXEndpointHealth* Found = Health.Find(Endpoint.GetKey());
+	const float Latency = (Found && Found->TtftMs > 0.f) ? Found->TtftMs : Endpoint.PriorTtftMs;
+	const float ErrorRate = Found ? Found->GetDecayedErrorRate(FPlatformTime::Seconds(), ErrorRateHalfLifeSeconds) : 0.f;
+
+	// A failed attempt costs roughly a whole retry, so scale by the expected number of attempts.
+	return Latency / FMath::Max(0.05f, 1.f - ErrorRate);
+}
+
+bool UGXModelRouter::SelectEndpoint(const FGXRoutingPolicy& Policy, const FString& Prompt, FGXModelEndpoint& OutEndpoint) const
+{
+	return SelectEndpointExcluding(Policy, Prompt, TSet<FString>(), OutEndpoint);
+}
+
+bool UGXModelRouter::SelectEndpointExcluding(const FGXRoutingPolicy& Policy, const FString& Prompt, const TSet<FString>& Excluded, FGXModelEndpoint& OutEndpoint) const
+{
+	const EGXPromptClass PromptClass = ClassifyPrompt(Policy, Prompt);
+
+	int32 RequiredCaps = Policy.RequiredCapabilities;
+	if (PromptClass == EGXPromptClass::Reasoning)
+	{
+		RequiredCaps |= static_cast<int32>(EGXModelCapability::Reasoning);
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	auto IsOpen = [this, Now](const FGXModelEndpoint& Endpoint)
+	{
+		const FGXCircuitBreaker* Breaker = Breakers.Find(Endpoint.GetKey());
+		return Breaker && Breaker->GetState(CircuitBreakerSettings, Now) == EGXCircuitState::Open;
+	};
+
+	TArray<const FGXModelEndpoint*, TInlineAllocator<16>> Candidates;
+	for (const FGXModelEndpoint& Endpoint : Endpoints)
+	{
+		if (!Endpoint.IsValid() || Excluded.Contains(Endpoint.GetKey()) || IsOpen(Endpoint))
+		{
+			continue;
+		}
+		if (Endpoint.HasCapabilities(RequiredCaps) && (Policy.CostCeilingPer1kTokens <= 0.f || Endpoint.CostPer1kTokens <= Policy.CostCeilingPer1kTokens))
+		{
+			Candidates.Add(&Endpoint);
+		}
+	}
+
+	// A reasoning hint is only a hint: fall back to the caller's hard requirements if nothing can reason.
+	if (Candidates.Num() == 0 && RequiredCaps != Policy.RequiredCapabilities)
+	{
+		for (const FGXModelEndpoint& Endpoint : Endpoints)
+		{
+			if (Endpoint.IsValid() && !Excluded.Contains(Endpoint.GetKey()) && !IsOpen(Endpoint) && Endpoint.HasCapabilities(Policy.RequiredCapabilities)
+				&& (Policy.CostCeilingPer1kTokens <= 0.f || Endpoint.CostPer1kTokens <= Policy.CostCeilingPer1kTokens))
+			{
+				Candidates.Add(&Endpoint);
+			}
+		}
+	}
+
+	if (Candidates.Num() == 0)
+	{
+		UE_LOG(LogGXRouter, Warning, TEXT("No endpoint satisfies capabilities 0x%x within cost ceiling %.4f."), Policy.RequiredCapabilities, Policy.CostCeilingPer1kTokens);
+		return false;
+	}
+
+	const FGXModelEndpoint* Best = nullptr;
+	float BestScore = TNumericLimits<float>::Max();
+
+	auto Consider = [&](const FGXModelEndpoint* Endpoint, float Score)
+	{
+		if (Score < BestScore)
+		{
+			BestScore = Score;
+			Best = Endpoint;
+		}
+	};
+
+	switch (PromptClass)
+	{
+		case EGXPromptClass::Classification:
+			// Fastest small model; large models only if no small one qualifies.
+			for (const FGXModelEndpoint* Endpoint : Candidates)
+			{
+				Consider(Endpoint, ScoreEndpoint(*Endpoint) * (Endpoint->bIsSmallModel ? 1.f : 4.f));
+			}
+			break;
+
+		case EGXPromptClass::Reasoning:
+			// Biggest capable model that still meets the latency target, otherwise the fastest capable one.
+			for (const FGXModelEndpoint* Endpoint : Candidates)
+			{
+				const float Score = ScoreEndpoint(*Endpoint);
+				const bool bMeetsTarget = Policy.LatencyTargetMs <= 0.f || Score <= Policy.LatencyTargetMs;
+				Consider(Endpoint, (Endpoint->bIsSmallModel ? 2.f : 1.f) * (bMeetsTarget ? Score : Score * 10.f));
+			}
+			break;
+
+		case EGXPromptClass::General:
+		default:
+			// Cheapest endpoint inside the latency target; if none meets it, the fastest.
+			for (const FGXModelEndpoint* Endpoint : Candidates)
+			{
+				const float Score = ScoreEndpoint(*Endpoint);
+				const bool bMeetsTarget = Policy.LatencyTargetMs <= 0.f || Score <= Policy.LatencyTargetMs;
+				Consider(Endpoint, bMeetsTarget ? Endpoint->CostPer1kTokens : 1000.f + Score);
+			}
+			break;
+	}
+
+	OutEndpoint = *Best;
+	UE_LOG(LogGXRouter, Verbose, TEXT("Routed %s prompt to %s (score %.1f)."), *UEnum::GetValueAsString(PromptClass), *Best->GetKey(), BestScore);
+	return true;
+}
+
+void UGXModelRouter::ReportFirstToken(const FGXModelEndpoint& Endpoint, float TtftMs)
+{
+	Health.FindOrAdd(Endpoint.GetKey()).AddLatencySample(TtftMs, EwmaAlpha);
+}
+
+void UGXModelRouter::ReportOutcome(const FGXModelEndpoint& Endpoint, bool bSuccess, bool bTimedOut)
+{
+	const FString Key = Endpoint.GetKey();
+	const double Now = FPlatformTime::Seconds();
+	Health.FindOrAdd(Key).AddOutcome(bSuccess, EwmaAlpha, Now);
+	Breakers.FindOrAdd(Key).RecordOutcome(CircuitBreakerSettings, bSuccess, bTimedOut, Now);
+}
+
+bool UGXModelRouter::TryAcquireEndpoint(const FGXModelEndpoint& Endpoint)
+{
+	return Breakers.FindOrAdd(Endpoint.GetKey()).TryAcquire(CircuitBreakerSettings, FPlatformTime::Seconds());
+}
+
+EGXCircuitState UGXModelRouter::GetCircuitState(const FGXModelEndpoint& Endpoint) const
+{
+	const FGXCircuitBreaker* Breaker = Breakers.Find(Endpoint.GetKey());
+	return Breaker ? Breaker->GetState(CircuitBreakerSettings, FPlatformTime::Seconds()) : EGXCircuitState::Closed;
+}
+
+bool UGXModelRouter::TryAcquireFor(const UObject* WorldContextObject, EGXChatProvider Provider, const FString& Model)
+{
+	UGXModelRouter* Router = Get(WorldContextObject);
+	if (!Router)
+	{
+		return true;
+	}
+
+	FGXModelEndpoint Endpoint;
+	Endpoint.Provider = Provider;
+	Endpoint.Model = Model;
+	return Router->TryAcquireEndpoint(Endpoint);
+}
+
+void UGXModelRouter::ReportOutcomeFor(const UObject* WorldContextObject, EGXChatProvider Provider, const FString& Model, bool bSuccess, bool bTimedOut)
+{
+	if (UGXModelRouter* Router = Get(WorldContextObject))
+	{
+		FGXModelEndpoint Endpoint;
+		Endpoint.Provider = Provider;
+		Endpoint.Model = Model;
+		Router->ReportOutcome(Endpoint, bSuccess, bTimedOut);
+	}
+}
+
+void UGXModelRouter::RegisterEndpoint(const FGXModelEndpoint& Endpoint)
+{
+	const FString Key = Endpoint.GetKey();
+	if (FGXModelEndpoint* Existing = Endpoints.FindByPredicate([&Key](const FGXModelEndpoint& E) { return E.GetKey() == Key; }))
+	{
+		*Existing = Endpoint;
+	}
+	else
+	{
+		Endpoints.Add(Endpoint);
+	}
+}
+
+FGXEndpointHealth UGXModelRouter::GetEndpointHealth(const FGXModelEndpoint& Endpoint) const
+{
+	const FGXEndpointHealth* Found = Health.Find(Endpoint.GetKey());
+	return Found ? *Found : FGXEndpointHealth();
+}
@@ -0,0 +1,236 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXProgressiveImageRequest.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Misc/Base64.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_GENAI_MODULE
+#include "Secure/GenSecureKey.h"
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXProgressiveImage, Log, All);
+
+namespace
+{
+	const TCHAR* const GImageGenerationsUrl = TEXT("https://api.openai.com/v1/images/generations");
+
+	/** Game-thread state of one request. */
+	struct FStreamState
+	{
+		FGXProgressiveImageCallbacks Callbacks;
+		/** Bytes of the response already split into events. */
+		int32 ConsumedBytes = 0;
+		/** Bytes already searched for an event boundary, so a large event is not rescanned on every progress tick. */
+		int32 ScannedBytes = 0;
+		/** Highest partial index handed out so far; older ones arriving late are dropped. */
+		int32 LastPartialIndex = INDEX_NONE;
+		/** The "completed" event, kept back until the request finishes so it is always delivered last. */
+		FString FinalEventData;
+		bool bCompleted = false;
+	};
+
+	struct FParsedEvent
+	{
+		TArray<uint8> ImageBytes;
+		int32 PartialIndex = INDEX_NONE;
+		FString Error;
+	};
+
+	/** Worker-side: extracts the image or the error message from an event's JSON payload. */
+	FParsedEvent ParseEventData(const FString& Data)
+	{
+		FParsedEvent Parsed;
+		TSharedPtr<FJsonObject> Json;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Data), Json) || !Json.IsValid())
+		{
+			Parsed.Error = TEXT("Malformed image stream event.");
+			return Parsed;
+		}
+
+		const TSharedPtr<FJsonObject>* ErrorObject = nullptr;
+		if (Json->TryGetObjectField(TEXT("error"), ErrorObject))
+		{
+			Parsed.Error = (*ErrorObject)->GetStringField(TEXT("message"));
+			return Parsed;
+		}
+
+		FString Base64;
+		if (!Json->TryGetStringField(TEXT("b64_json"), Base64) || !FBase64::Decode(Base64, Parsed.ImageBytes))
+		{
+			Parsed.Error = TEXT("Image stream event has no image.");
+		}
+		Json->TryGetNumberField(TEXT("partial_image_index"), Parsed.PartialIndex);
+		return Parsed;
+	}
+
+	void Complete(const TSharedRef<FStreamState>& State, TArray<uint8>&& ImageBytes, const FString& Error, bool bSuccess)
+	{
+		if (State->bCompleted) return;
+		State->bCompleted = true;
+		State->Callbacks.OnComplete(MoveTemp(ImageBytes), Error, bSuccess);
+	}
+
+	/**
+	 * Splits newly received bytes into SSE events. Partial images go straight to a worker;
+	 * the completed event is kept back for OnProcessRequestComplete.
+	 */
+	void ConsumeEvents(const TSharedRef<FStreamState>& State, const TArray<uint8>& Content, bool bFlush)
+	{
+		while (State->ConsumedBytes < Content.Num())
+		{
+			// Events end with a blank line. Searching bytes keeps base64 payloads out of FString until needed.
+			int32 End = INDEX_NONE;
+			for (int32 Index = FMath::Max(State->ConsumedBytes, State->ScannedBytes - 1); Index + 1 < Content.Num(); ++Index)
+			{
+				if (Content[Index] == '\n' && Content[Index + 1] == '\n')
+				{
+					End = Index;
+					break;
+				}
+			}
+			if (End == INDEX_NONE)
+			{
+				State->ScannedBytes = Content.Num();
+				if (!bFlush) return;
+				End = Content.Num();
+			}
+
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Content.GetData() + State->ConsumedBytes), End - State->ConsumedBytes);
+			const FString Event(Converted.Length(), Converted.Get());
+			State->ConsumedBytes = FMath::Min(End + 2, Content.Num());
+
+			FString EventType;
+			FString Data;
+			TArray<FString> Lines;
+			Event.ParseIntoArrayLines(Lines);
+			for (const FString& Line : Lines)
+			{
+				if (Line.StartsWith(TEXT("event:")))
+				{
+					EventType = Line.Mid(6).TrimStart();
+				}
+				else if (Line.StartsWith(TEXT("data:")))
+				{
+					Data += Line.Mid(5).TrimStart();
+				}
+			}
+			if (Data.IsEmpty()) continue;
+
+			if (EventType == TEXT("image_generation.completed") || EventType == TEXT("error"))
+			{
+				State->FinalEventData = MoveTemp(Data);
+				continue;
+			}
+			if (EventType != TEXT("image_generation.partial_image")) continue;
+
+			TWeakPtr<FStreamState> WeakState = State;
+			Async(EAsyncExecution::ThreadPool, [WeakState, Data = MoveTemp(Data)]()
+			{
+				FParsedEvent Parsed = ParseEventData(Data);
+				AsyncTask(ENamedThreads::GameThread, [WeakState, Parsed = MoveTemp(Parsed)]() mutable
+				{
+					const TSharedPtr<FStreamState> PinnedState = WeakState.Pin();
+					if (!PinnedState.IsValid() || PinnedState->bCompleted || !Parsed.Error.IsEmpty() || Parsed.PartialIndex <= PinnedState->LastPartialIndex)
+					{
+						return;
+					}
+					PinnedState->LastPartialIndex = Parsed.PartialIndex;
+					PinnedState->Callbacks.OnPartialImage(MoveTemp(Parsed.ImageBytes), Parsed.PartialIndex);
+				});
+			});
+		}
+	}
+}
+
+FHttpRequestPtr FGXProgressiveImageRequest::Send(const FString& Prompt, const FString& Model, int32 PartialImages, const FString& Size, const FString& Quality, FGXProgressiveImageCallbacks Callbacks)
+{
+#if WITH_GENAI_MODULE
+	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::OpenAI);
+	if (ApiKey.IsEmpty())
+	{
+		UE_LOG(LogGXProgressiveImage, Warning, TEXT("No OpenAI API key is configured."));
+		return nullptr;
+	}
+
+	TSharedRef<FJsonObject> Body = MakeShared<FJsonObject>();
+	Body->SetStringField(TEXT("model"), Model);
+	Body->SetStringField(TEXT("prompt"), Prompt);
+	Body->SetStringField(TEXT("size"), Size);
+	Body->SetStringField(TEXT("quality"), Quality);
+	Body->SetBoolField(TEXT("stream"), true);
+	Body->SetNumberField(TEXT("partial_images"), FMath::Clamp(PartialImages, 1, 3));
+
+	FString BodyString;
+	FJsonSerializer::Serialize(Body, TJsonWriterFactory<>::Create(&BodyString));
+
+	FHttpRequestRef Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(GImageGenerationsUrl);
+	Request->SetVerb(TEXT("POST"));
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetHeader(TEXT("Accept"), TEXT("text/event-stream"));
+	Request->SetHeader(TEXT("Authorization"), TEXT("Bearer ") + ApiKey);
+	Request->SetContentAsString(BodyString);
+
+	TSharedRef<FStreamState> State = MakeShared<FStreamState>();
+	State->Callbacks = MoveTemp(Callbacks);
+
+	Request->OnRequestProgress().BindLambda([State](FHttpRequestPtr InRequest, int32, int32)
+	{
+		const FHttpResponsePtr Response = InRequest->GetResponse();
+		if (!Response.IsValid() || State->bCompleted) return;
+		if (State->Callbacks.OnActivity)
+		{
+			State->Callbacks.OnActivity();
+		}
+		if (EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+		{
+			ConsumeEvents(State, Response->GetContent(), false);
+		}
+	});
+
+	Request->OnProcessRequestComplete().BindLambda([State](FHttpRequestPtr InRequest, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+	{
+		if (State->bCompleted) return;
+		if (!bConnectedSuccessfully || !Response.IsValid())
+		{
+			Complete(State, TArray<uint8>(), TEXT("Connection failed."), false);
+			return;
+		}
+
+		if (!EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+		{
+			// Non-streamed error body: {"error": {"message": ...}}
+			State->FinalEventData = Response->GetContentAsString();
+		}
+		else
+		{
+			ConsumeEvents(State, Response->GetContent(), true);
+		}
+
+		if (State->FinalEventData.IsEmpty())
+		{
+			Complete(State, TArray<uint8>(), TEXT("The image stream ended without an image."), false);
+			return;
+		}
+
+		// The state is held strongly from here on: the request releases its delegates once this returns.
+		Async(EAsyncExecution::ThreadPool, [State, Data = MoveTemp(State->FinalEventData)]()
+		{
+			FParsedEvent Parsed = ParseEventData(Data);
+			AsyncTask(ENamedThreads::GameThread, [State, Parsed = MoveTemp(Parsed)]() mutable
+			{
+				const bool bSuccess = Parsed.Error.IsEmpty();
+				Complete(State, MoveTemp(Parsed.ImageBytes), Parsed.Error, bSuccess);
+			});
+		});
+	});
+
+	Request->ProcessRequest();
+	return Request;
+#else
+	return nullptr;
+#endif
+}
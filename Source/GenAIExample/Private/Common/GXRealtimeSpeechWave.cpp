@@ -0,0 +1,292 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXRealtimeSpeechWave.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXRealtimeSpeechWave, Log, All);
+
+namespace
+{
+	/** A longer pause than this between chunks is the gap between two responses, not network jitter. */
+	constexpr double GResponseGapSeconds = 1.0;
+
+	/** RFC 3550 smoothing for the jitter estimate. */
+	constexpr double GJitterGain = 1.0 / 16.0;
+
+	/** The start-up buffer covers this many times the measured jitter. */
+	constexpr double GJitterMultiple = 3.0;
+
+	/** New speech within this long of playback running dry counts as an underrun rather than a new response. */
+	constexpr float GUnderrunWindowSeconds = 0.5f;
+
+	constexpr float GTailMs = 10.f;
+	constexpr float GFadeInMs = 2.5f;
+}
+
+UGXRealtimeSpeechWave::UGXRealtimeSpeechWave(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NumChannels = 1;
+	Duration = INDEFINITELY_LOOPING_DURATION;
+	SoundGroup = SOUNDGROUP_Voice;
+	bLooping = false;
+}
+
+void UGXRealtimeSpeechWave::Initialize(int32 InSampleRate, float BufferSeconds, const FGXSpeechPlayoutSettings& InSettings,
+	FOnDrained InOnDrained, FOnInterrupted InOnInterrupted, FOnStarted InOnStarted)
+{
+	SetSampleRate(InSampleRate);
+	StreamSampleRate = InSampleRate;
+	Settings = InSettings;
+	Settings.MaxBufferMs = FMath::Max(Settings.MaxBufferMs, Settings.MinBufferMs);
+	Ring.Reserve(FMath::CeilToInt(FMath::Max(BufferSeconds, 1.f) * InSampleRate));
+	OnDrained = MoveTemp(InOnDrained);
+	OnInterrupted = MoveTemp(InOnInterrupted);
+	OnStarted = MoveTemp(InOnStarted);
+	bInterruptRequested.store(false, std::memory_order_relaxed);
+
+	LastArrivalSeconds = LastChunkSeconds = JitterSeconds = 0.0;
+	TargetSamples.store(FMath::RoundToInt(Settings.MinBufferMs * 0.001f * InSampleRate), std::memory_order_relaxed);
+	PublishedJitterMs.store(0.f, std::memory_order_relaxed);
+	Underruns.store(0, std::memory_order_relaxed);
+	ConcealedSamples.store(0, std::memory_order_relaxed);
+	Interruptions.store(0, std::memory_order_relaxed);
+	LastInterruptionLatencyMs.store(0.f, std::memory_order_relaxed);
+
+	Playout = EPlayout::Idle;
+	IdleSamples = MAX_int32;
+	BufferingSamples = FadeInPosition = ConcealPosition = ResponsePlayedSamples = 0;
+	ConcealSamples = FMath::RoundToInt(Settings.ConcealmentMs * 0.001f * InSampleRate);
+	FadeSamples = FMath::Max(1, FMath::RoundToInt(GFadeInMs * 0.001f * InSampleRate));
+	Tail.SetNumZeroed(FMath::Max(1, FMath::RoundToInt(GTailMs * 0.001f * InSampleRate)));
+}
+
+bool UGXRealtimeSpeechWave::Enqueue(const uint8* PCM, int32 NumBytes)
+{
+	const int32 NumSamples = NumBytes / sizeof(int16);
+	if (NumSamples <= 0 || StreamSampleRate <= 0)
+	{
+		return true;
+	}
+
+	// A chunk is late by however much longer it took than the previous chunk lasts; bursts count as on time.
+	const double Now = FPlatformTime::Seconds();
+	const double Gap = Now - LastArrivalSeconds;
+	if (LastArrivalSeconds > 0.0 && Gap < GResponseGapSeconds)
+	{
+		const double Lateness = FMath::Max(0.0, Gap - LastChunkSeconds);
+		JitterSeconds += (Lateness - JitterSeconds) * GJitterGain;
+
+		const double TargetMs = FMath::Clamp(JitterSeconds * GJitterMultiple * 1000.0, (double)Settings.MinBufferMs, (double)Settings.MaxBufferMs);
+		TargetSamples.store(FMath::RoundToInt(TargetMs * 0.001 * StreamSampleRate), std::memory_order_relaxed);
+		PublishedJitterMs.store(static_cast<float>(JitterSeconds * 1000.0), std::memory_order_relaxed);
+	}
+	LastArrivalSeconds = Now;
+	LastChunkSeconds = static_cast<double>(NumSamples) / StreamSampleRate;
+
+	const int32 Written = Ring.Write(reinterpret_cast<const int16*>(PCM), NumSamples);
+	if (Written < NumSamples)
+	{
+		UE_LOG(LogGXRealtimeSpeechWave, Warning, TEXT("Speech buffer full; dropped %d samples."), NumSamples - Written);
+		return false;
+	}
+	return true;
+}
+
+void UGXRealtimeSpeechWave::Interrupt(double StartSeconds)
+{
+	const double Start = StartSeconds > 0.0 ? StartSeconds : FPlatformTime::Seconds();
+
+	// Requests that land before the next callback collapse into one, measured from the earliest start.
+	if (bInterruptRequested.load(std::memory_order_acquire))
+	{
+		double Pending = InterruptStartSeconds.load(std::memory_order_relaxed);
+		while (Start < Pending && !InterruptStartSeconds.compare_exchange_weak(Pending, Start, std::memory_order_relaxed))
+		{
+		}
+	}
+	else
+	{
+		InterruptStartSeconds.store(Start, std::memory_order_relaxed);
+	}
+	bInterruptRequested.store(true, std::memory_order_release);
+}
+
+FGXSpeechPlayoutStats UGXRealtimeSpeechWave::GetStats() const
+{
+	FGXSpeechPlayoutStats Stats;
+	if (StreamSampleRate > 0)
+	{
+		const float MsPerSample = 1000.f / StreamSampleRate;
+		Stats.BufferedMs = Ring.Num() * MsPerSample;
+		Stats.TargetMs = TargetSamples.load(std::memory_order_relaxed) * MsPerSample;
+		Stats.ConcealedMs = ConcealedSamples.load(std::memory_order_relaxed) * MsPerSample;
+	}
+	Stats.JitterMs = PublishedJitterMs.load(std::memory_order_relaxed);
+	Stats.Underruns = Underruns.load(std::memory_order_relaxed);
+	Stats.Interruptions = Interruptions.load(std::memory_order_relaxed);
+	Stats.LastInterruptionLatencyMs = LastInterruptionLatencyMs.load(std::memory_order_relaxed);
+	return Stats;
+}
+
+int32 UGXRealtimeSpeechWave::OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 NumSamples)
+{
+	if (bInterruptRequested.exchange(false, std::memory_order_acquire))
+	{
+		const int32 Discarded = Ring.Skip(Ring.Num());
+		if (Playout != EPlayout::Idle || Discarded > 0)
+		{
+			// This buffer is the first one that goes silent, so the latency ends here.
+			FGXSpeechInterruption Interruption;
+			Interruption.PlayedMs = ResponsePlayedSamples * 1000.f / StreamSampleRate;
+			Interruption.DiscardedMs = Discarded * 1000.f / StreamSampleRate;
+			Interruption.LatencyMs = static_cast<float>((FPlatformTime::Seconds() - InterruptStartSeconds.load(std::memory_order_relaxed)) * 1000.0);
+
+			Interruptions.fetch_add(1, std::memory_order_relaxed);
+			LastInterruptionLatencyMs.store(Interruption.LatencyMs, std::memory_order_relaxed);
+			if (OnInterrupted)
+			{
+				OnInterrupted(Interruption);
+			}
+		}
+		Playout = EPlayout::Idle;
+		IdleSamples = MAX_int32;
+		ResponsePlayedSamples = 0;
+	}
+
+	// The engine's own buffer is only fed by QueueAudio(), which this wave does not use, so it is safe to overwrite.
+	OutAudio.SetNumUninitialized(NumSamples * sizeof(int16), false);
+	int16* Out = reinterpret_cast<int16*>(OutAudio.GetData());
+
+	int32 Written = 0;
+	while (Written < NumSamples)
+	{
+		int16* Dest = Out + Written;
+		const int32 Wanted = NumSamples - Written;
+
+		switch (Playout)
+		{
+		case EPlayout::Idle:
+			if (Ring.Num() == 0)
+			{
+				FMemory::Memzero(Dest, Wanted * sizeof(int16));
+				IdleSamples = IdleSamples > MAX_int32 - Wanted ? MAX_int32 : IdleSamples + Wanted;
+				Written = NumSamples;
+				break;
+			}
+			if (IdleSamples < GUnderrunWindowSeconds * StreamSampleRate)
+			{
+				Underruns.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				ResponsePlayedSamples = 0;
+			}
+			Playout = EPlayout::Buffering;
+			BufferingSamples = 0;
+			break;
+
+		case EPlayout::Buffering:
+		{
+			// Start once the target depth is queued, or once waiting that long, so a short reply is not held back.
+			const int32 Target = TargetSamples.load(std::memory_order_relaxed);
+			if (Ring.Num() < Target && BufferingSamples < Target)
+			{
+				const int32 Count = FMath::Min(Wanted, Target - BufferingSamples);
+				FMemory::Memzero(Dest, Count * sizeof(int16));
+				BufferingSamples += Count;
+				Written += Count;
+				break;
+			}
+			Playout = EPlayout::Playing;
+			FadeInPosition = 0;
+			if (ResponsePlayedSamples == 0 && OnStarted)
+			{
+				OnStarted();
+			}
+			break;
+		}
+
+		case EPlayout::Playing:
+		{
+			const int32 Read = Ring.Read(Dest, Wanted);
+			FadeIn(Dest, Read);
+			RememberTail(Dest, Read);
+			ResponsePlayedSamples += Read;
+			Written += Read;
+			if (Read < Wanted)
+			{
+				Playout = EPlayout::Concealing;
+				ConcealPosition = 0;
+			}
+			break;
+		}
+
+		case EPlayout::Concealing:
+		{
+			if (Ring.Num() > 0)
+			{
+				Underruns.fetch_add(1, std::memory_order_relaxed);
+				Playout = EPlayout::Playing;
+				FadeInPosition = 0;
+				break;
+			}
+
+			const int32 Count = FMath::Min(Wanted, ConcealSamples - ConcealPosition);
+			Conceal(Dest, Count);
+			Written += Count;
+			ConcealedSamples.fetch_add(Count, std::memory_order_relaxed);
+
+			if (ConcealPosition >= ConcealSamples)
+			{
+				Playout = EPlayout::Idle;
+				IdleSamples = 0;
+				if (OnDrained)
+				{
+					OnDrained();
+				}
+			}
+			break;
+		}
+		}
+	}
+
+	// Always a full buffer, so the wave keeps playing through silence rather than finishing.
+	return NumSamples;
+}
+
+void UGXRealtimeSpeechWave::FadeIn(int16* Samples, int32 Count)
+{
+	const int32 Ramp = FMath::Min(Count, FadeSamples - FadeInPosition);
+	for (int32 Index = 0; Index < Ramp; ++Index)
+	{
+		Samples[Index] = static_cast<int16>(Samples[Index] * (static_cast<float>(FadeInPosition++) / FadeSamples));
+	}
+}
+
+void UGXRealtimeSpeechWave::RememberTail(const int16* Samples, int32 Count)
+{
+	const int32 Length = Tail.Num();
+	if (Count >= Length)
+	{
+		FMemory::Memcpy(Tail.GetData(), Samples + Count - Length, Length * sizeof(int16));
+	}
+	else if (Count > 0)
+	{
+		FMemory::Memmove(Tail.GetData(), Tail.GetData() + Count, (Length - Count) * sizeof(int16));
+		FMemory::Memcpy(Tail.GetData() + Length - Count, Samples, Count * sizeof(int16));
+	}
+}
+
+void UGXRealtimeSpeechWave::Conceal(int16* Out, int32 Count)
+{
+	// Reading the tail backwards from its end and then forwards again keeps the waveform continuous at
+	// every turn, which a plain loop would not.
+	const int32 Length = Tail.Num();
+	for (int32 Index = 0; Index < Count; ++Index, ++ConcealPosition)
+	{
+		const int32 Phase = ConcealPosition % (2 * Length);
+		const int32 Source = Phase < Length ? Length - 1 - Phase : Phase - Length;
+		const float Gain = 1.f - static_cast<float>(ConcealPosition) / ConcealSamples;
+		Out[Index] = static_cast<int16>(Tail[Source] * Gain);
+	}
+}
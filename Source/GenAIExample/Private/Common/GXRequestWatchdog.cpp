@@ -0,0 +1,149 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXRequestWatchdog.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXWatchdog, Log, All);
+
+namespace
+{
+	/** Deadlines are coarse; checking ten times a second is plenty and keeps the ticker cheap. */
+	constexpr float GWatchdogTickInterval = 0.1f;
+}
+
+FGXRequestWatchdog::~FGXRequestWatchdog()
+{
+	Stop();
+}
+
+uint32 FGXRequestWatchdog::Begin()
+{
+	Stop();
+	return ++CurrentGeneration;
+}
+
+void FGXRequestWatchdog::Watch(FHttpRequestPtr InRequest, const FGXRequestTimeouts& InTimeouts, bool bInStreaming, TFunction<void(EGXTimeoutKind)> OnExpired)
+{
+	Request = InRequest;
+	CancelFunction = nullptr;
+	Timeouts = InTimeouts;
+	bStreaming = bInStreaming;
+	OnExpiredFunction = MoveTemp(OnExpired);
+	StartTicker();
+}
+
+void FGXRequestWatchdog::Watch(TFunction<void()> Cancel, const FGXRequestTimeouts& InTimeouts, bool bInStreaming, TFunction<void(EGXTimeoutKind)> OnExpired)
+{
+	Request.Reset();
+	CancelFunction = MoveTemp(Cancel);
+	Timeouts = InTimeouts;
+	bStreaming = bInStreaming;
+	OnExpiredFunction = MoveTemp(OnExpired);
+	StartTicker();
+}
+
+void FGXRequestWatchdog::StartTicker()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+
+	StartSeconds = FPlatformTime::Seconds();
+	LastActivitySeconds = StartSeconds;
+	bConnected = false;
+	bHasActivity = false;
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGXRequestWatchdog::Tick), GWatchdogTickInterval);
+}
+
+void FGXRequestWatchdog::NotifyActivity()
+{
+	LastActivitySeconds = FPlatformTime::Seconds();
+	bConnected = true;
+	bHasActivity = true;
+}
+
+void FGXRequestWatchdog::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	// Drop the references so a finished request and its callbacks are freed right away.
+	Request.Reset();
+	CancelFunction = nullptr;
+	OnExpiredFunction = nullptr;
+}
+
+bool FGXRequestWatchdog::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	if (!bConnected && Request.IsValid())
+	{
+		const FHttpResponsePtr Response = Request->GetResponse();
+		bConnected = Response.IsValid() && Response->GetResponseCode() > 0;
+	}
+
+	EGXTimeoutKind Expired = EGXTimeoutKind::None;
+	if (Timeouts.TotalSeconds > 0.f && Now - StartSeconds > Timeouts.TotalSeconds)
+	{
+		Expired = EGXTimeoutKind::Total;
+	}
+	else if (!bConnected && Timeouts.ConnectSeconds > 0.f && Now - StartSeconds > Timeouts.ConnectSeconds)
+	{
+		Expired = EGXTimeoutKind::Connect;
+	}
+	else if (bStreaming && !bHasActivity && Timeouts.FirstByteSeconds > 0.f && Now - StartSeconds > Timeouts.FirstByteSeconds)
+	{
+		Expired = EGXTimeoutKind::FirstByte;
+	}
+	else if (bStreaming && bHasActivity && Timeouts.IdleSeconds > 0.f && Now - LastActivitySeconds > Timeouts.IdleSeconds)
+	{
+		Expired = EGXTimeoutKind::Idle;
+	}
+
+	if (Expired == EGXTimeoutKind::None)
+	{
+		return true;
+	}
+
+	UE_LOG(LogGXWatchdog, Warning, TEXT("Request deadline expired: %s after %.1fs."), *DescribeTimeout(Expired), Now - StartSeconds);
+
+	// Invalidate the generation first: cancelling may call the completion delegate synchronously,
+	// and that callback must be recognised as stale.
+	++CurrentGeneration;
+
+	FHttpRequestPtr ExpiredRequest = MoveTemp(Request);
+	TFunction<void()> Cancel = MoveTemp(CancelFunction);
+	TFunction<void(EGXTimeoutKind)> OnExpired = MoveTemp(OnExpiredFunction);
+	TickerHandle.Reset();
+
+	if (ExpiredRequest.IsValid() && ExpiredRequest->GetStatus() == EHttpRequestStatus::Processing)
+	{
+		ExpiredRequest->CancelRequest();
+	}
+	if (Cancel)
+	{
+		Cancel();
+	}
+	if (OnExpired)
+	{
+		OnExpired(Expired);
+	}
+
+	// Returning false removes this ticker; the handle was already reset above.
+	return false;
+}
+
+FString FGXRequestWatchdog::DescribeTimeout(EGXTimeoutKind Kind)
+{
+	switch (Kind)
+	{
+		case EGXTimeoutKind::Connect:   return TEXT("Request timed out while connecting.");
+		case EGXTimeoutKind::FirstByte: return TEXT("Request timed out waiting for the first response.");
+		case EGXTimeoutKind::Idle:      return TEXT("Request timed out: the stream stalled.");
+		case EGXTimeoutKind::Total:     return TEXT("Request exceeded its total time limit.");
+		default:                        return FString();
+	}
+}
@@ -0,0 +1,315 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXSegmentedTranscriber.h"
+#include "Common/GXMicrophoneCapture.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXSegmentedTranscriber, Log, All);
+
+namespace
+{
+	constexpr float GTickInterval = 0.05f;
+
+	/** Pause detection frames per second (10 ms frames). */
+	constexpr int32 GFramesPerSecond = 100;
+}
+
+FGXSegmentedTranscriber::~FGXSegmentedTranscriber()
+{
+	Cancel();
+}
+
+void FGXSegmentedTranscriber::Start(FGXMicrophoneCapture& InCapture, const FGXSegmentedTranscriptionSettings& InSettings, int32 InSampleRate, FSendSegment Send)
+{
+	Cancel();
+
+	Capture = &InCapture;
+	Settings = InSettings;
+	SampleRate = InSampleRate;
+	SendFunction = MoveTemp(Send);
+
+	SegmentStart = 0;
+	ScanPosition = 0;
+	SilentFrames = 0;
+	VoicedFrames = 0;
+	QuietestFrameEnd = 0;
+	QuietestFrameEnergy = TNumericLimits<float>::Max();
+	bFinishing = false;
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGXSegmentedTranscriber::Tick), GTickInterval);
+}
+
+void FGXSegmentedTranscriber::Finish(FOnTranscriptComplete OnComplete)
+{
+	if (!Capture)
+	{
+		OnComplete(false, TEXT("Segmented transcription was not started."));
+		return;
+	}
+
+	bFinishing = true;
+	OnCompleteFunction = MoveTemp(OnComplete);
+	ScanForCuts(true);
+	SendPending();
+	CompleteIfDone();
+}
+
+void FGXSegmentedTranscriber::Cancel()
+{
+	++Generation;
+
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	for (FSegment& Segment : Segments)
+	{
+		if (Segment.Request.IsValid() && !Segment.bDone)
+		{
+			Segment.bDone = true;
+			Segment.Request->CancelRequest();
+		}
+	}
+
+	Segments.Empty();
+	Capture = nullptr;
+	SendFunction = nullptr;
+	OnCompleteFunction = nullptr;
+	bFinishing = false;
+}
+
+bool FGXSegmentedTranscriber::Tick(float DeltaTime)
+{
+	if (!bFinishing)
+	{
+		ScanForCuts(false);
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Segments.Num(); ++Index)
+	{
+		FSegment& Segment = Segments[Index];
+		if (Segment.bSent && !Segment.bDone && Now - Segment.SentSeconds > Settings.SegmentTimeoutSeconds)
+		{
+			// Mark it done before cancelling; the cancel may report back synchronously.
+			FHttpRequestPtr Request = Segment.Request;
+			OnSegmentDone(Index, Generation, false, TEXT("Segment upload timed out."));
+			if (Request.IsValid())
+			{
+				Request->CancelRequest();
+			}
+			if (!Capture) return false;
+		}
+	}
+
+	SendPending();
+	return true;
+}
+
+void FGXSegmentedTranscriber::ScanForCuts(bool bFinal)
+{
+	const int32 DeviceRate = Capture->GetSampleRate();
+	const int32 Available = Capture->GetNumSamples();
+	const float* Samples = Capture->GetSamples();
+	if (DeviceRate <= 0) return;
+
+	const int32 FrameSamples = FMath::Max(1, DeviceRate / GFramesPerSecond);
+	const int32 MinSamples = FMath::CeilToInt(Settings.MinSegmentSeconds * DeviceRate);
+	const int32 MaxSamples = FMath::Max(MinSamples, FMath::CeilToInt(Settings.MaxSegmentSeconds * DeviceRate));
+	const int32 PauseFrames = FMath::Max(1, FMath::CeilToInt(Settings.SilenceSeconds * GFramesPerSecond));
+	const float Threshold = FMath::Square(FMath::Pow(10.f, Settings.SilenceThresholdDb / 20.f));
+
+	while (ScanPosition + FrameSamples <= Available)
+	{
+		float Energy = 0.f;
+		for (const float* Sample = Samples + ScanPosition, *End = Sample + FrameSamples; Sample < End; ++Sample)
+		{
+			Energy += *Sample * *Sample;
+		}
+		Energy /= FrameSamples;
+		ScanPosition += FrameSamples;
+
+		if (Energy < Threshold)
+		{
+			++SilentFrames;
+		}
+		else
+		{
+			SilentFrames = 0;
+			++VoicedFrames;
+		}
+
+		const int32 Length = ScanPosition - SegmentStart;
+		if (Length < MinSamples) continue;
+
+		if (Energy <= QuietestFrameEnergy)
+		{
+			QuietestFrameEnergy = Energy;
+			QuietestFrameEnd = ScanPosition - FrameSamples / 2;
+		}
+
+		if (SilentFrames >= PauseFrames)
+		{
+			// Cut in the middle of the pause so neither side clips a word.
+			AddSegment(ScanPosition - SilentFrames * FrameSamples / 2);
+		}
+		else if (Length >= MaxSamples)
+		{
+			AddSegment(QuietestFrameEnd > SegmentStart ? QuietestFrameEnd : ScanPosition);
+		}
+	}
+
+	if (bFinal && Available > SegmentStart)
+	{
+		if (ScanPosition < Available)
+		{
+			++VoicedFrames; // The partial last frame is not scanned; keep the tail rather than risk dropping a word.
+		}
+		AddSegment(Available);
+	}
+}
+
+void FGXSegmentedTranscriber::AddSegment(int32 EndSample)
+{
+	FSegment& Segment = Segments.AddDefaulted_GetRef();
+	Segment.FirstSample = SegmentStart;
+	Segment.NumSamples = EndSample - SegmentStart;
+
+	// All-silence segments are not sent: transcription models tend to invent words for them.
+	if (VoicedFrames == 0)
+	{
+		Segment.bSent = true;
+		Segment.bDone = true;
+		Segment.bSuccess = true;
+	}
+
+	SegmentStart = EndSample;
+	SilentFrames = 0;
+	VoicedFrames = 0;
+	QuietestFrameEnd = 0;
+	QuietestFrameEnergy = TNumericLimits<float>::Max();
+}
+
+void FGXSegmentedTranscriber::SendPending()
+{
+	int32 InFlight = 0;
+	for (const FSegment& Segment : Segments)
+	{
+		InFlight += Segment.bSent && !Segment.bDone;
+	}
+
+	for (int32 Index = 0; Index < Segments.Num() && InFlight < Settings.MaxConcurrentUploads; ++Index)
+	{
+		if (Segments[Index].bSent) continue;
+
+		TArray<uint8> WavData;
+		FGXMicrophoneCapture::EncodeWav(Capture->GetSamples() + Segments[Index].FirstSample, Segments[Index].NumSamples, Capture->GetSampleRate(), SampleRate, WavData);
+
+		const FString Prompt = StitchedPrefix().Right(Settings.PromptCharacters);
+
+		Segments[Index].bSent = true;
+		Segments[Index].SentSeconds = FPlatformTime::Seconds();
+		++InFlight;
+
+		UE_LOG(LogGXSegmentedTranscriber, Verbose, TEXT("Sending segment %d: %.2f s"), Index, static_cast<float>(Segments[Index].NumSamples) / Capture->GetSampleRate());
+
+		const uint32 RequestGeneration = Generation;
+		FHttpRequestPtr Request = SendFunction(MoveTemp(WavData), Prompt, [this, Index, RequestGeneration](bool bSuccess, const FString& TextOrError)
+		{
+			OnSegmentDone(Index, RequestGeneration, bSuccess, TextOrError);
+		});
+
+		// The send may have failed, or even completed, synchronously; the array may have been emptied by then.
+		if (RequestGeneration != Generation) return;
+		if (!Segments[Index].bDone)
+		{
+			if (Request.IsValid())
+			{
+				Segments[Index].Request = Request;
+			}
+			else
+			{
+				OnSegmentDone(Index, Generation, false, TEXT("The segment could not be sent."));
+				return;
+			}
+		}
+	}
+}
+
+void FGXSegmentedTranscriber::OnSegmentDone(int32 Index, uint32 RequestGeneration, bool bSuccess, const FString& TextOrError)
+{
+	if (RequestGeneration != Generation || !Segments.IsValidIndex(Index) || Segments[Index].bDone) return;
+
+	FSegment& Segment = Segments[Index];
+	Segment.bDone = true;
+	Segment.bSuccess = bSuccess;
+	Segment.Text = TextOrError.TrimStartAndEnd();
+	Segment.Request.Reset();
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogGXSegmentedTranscriber, Warning, TEXT("Segment %d failed: %s"), Index, *Segment.Text);
+	}
+
+	SendPending();
+	if (RequestGeneration != Generation) return;
+	CompleteIfDone();
+}
+
+void FGXSegmentedTranscriber::CompleteIfDone()
+{
+	// A segment that completed inside Finish() may already have delivered the transcript.
+	if (!bFinishing || !Capture || !OnCompleteFunction) return;
+
+	for (const FSegment& Segment : Segments)
+	{
+		if (!Segment.bDone) return;
+	}
+
+	FString Transcript;
+	FString FirstError;
+	for (const FSegment& Segment : Segments)
+	{
+		if (!Segment.bSuccess)
+		{
+			if (FirstError.IsEmpty()) FirstError = Segment.Text;
+		}
+		else if (!Segment.Text.IsEmpty())
+		{
+			Transcript += Transcript.IsEmpty() ? Segment.Text : TEXT(" ") + Segment.Text;
+		}
+	}
+
+	UE_LOG(LogGXSegmentedTranscriber, Log, TEXT("Transcribed %d segment(s)."), Segments.Num());
+
+	FOnTranscriptComplete OnComplete = MoveTemp(OnCompleteFunction);
+	Cancel();
+
+	if (!FirstError.IsEmpty())
+	{
+		OnComplete(false, FirstError);
+	}
+	else if (Transcript.IsEmpty())
+	{
+		OnComplete(false, TEXT("No speech was recorded."));
+	}
+	else
+	{
+		OnComplete(true, Transcript);
+	}
+}
+
+FString FGXSegmentedTranscriber::StitchedPrefix() const
+{
+	FString Prefix;
+	for (const FSegment& Segment : Segments)
+	{
+		if (!Segment.bDone) break;
+		if (Segment.bSuccess && !Segment.Text.IsEmpty())
+		{
+			Prefix += Prefix.IsEmpty() ? Segment.Text : TEXT(" ") + Segment.Text;
+		}
+	}
+	return Prefix;
+}
@@ -0,0 +1,302 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXTextureDecoder.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "Engine/Texture2DArray.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "RenderingThread.h"
+#include "UObject/StrongObjectPtr.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXTextureDecoder, Log, All);
+
+namespace
+{
+	struct FDecodedImage
+	{
+		TArray64<uint8> Pixels;
+		int32 Width = 0;
+		int32 Height = 0;
+		float DecodeMs = 0.f;
+		/** Set instead of Pixels when the image was block compressed on the worker. */
+		FGXCompressedImage Compressed;
+		FString Error;
+	};
+
+	/** Keeps the texture alive and the fence pending until the render thread has caught up. */
+	struct FPendingUpload
+	{
+		TStrongObjectPtr<UTexture> Texture;
+		FRenderCommandFence Fence;
+		TFunction<void(UTexture*)> OnReady;
+	};
+
+	float MillisecondsSince(double StartSeconds)
+	{
+		return static_cast<float>((FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	}
+
+	/** Decodes on a pool thread and calls OnDecoded with the result on the game thread. */
+	void DecodeWithTiming(TArray<uint8> EncodedBytes, TFunction<void(FDecodedImage&)> OnDecoded, FGXOnPixelsReady OnWorkerPixels = nullptr,
+		const FGXTextureCompressionSettings& Compression = FGXTextureCompressionSettings())
+	{
+		check(IsInGameThread());
+
+		// Module loading is game-thread only; the wrappers themselves are safe to use on a worker.
+		IImageWrapperModule* ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+		Async(EAsyncExecution::ThreadPool, [ImageWrapperModule, EncodedBytes = MoveTemp(EncodedBytes), OnDecoded = MoveTemp(OnDecoded), OnWorkerPixels = MoveTemp(OnWorkerPixels), Compression]() mutable
+		{
+			const double DecodeStartSeconds = FPlatformTime::Seconds();
+			TSharedPtr<FDecodedImage, ESPMode::ThreadSafe> Decoded = MakeShared<FDecodedImage, ESPMode::ThreadSafe>();
+
+			const EImageFormat Format = ImageWrapperModule->DetectImageFormat(EncodedBytes.GetData(), EncodedBytes.Num());
+			TSharedPtr<IImageWrapper> ImageWrapper = Format != EImageFormat::Invalid ? ImageWrapperModule->CreateImageWrapper(Format) : nullptr;
+			if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(EncodedBytes.GetData(), EncodedBytes.Num()))
+			{
+				Decoded->Error = TEXT("Unrecognised image data.");
+			}
+			else if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, Decoded->Pixels))
+			{
+				Decoded->Error = TEXT("Failed to decode image data.");
+			}
+			else
+			{
+				Decoded->Width = static_cast<int32>(ImageWrapper->GetWidth());
+				Decoded->Height = static_cast<int32>(ImageWrapper->GetHeight());
+			}
+			Decoded->DecodeMs = MillisecondsSince(DecodeStartSeconds);
+
+			if (OnWorkerPixels && Decoded->Error.IsEmpty())
+			{
+				OnWorkerPixels(Decoded->Pixels, Decoded->Width, Decoded->Height);
+			}
+
+			if (Compression.Compression != EGXTextureCompression::None && Decoded->Error.IsEmpty()
+				&& !FGXBlockCompressor::Compress(MoveTemp(Decoded->Pixels), Decoded->Width, Decoded->Height, Compression, Decoded->Compressed))
+			{
+				UE_LOG(LogGXTextureDecoder, Log, TEXT("%dx%d image is not a whole number of 4x4 blocks; leaving it uncompressed."), Decoded->Width, Decoded->Height);
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [Decoded, OnDecoded = MoveTemp(OnDecoded)]()
+			{
+				OnDecoded(*Decoded);
+			});
+		});
+	}
+
+	/** Copies tightly packed pixels into mip 0 of a freshly created transient texture. */
+	void FillFirstMip(FTexturePlatformData* PlatformData, const TArray64<uint8>& Pixels)
+	{
+		FTexture2DMipMap& Mip = PlatformData->Mips[0];
+		void* MipData = Mip.BulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(MipData, Pixels.GetData(), Pixels.Num());
+		Mip.BulkData.Unlock();
+	}
+}
+
+void FGXTextureDecoder::DecodeAsync(TArray<uint8> EncodedBytes, FGXOnTextureDecoded OnComplete, FGXOnPixelsReady OnWorkerPixels, FGXTextureFactory TextureFactory,
+	const FGXTextureCompressionSettings& Compression)
+{
+	const double StartSeconds = FPlatformTime::Seconds();
+	DecodeWithTiming(MoveTemp(EncodedBytes), [OnComplete = MoveTemp(OnComplete), TextureFactory = MoveTemp(TextureFactory), StartSeconds](FDecodedImage& Decoded) mutable
+	{
+		FGXTextureDecodeTiming Timing;
+		Timing.DecodeMs = Decoded.DecodeMs;
+		Timing.Width = Decoded.Width;
+		Timing.Height = Decoded.Height;
+		Timing.CompressMs = Decoded.Compressed.CompressMs;
+
+		UTexture2D* Texture = nullptr;
+		if (Decoded.Error.IsEmpty() && Decoded.Compressed.Format != PF_Unknown)
+		{
+			Timing.TextureBytes = Decoded.Compressed.GetSizeBytes();
+			Texture = CreateTextureFromMips(Decoded.Compressed.Format, Decoded.Width, Decoded.Height, Decoded.Compressed.Mips, &Timing.GameThreadMs);
+		}
+		else if (Decoded.Error.IsEmpty() && TextureFactory)
+		{
+			const double FactoryStartSeconds = FPlatformTime::Seconds();
+			Texture = TextureFactory(MoveTemp(Decoded.Pixels), Decoded.Width, Decoded.Height);
+			Timing.GameThreadMs = MillisecondsSince(FactoryStartSeconds);
+		}
+		else if (Decoded.Error.IsEmpty())
+		{
+			Texture = CreateTexture(Decoded.Pixels, Decoded.Width, Decoded.Height, &Timing.GameThreadMs);
+		}
+
+		if (Timing.TextureBytes == 0)
+		{
+			Timing.TextureBytes = static_cast<int64>(Decoded.Width) * Decoded.Height * 4;
+		}
+
+		if (!Texture)
+		{
+			Timing.TotalMs = MillisecondsSince(StartSeconds);
+			OnComplete(nullptr, Decoded.Error.IsEmpty() ? TEXT("Failed to create texture.") : Decoded.Error, Timing);
+			return;
+		}
+
+		// The decoded copy is no longer needed; free it before waiting on the render thread.
+		Decoded.Pixels.Empty();
+		WhenRenderResourceReady(Texture, [OnComplete = MoveTemp(OnComplete), Timing, StartSeconds](UTexture* ReadyTexture) mutable
+		{
+			Timing.TotalMs = MillisecondsSince(StartSeconds);
+			UE_LOG(LogGXTextureDecoder, Verbose, TEXT("Decoded %dx%d image: decode %.1f ms, compress %.1f ms, game thread %.2f ms, total %.1f ms, %lld KB resident"),
+				Timing.Width, Timing.Height, Timing.DecodeMs, Timing.CompressMs, Timing.GameThreadMs, Timing.TotalMs, Timing.TextureBytes / 1024);
+			OnComplete(Cast<UTexture2D>(ReadyTexture), FString(), Timing);
+		});
+	}, MoveTemp(OnWorkerPixels), Compression);
+}
+
+void FGXTextureDecoder::DecodePixelsAsync(TArray<uint8> EncodedBytes, FGXOnPixelsDecoded OnComplete)
+{
+	DecodeWithTiming(MoveTemp(EncodedBytes), [OnComplete = MoveTemp(OnComplete)](FDecodedImage& Decoded)
+	{
+		OnComplete(MoveTemp(Decoded.Pixels), Decoded.Width, Decoded.Height, Decoded.Error);
+	});
+}
+
+UTexture2D* FGXTextureDecoder::CreateTexture(const TArray64<uint8>& Pixels, int32 Width, int32 Height, float* OutGameThreadMs)
+{
+	check(IsInGameThread());
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	if (Width <= 0 || Height <= 0 || Pixels.Num() != static_cast<int64>(Width) * Height * 4)
+	{
+		return nullptr;
+	}
+
+	UTexture2D* Texture = UTexture2D::CreateTransient(Width, Height, PF_B8G8R8A8);
+	if (!Texture)
+	{
+		return nullptr;
+	}
+
+	FillFirstMip(Texture->GetPlatformData(), Pixels);
+
+	// Creating the RHI texture and uploading the mip happen on the render thread.
+	Texture->UpdateResource();
+
+	if (OutGameThreadMs)
+	{
+		*OutGameThreadMs = MillisecondsSince(StartSeconds);
+	}
+	return Texture;
+}
+
+bool FGXTextureDecoder::UpdateTexture(UTexture2D* Texture, TArray64<uint8>&& Pixels, int32 Width, int32 Height)
+{
+	check(IsInGameThread());
+
+	FTexturePlatformData* PlatformData = Texture ? Texture->GetPlatformData() : nullptr;
+	if (!PlatformData || PlatformData->PixelFormat != PF_B8G8R8A8 || PlatformData->Mips.Num() != 1
+		|| PlatformData->SizeX != Width || PlatformData->SizeY != Height || Pixels.Num() != static_cast<int64>(Width) * Height * 4)
+	{
+		return false;
+	}
+
+	// Keep the CPU copy current for readers such as FGXTextureEncoder; the GPU copy is updated from a
+	// separate buffer because the render thread reads it after this returns.
+	FillFirstMip(PlatformData, Pixels);
+
+	TArray64<uint8>* Upload = new TArray64<uint8>(MoveTemp(Pixels));
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, Width, Height);
+	Texture->UpdateTextureRegions(0, 1, Region, Width * 4, 4, Upload->GetData(), [Upload, Region](uint8*, const FUpdateTextureRegion2D*)
+	{
+		delete Upload;
+		delete Region;
+	});
+	return true;
+}
+
+UTexture2DArray* FGXTextureDecoder::CreateTextureArray(const TArray64<uint8>& Pixels, int32 Width, int32 Height, int32 SliceCount, float* OutGameThreadMs)
+{
+	check(IsInGameThread());
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	if (Width <= 0 || Height <= 0 || SliceCount <= 0 || Pixels.Num() != static_cast<int64>(Width) * Height * 4 * SliceCount)
+	{
+		return nullptr;
+	}
+
+	UTexture2DArray* Texture = UTexture2DArray::CreateTransient(Width, Height, SliceCount, PF_B8G8R8A8);
+	if (!Texture)
+	{
+		return nullptr;
+	}
+
+	// Slices are stored back to back in the mip, so all of them go up in a single upload.
+	FillFirstMip(Texture->GetPlatformData(), Pixels);
+	Texture->UpdateResource();
+
+	if (OutGameThreadMs)
+	{
+		*OutGameThreadMs = MillisecondsSince(StartSeconds);
+	}
+	return Texture;
+}
+
+UTexture2D* FGXTextureDecoder::CreateTextureFromMips(EPixelFormat Format, int32 Width, int32 Height, TArray<TArray64<uint8>>& Mips, float* OutGameThreadMs)
+{
+	check(IsInGameThread());
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	if (Width <= 0 || Height <= 0 || Mips.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	FTexturePlatformData* PlatformData = new FTexturePlatformData();
+	PlatformData->SizeX = Width;
+	PlatformData->SizeY = Height;
+	PlatformData->PixelFormat = Format;
+	PlatformData->SetNumSlices(1);
+
+	for (int32 Level = 0; Level < Mips.Num(); ++Level)
+	{
+		FTexture2DMipMap* Mip = new FTexture2DMipMap();
+		Mip->SizeX = FMath::Max(1, Width >> Level);
+		Mip->SizeY = FMath::Max(1, Height >> Level);
+		Mip->SizeZ = 1;
+		PlatformData->Mips.Add(Mip);
+
+		Mip->BulkData.Lock(LOCK_READ_WRITE);
+		void* MipData = Mip->BulkData.Realloc(Mips[Level].Num());
+		FMemory::Memcpy(MipData, Mips[Level].GetData(), Mips[Level].Num());
+		Mip->BulkData.Unlock();
+		Mips[Level].Empty();
+	}
+
+	UTexture2D* Texture = NewObject<UTexture2D>(GetTransientPackage(), NAME_None, RF_Transient);
+	Texture->SetPlatformData(PlatformData);
+	// Runtime textures have no streamable bulk data; all the mips handed in are resident.
+	Texture->NeverStream = true;
+	Texture->UpdateResource();
+
+	if (OutGameThreadMs)
+	{
+		*OutGameThreadMs = MillisecondsSince(StartSeconds);
+	}
+	return Texture;
+}
+
+void FGXTextureDecoder::WhenRenderResourceReady(UTexture* Texture, TFunction<void(UTexture*)> OnReady)
+{
+	check(IsInGameThread());
+
+	TSharedRef<FPendingUpload> Pending = MakeShared<FPendingUpload>();
+	Pending->Texture.Reset(Texture);
+	Pending->OnReady = MoveTemp(OnReady);
+	Pending->Fence.BeginFence();
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Pending](float)
+	{
+		if (!Pending->Fence.IsFenceComplete())
+		{
+			return true;
+		}
+		Pending->OnReady(Pending->Texture.Get());
+		return false;
+	}));
+}
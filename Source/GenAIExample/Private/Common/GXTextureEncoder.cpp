@@ -0,0 +1,411 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXTextureEncoder.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "Engine/Canvas.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Kismet/KismetRenderingLibrary.h"
+#include "Misc/ScopeLock.h"
+#include "RenderingThread.h"
+#include "RHIGPUReadback.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/StrongObjectPtr.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXTextureEncoder, Log, All);
+
+namespace
+{
+	/** zlib level for uploads. The server decodes the image once, so size matters far less than encode time. */
+	constexpr int32 GUploadPngCompression = 1;
+
+	/** Iterative editing touches a handful of images; a few full-size PNGs is all the cache ever needs. */
+	constexpr int32 GMaxCachedEncodes = 8;
+
+	/** A readback normally lands within a few frames; past this the GPU is taken to have lost it. */
+	constexpr double GReadbackTimeoutSeconds = 5.0;
+
+	struct FRawImage
+	{
+		TArray64<uint8> Pixels;
+		int32 Width = 0;
+		int32 Height = 0;
+		ERGBFormat Format = ERGBFormat::BGRA;
+		int32 BitDepth = 8;
+	};
+
+	/** Runs on a worker thread. Image.Pixels is empty if the texture could not be read. */
+	using FOnImageRead = TFunction<void(FRawImage& Image)>;
+
+	/**
+	 * One render-target readback in flight, shared by the game thread's poll and the render thread, which owns the
+	 * readback. Whichever side claims it first, the finished copy or the timeout, calls OnRead.
+	 */
+	struct FPendingReadback
+	{
+		TUniquePtr<FRHIGPUTextureReadback> Readback;
+		FOnImageRead OnRead;
+		int32 Width = 0;
+		int32 Height = 0;
+		double DeadlineSeconds = 0.0;
+		std::atomic<bool> bClaimed{ false };
+		std::atomic<bool> bPollQueued{ false };
+	};
+
+	struct FCachedEncode
+	{
+		FObjectKey Texture;
+		uint64 PixelHash = 0;
+		TArray<uint8> PNG;
+	};
+
+	/** Most recently used last. Accessed from the workers, hence the lock. */
+	FCriticalSection GCacheLock;
+	TArray<FCachedEncode> GCache;
+
+	bool ReadPlatformMip(UTexture2D* Texture, FRawImage& OutImage)
+	{
+		const FTexturePlatformData* PlatformData = Texture->GetPlatformData();
+		if (!PlatformData || PlatformData->Mips.Num() == 0)
+		{
+			return false;
+		}
+
+		switch (PlatformData->PixelFormat)
+		{
+		case PF_B8G8R8A8: OutImage.Format = ERGBFormat::BGRA; break;
+		case PF_R8G8B8A8: OutImage.Format = ERGBFormat::RGBA; break;
+		case PF_G8:       OutImage.Format = ERGBFormat::Gray; break;
+		default:          return false;
+		}
+
+		// Cooked textures usually drop their CPU copy after upload; only transient ones keep it.
+		FTexture2DMipMap& Mip = const_cast<FTexture2DMipMap&>(PlatformData->Mips[0]);
+		if (!Mip.BulkData.IsBulkDataLoaded() || Mip.BulkData.GetBulkDataSize() <= 0)
+		{
+			return false;
+		}
+
+		const void* Data = Mip.BulkData.LockReadOnly();
+		OutImage.Pixels.SetNumUninitialized(Mip.BulkData.GetBulkDataSize());
+		FMemory::Memcpy(OutImage.Pixels.GetData(), Data, OutImage.Pixels.Num());
+		Mip.BulkData.Unlock();
+
+		OutImage.Width = Mip.SizeX;
+		OutImage.Height = Mip.SizeY;
+		OutImage.BitDepth = 8;
+		return true;
+	}
+
+	bool ReadSourceData(UTexture2D* Texture, FRawImage& OutImage)
+	{
+#if WITH_EDITORONLY_DATA
+		if (!Texture->Source.IsValid())
+		{
+			return false;
+		}
+
+		switch (Texture->Source.GetFormat())
+		{
+		case TSF_G8:     OutImage.Format = ERGBFormat::Gray; OutImage.BitDepth = 8;  break;
+		case TSF_G16:    OutImage.Format = ERGBFormat::Gray; OutImage.BitDepth = 16; break;
+		case TSF_BGRA8:  OutImage.Format = ERGBFormat::BGRA; OutImage.BitDepth = 8;  break;
+		case TSF_RGBA16: OutImage.Format = ERGBFormat::RGBA; OutImage.BitDepth = 16; break;
+		default:         return false;
+		}
+
+		OutImage.Width = Texture->Source.GetSizeX();
+		OutImage.Height = Texture->Source.GetSizeY();
+		return Texture->Source.GetMipData(OutImage.Pixels, 0, 0, 0);
+#else
+		return false;
+#endif
+	}
+
+	void CompleteOnWorker(TSharedPtr<FRawImage, ESPMode::ThreadSafe> Image, FOnImageRead OnRead)
+	{
+		Async(EAsyncExecution::ThreadPool, [Image, OnRead = MoveTemp(OnRead)]()
+		{
+			OnRead(*Image);
+		});
+	}
+
+	/** Render thread: copies a finished readback out row by row, then hands it to a worker. */
+	void PollReadback(const TSharedRef<FPendingReadback, ESPMode::ThreadSafe>& Pending)
+	{
+		Pending->bPollQueued = false;
+		if (Pending->bClaimed.load() || !Pending->Readback->IsReady() || Pending->bClaimed.exchange(true))
+		{
+			return;
+		}
+
+		TSharedPtr<FRawImage, ESPMode::ThreadSafe> Image = MakeShared<FRawImage, ESPMode::ThreadSafe>();
+		const int64 RowBytes = static_cast<int64>(Pending->Width) * 4;
+		int32 RowPitchInPixels = 0;
+		if (const uint8* Data = static_cast<const uint8*>(Pending->Readback->Lock(RowPitchInPixels)))
+		{
+			Image->Pixels.SetNumUninitialized(RowBytes * Pending->Height);
+			for (int32 Row = 0; Row < Pending->Height; ++Row)
+			{
+				FMemory::Memcpy(Image->Pixels.GetData() + Row * RowBytes, Data + static_cast<int64>(Row) * RowPitchInPixels * 4, RowBytes);
+			}
+			Pending->Readback->Unlock();
+		}
+		Image->Width = Pending->Width;
+		Image->Height = Pending->Height;
+		Image->Format = ERGBFormat::RGBA;
+		Image->BitDepth = 8;
+		CompleteOnWorker(Image, MoveTemp(Pending->OnRead));
+	}
+
+	/** Game thread: draws the texture into an RGBA8 render target and queues a readback of it. */
+	bool ReadThroughRenderTarget(UObject* WorldContextObject, UTexture2D* Texture, FOnImageRead& OnRead)
+	{
+		const int32 Width = Texture->GetSizeX();
+		const int32 Height = Texture->GetSizeY();
+		if (!WorldContextObject || Width <= 0 || Height <= 0)
+		{
+			return false;
+		}
+
+		UTextureRenderTarget2D* RenderTarget = UKismetRenderingLibrary::CreateRenderTarget2D(WorldContextObject, Width, Height, RTF_RGBA8_SRGB, FLinearColor::Transparent);
+		FTextureRenderTargetResource* Resource = RenderTarget ? RenderTarget->GameThread_GetRenderTargetResource() : nullptr;
+		if (!Resource)
+		{
+			return false;
+		}
+
+		UCanvas* Canvas = nullptr;
+		FVector2D CanvasSize;
+		FDrawToRenderTargetContext Context;
+		UKismetRenderingLibrary::BeginDrawCanvasToRenderTarget(WorldContextObject, RenderTarget, Canvas, CanvasSize, Context);
+		if (Canvas)
+		{
+			Canvas->K2_DrawTexture(Texture, FVector2D::ZeroVector, CanvasSize, FVector2D::ZeroVector, FVector2D::UnitVector, FLinearColor::White, BLEND_Opaque);
+		}
+		UKismetRenderingLibrary::EndDrawCanvasToRenderTarget(WorldContextObject, Context);
+
+		TSharedRef<FPendingReadback, ESPMode::ThreadSafe> Pending = MakeShared<FPendingReadback, ESPMode::ThreadSafe>();
+		Pending->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("GXTextureEncoderReadback"));
+		Pending->OnRead = MoveTemp(OnRead);
+		Pending->Width = Width;
+		Pending->Height = Height;
+		Pending->DeadlineSeconds = FPlatformTime::Seconds() + GReadbackTimeoutSeconds;
+
+		// Queued behind the canvas draw; the copy lands in a staging buffer the render thread maps once the GPU is done.
+		ENQUEUE_RENDER_COMMAND(GXEnqueueTextureReadback)([Pending, Resource](FRHICommandListImmediate& RHICmdList)
+		{
+			Pending->Readback->EnqueueCopy(RHICmdList, Resource->GetRenderTargetTexture());
+		});
+
+		// The render target is held by the poll alone, so it is released on the game thread.
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Pending, RenderTarget = TStrongObjectPtr<UTextureRenderTarget2D>(RenderTarget)](float) mutable
+		{
+			if (!Pending->bClaimed.load() && FPlatformTime::Seconds() > Pending->DeadlineSeconds && !Pending->bClaimed.exchange(true))
+			{
+				UE_LOG(LogGXTextureEncoder, Warning, TEXT("GPU readback of a %dx%d texture timed out."), Pending->Width, Pending->Height);
+				CompleteOnWorker(MakeShared<FRawImage, ESPMode::ThreadSafe>(), MoveTemp(Pending->OnRead));
+			}
+
+			if (!Pending->bClaimed.load())
+			{
+				if (!Pending->bPollQueued.exchange(true))
+				{
+					ENQUEUE_RENDER_COMMAND(GXPollTextureReadback)([Pending](FRHICommandListImmediate&)
+					{
+						PollReadback(Pending);
+					});
+				}
+				return true;
+			}
+
+			// The readback is destroyed where it was used; the render target goes once nothing reads it.
+			ENQUEUE_RENDER_COMMAND(GXReleaseTextureReadback)([Pending](FRHICommandListImmediate&)
+			{
+				Pending->Readback.Reset();
+			});
+			UKismetRenderingLibrary::ReleaseRenderTarget2D(RenderTarget.Get());
+			RenderTarget.Reset();
+			return false;
+		}));
+		return true;
+	}
+
+	/**
+	 * Game thread: reads the pixels from the first source that has them and passes them to OnRead on a worker.
+	 * Calls OnRead with no pixels if none can.
+	 */
+	void ReadImageAsync(UObject* WorldContextObject, UTexture2D* Texture, FOnImageRead OnRead)
+	{
+		check(IsInGameThread());
+
+		TSharedPtr<FRawImage, ESPMode::ThreadSafe> Image = MakeShared<FRawImage, ESPMode::ThreadSafe>();
+		if (Texture && (ReadPlatformMip(Texture, *Image) || ReadSourceData(Texture, *Image)))
+		{
+			CompleteOnWorker(Image, MoveTemp(OnRead));
+			return;
+		}
+		if (Texture && ReadThroughRenderTarget(WorldContextObject, Texture, OnRead))
+		{
+			return;
+		}
+		CompleteOnWorker(MakeShared<FRawImage, ESPMode::ThreadSafe>(), MoveTemp(OnRead));
+	}
+
+	/** Any thread. Converts Image to BGRA8 in place of OutPixels; 16-bit and gray images are narrowed and expanded. */
+	bool ConvertToBGRA8(FRawImage& Image, TArray64<uint8>& OutPixels)
+	{
+		const int32 Channels = Image.Format == ERGBFormat::Gray ? 1 : 4;
+		const int32 BytesPerChannel = Image.BitDepth / 8;
+		const int64 PixelCount = static_cast<int64>(Image.Width) * Image.Height;
+		if (PixelCount <= 0 || Image.Pixels.Num() != PixelCount * Channels * BytesPerChannel)
+		{
+			return false;
+		}
+
+		if (Image.Format == ERGBFormat::BGRA && Image.BitDepth == 8)
+		{
+			OutPixels = MoveTemp(Image.Pixels);
+			return true;
+		}
+
+		// 16-bit channels are little endian; their high byte is the 8-bit value.
+		const uint8* Source = Image.Pixels.GetData() + BytesPerChannel - 1;
+		OutPixels.SetNumUninitialized(PixelCount * 4);
+		for (int64 Index = 0; Index < PixelCount; ++Index)
+		{
+			const uint8* Pixel = Source + Index * Channels * BytesPerChannel;
+			uint8* Out = &OutPixels[Index * 4];
+			if (Channels == 1)
+			{
+				Out[0] = Out[1] = Out[2] = Pixel[0];
+				Out[3] = 255;
+			}
+			else
+			{
+				Out[0] = Pixel[2 * BytesPerChannel];
+				Out[1] = Pixel[1 * BytesPerChannel];
+				Out[2] = Pixel[0];
+				Out[3] = Pixel[3 * BytesPerChannel];
+			}
+		}
+		return true;
+	}
+
+	bool FindCached(const FObjectKey& Key, uint64 PixelHash, TArray<uint8>& OutPNG)
+	{
+		FScopeLock Lock(&GCacheLock);
+		const int32 Index = GCache.IndexOfByPredicate([&Key](const FCachedEncode& Entry) { return Entry.Texture == Key; });
+		if (Index == INDEX_NONE || GCache[Index].PixelHash != PixelHash)
+		{
+			return false;
+		}
+
+		FCachedEncode Entry = MoveTemp(GCache[Index]);
+		GCache.RemoveAt(Index, 1, false);
+		OutPNG = Entry.PNG;
+		GCache.Add(MoveTemp(Entry));
+		return true;
+	}
+
+	void StoreCached(const FObjectKey& Key, uint64 PixelHash, const TArray<uint8>& PNG)
+	{
+		FScopeLock Lock(&GCacheLock);
+		// One entry per texture: a new revision replaces the old one.
+		GCache.RemoveAll([&Key](const FCachedEncode& Entry) { return Entry.Texture == Key; });
+		if (GCache.Num() >= GMaxCachedEncodes)
+		{
+			GCache.RemoveAt(0, 1, false);
+		}
+		GCache.Add({ Key, PixelHash, PNG });
+	}
+}
+
+void FGXTextureEncoder::EncodePNGAsync(UObject* WorldContextObject, UTexture2D* Texture, FGXOnTextureEncoded OnComplete)
+{
+	check(IsInGameThread());
+
+	const FObjectKey Key(Texture);
+	IImageWrapperModule* ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	ReadImageAsync(WorldContextObject, Texture, [Key, ImageWrapperModule, OnComplete = MoveTemp(OnComplete)](FRawImage& Image) mutable
+	{
+		TArray<uint8> PNG;
+		FString Error;
+		if (Image.Pixels.Num() == 0)
+		{
+			Error = TEXT("Could not read the texture's pixels.");
+		}
+		else
+		{
+			// Hashing is an order of magnitude cheaper than deflate, and catches textures updated in place.
+			const uint64 PixelHash = CityHash64(reinterpret_cast<const char*>(Image.Pixels.GetData()), Image.Pixels.Num())
+				^ (static_cast<uint64>(Image.Width) << 32 | static_cast<uint32>(Image.Height));
+
+			if (!FindCached(Key, PixelHash, PNG))
+			{
+				TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule->CreateImageWrapper(EImageFormat::PNG);
+				if (ImageWrapper.IsValid() && ImageWrapper->SetRaw(Image.Pixels.GetData(), Image.Pixels.Num(), Image.Width, Image.Height, Image.Format, Image.BitDepth))
+				{
+					const TArray64<uint8> Compressed = ImageWrapper->GetCompressed(GUploadPngCompression);
+					PNG.Append(Compressed.GetData(), Compressed.Num());
+				}
+
+				if (PNG.Num() > 0)
+				{
+					StoreCached(Key, PixelHash, PNG);
+				}
+				else
+				{
+					Error = TEXT("Failed to encode image.");
+				}
+			}
+			else
+			{
+				UE_LOG(LogGXTextureEncoder, Verbose, TEXT("Reusing cached PNG for %dx%d texture."), Image.Width, Image.Height);
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [PNG = MoveTemp(PNG), Error = MoveTemp(Error), OnComplete = MoveTemp(OnComplete)]()
+		{
+			OnComplete(PNG, Error);
+		});
+	});
+}
+
+void FGXTextureEncoder::ReadPixelsBGRA8Async(UObject* WorldContextObject, UTexture2D* Texture, FGXOnPixelsRead OnComplete)
+{
+	ReadImageAsync(WorldContextObject, Texture, [OnComplete = MoveTemp(OnComplete)](FRawImage& Image)
+	{
+		TArray64<uint8> Pixels;
+		if (!ConvertToBGRA8(Image, Pixels))
+		{
+			OnComplete(TArray64<uint8>(), 0, 0);
+			return;
+		}
+		OnComplete(MoveTemp(Pixels), Image.Width, Image.Height);
+	});
+}
+
+bool FGXTextureEncoder::ReadPixelsBGRA8(UTexture2D* Texture, TArray64<uint8>& OutPixels, int32& OutWidth, int32& OutHeight)
+{
+	check(IsInGameThread());
+
+	FRawImage Image;
+	if (!Texture || !(ReadPlatformMip(Texture, Image) || ReadSourceData(Texture, Image)) || !ConvertToBGRA8(Image, OutPixels))
+	{
+		return false;
+	}
+	OutWidth = Image.Width;
+	OutHeight = Image.Height;
+	return true;
+}
+
+void FGXTextureEncoder::ClearCache()
+{
+	FScopeLock Lock(&GCacheLock);
+	GCache.Empty();
+}
@@ -0,0 +1,189 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXTexturePool.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXTexturePool, Log, All);
+
+void UGXTexturePool::Deinitialize()
+{
+	Entries.Empty();
+	ResidentBytes = 0;
+	Super::Deinitialize();
+}
+
+UGXTexturePool* UGXTexturePool::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UGXTexturePool>() : nullptr;
+}
+
+FGXTextureFactory UGXTexturePool::MakeFactory(const UObject* WorldContextObject)
+{
+	TWeakObjectPtr<UGXTexturePool> WeakPool = Get(WorldContextObject);
+	return [WeakPool](TArray64<uint8>&& Pixels, int32 Width, int32 Height) -> UTexture2D*
+	{
+		if (UGXTexturePool* Pool = WeakPool.Get())
+		{
+			return Pool->CreateTexture(MoveTemp(Pixels), Width, Height);
+		}
+		return FGXTextureDecoder::CreateTexture(Pixels, Width, Height);
+	};
+}
+
+UTexture2D* UGXTexturePool::CreateTexture(TArray64<uint8>&& Pixels, int32 Width, int32 Height)
+{
+	check(IsInGameThread());
+
+	// Reuse the free texture released longest ago; recently released ones are the likeliest to be shown again.
+	int32 ReuseIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FGXPooledTexture& Entry = Entries[Index];
+		if (!Entry.bInUse && Entry.Texture && Entry.Texture->GetSizeX() == Width && Entry.Texture->GetSizeY() == Height
+			&& (ReuseIndex == INDEX_NONE || Entry.LastUsedSeconds < Entries[ReuseIndex].LastUsedSeconds))
+		{
+			ReuseIndex = Index;
+		}
+	}
+
+	if (ReuseIndex != INDEX_NONE && FGXTextureDecoder::UpdateTexture(Entries[ReuseIndex].Texture, MoveTemp(Pixels), Width, Height))
+	{
+		FGXPooledTexture& Entry = Entries[ReuseIndex];
+		Entry.bInUse = true;
+		Entry.LastUsedSeconds = FPlatformTime::Seconds();
+		++Reuses;
+		return Entry.Texture;
+	}
+
+	UTexture2D* Texture = FGXTextureDecoder::CreateTexture(Pixels, Width, Height);
+	if (Texture)
+	{
+		AddEntry(Texture);
+		EnforceBudget();
+	}
+	return Texture;
+}
+
+void UGXTexturePool::RegisterTexture(UTexture2D* Texture)
+{
+	if (!Texture) return;
+	if (FindEntry(Texture) != INDEX_NONE)
+	{
+		TouchTexture(Texture);
+		return;
+	}
+	AddEntry(Texture);
+	EnforceBudget();
+}
+
+void UGXTexturePool::TouchTexture(UTexture2D* Texture)
+{
+	const int32 Index = FindEntry(Texture);
+	if (Index != INDEX_NONE)
+	{
+		Entries[Index].LastUsedSeconds = FPlatformTime::Seconds();
+	}
+}
+
+void UGXTexturePool::ReleaseTexture(UTexture2D* Texture)
+{
+	const int32 Index = FindEntry(Texture);
+	if (Index == INDEX_NONE) return;
+
+	Entries[Index].bInUse = false;
+	Entries[Index].LastUsedSeconds = FPlatformTime::Seconds();
+	EnforceBudget();
+}
+
+void UGXTexturePool::Trim()
+{
+	for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Entries[Index].bInUse)
+		{
+			RemoveEntryAt(Index);
+			++Evictions;
+		}
+	}
+}
+
+FGXTexturePoolStats UGXTexturePool::GetStats() const
+{
+	FGXTexturePoolStats Stats;
+	for (const FGXPooledTexture& Entry : Entries)
+	{
+		++(Entry.bInUse ? Stats.InUseTextures : Stats.FreeTextures);
+	}
+	Stats.ResidentBytes = ResidentBytes;
+	Stats.BudgetBytes = static_cast<int64>(BudgetMegabytes) * 1024 * 1024;
+	Stats.Reuses = Reuses;
+	Stats.Evictions = Evictions;
+	return Stats;
+}
+
+int32 UGXTexturePool::FindEntry(const UTexture2D* Texture) const
+{
+	return Texture ? Entries.IndexOfByPredicate([Texture](const FGXPooledTexture& Entry) { return Entry.Texture == Texture; }) : INDEX_NONE;
+}
+
+void UGXTexturePool::AddEntry(UTexture2D* Texture)
+{
+	FGXPooledTexture& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Texture = Texture;
+	Entry.Bytes = CalcTextureBytes(Texture);
+	Entry.LastUsedSeconds = FPlatformTime::Seconds();
+	ResidentBytes += Entry.Bytes;
+}
+
+void UGXTexturePool::RemoveEntryAt(int32 Index)
+{
+	ResidentBytes -= Entries[Index].Bytes;
+	Entries.RemoveAtSwap(Index);
+}
+
+void UGXTexturePool::EnforceBudget()
+{
+	const int64 BudgetBytes = static_cast<int64>(BudgetMegabytes) * 1024 * 1024;
+
+	// Free textures go first, then in-use ones. Either way the least recently used is dropped.
+	for (const bool bEvictInUse : { false, true })
+	{
+		while (ResidentBytes > BudgetBytes)
+		{
+			int32 Victim = INDEX_NONE;
+			for (int32 Index = 0; Index < Entries.Num(); ++Index)
+			{
+				if (Entries[Index].bInUse == bEvictInUse && (Victim == INDEX_NONE || Entries[Index].LastUsedSeconds < Entries[Victim].LastUsedSeconds))
+				{
+					Victim = Index;
+				}
+			}
+			if (Victim == INDEX_NONE) break;
+
+			if (bEvictInUse)
+			{
+				UE_LOG(LogGXTexturePool, Warning, TEXT("Texture pool is over its %d MB budget with only in-use textures; dropping %s"), BudgetMegabytes, *GetNameSafe(Entries[Victim].Texture));
+			}
+			RemoveEntryAt(Victim);
+			++Evictions;
+		}
+	}
+}
+
+int64 UGXTexturePool::CalcTextureBytes(UTexture2D* Texture)
+{
+	// Runtime-created textures keep their pixels on the CPU as well, so both copies count against the budget.
+	int64 Bytes = Texture->CalcTextureMemorySizeEnum(TMC_AllMips);
+	if (const FTexturePlatformData* PlatformData = Texture->GetPlatformData())
+	{
+		for (const FTexture2DMipMap& Mip : PlatformData->Mips)
+		{
+			Bytes += Mip.BulkData.GetBulkDataSize();
+		}
+	}
+	return Bytes;
+}
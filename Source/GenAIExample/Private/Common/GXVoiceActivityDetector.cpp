@@ -0,0 +1,177 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXVoiceActivityDetector.h"
+
+namespace
+{
+	constexpr int32 GFrameMs = 10;
+
+	constexpr float GBandBottomHz = 300.f;
+	constexpr float GBandTopHz = 3400.f;
+
+	/** Voiced speech keeps most of its energy in the band; hum sits below it and hiss above. */
+	constexpr float GMinBandRatio = 0.35f;
+
+	/** Crossings per sample; white noise is near 0.5, voiced speech well under 0.2. */
+	constexpr float GMaxZeroCrossingRate = 0.35f;
+
+	/** The noise floor follows quieter frames quickly and louder ones slowly, and barely moves during a turn. */
+	constexpr float GNoiseFall = 0.3f;
+	constexpr float GNoiseRiseIdle = 0.01f;
+	constexpr float GNoiseRiseSpeaking = 0.0005f;
+
+	float OnePoleAlpha(float CutoffHz, int32 SampleRate)
+	{
+		return 1.f - FMath::Exp(-2.f * PI * CutoffHz / SampleRate);
+	}
+
+	int32 MsToFrames(int32 Ms)
+	{
+		return FMath::Max(1, FMath::DivideAndRoundUp(Ms, GFrameMs));
+	}
+}
+
+void FGXVoiceActivityDetector::Configure(const FGXVoiceActivityConfig& InConfig)
+{
+	Config = InConfig;
+	Config.SampleRate = FMath::Max(Config.SampleRate, 8000);
+
+	FrameSamples = Config.SampleRate * GFrameMs / 1000;
+	StartFrames = MsToFrames(Config.StartMs);
+	HangoverFrames = MsToFrames(Config.SilenceMs);
+	BandTopAlpha = OnePoleAlpha(GBandTopHz, Config.SampleRate);
+	BandBottomAlpha = OnePoleAlpha(GBandBottomHz, Config.SampleRate);
+
+	Frame.SetNumUninitialized(FrameSamples);
+	PaddingLimit = (MsToFrames(FMath::Max(Config.PrefixPaddingMs, 0)) + StartFrames) * FrameSamples;
+	Padding.Reserve(PaddingLimit);
+	Scratch.SetNumUninitialized(PaddingLimit);
+
+	Reset();
+}
+
+void FGXVoiceActivityDetector::Reset()
+{
+	NumFrame = 0;
+	Padding.Reset();
+	BandTop = BandBottom = 0.f;
+	NoiseFloorDb = Config.ThresholdDb - Config.NoiseMarginDb;
+	LastRms = 0.f;
+	bSpeaking = false;
+	SpeechRun = 0;
+	SilenceRun = 0;
+}
+
+int32 FGXVoiceActivityDetector::GetStartDelayMs() const
+{
+	return StartFrames * GFrameMs;
+}
+
+int32 FGXVoiceActivityDetector::GetStopDelayMs() const
+{
+	return HangoverFrames * GFrameMs;
+}
+
+void FGXVoiceActivityDetector::Process(const int16* Samples, int32 NumSamples, FEmitAudio Emit, FOnEvent OnEvent)
+{
+	if (FrameSamples == 0)
+	{
+		return;
+	}
+
+	while (NumSamples > 0)
+	{
+		const int32 Count = FMath::Min(NumSamples, FrameSamples - NumFrame);
+		FMemory::Memcpy(Frame.GetData() + NumFrame, Samples, Count * sizeof(int16));
+		NumFrame += Count;
+		Samples += Count;
+		NumSamples -= Count;
+
+		if (NumFrame == FrameSamples)
+		{
+			ProcessFrame(Emit, OnEvent);
+			NumFrame = 0;
+		}
+	}
+}
+
+void FGXVoiceActivityDetector::ProcessFrame(FEmitAudio Emit, FOnEvent OnEvent)
+{
+	const bool bSpeech = IsSpeechFrame(Frame.GetData());
+
+	if (bSpeaking)
+	{
+		Emit(Frame.GetData(), FrameSamples);
+
+		SilenceRun = bSpeech ? 0 : SilenceRun + 1;
+		if (SilenceRun >= HangoverFrames)
+		{
+			bSpeaking = false;
+			SpeechRun = 0;
+			OnEvent(EGXVoiceActivityEvent::SpeechStopped);
+		}
+		return;
+	}
+
+	// Idle: keep only the most recent padding, dropping the oldest audio to make room.
+	const int32 Excess = Padding.Num() + FrameSamples - PaddingLimit;
+	if (Excess > 0)
+	{
+		Padding.Read(Scratch.GetData(), Excess);
+	}
+	Padding.Write(Frame.GetData(), FrameSamples);
+
+	SpeechRun = bSpeech ? SpeechRun + 1 : 0;
+	if (SpeechRun >= StartFrames)
+	{
+		bSpeaking = true;
+		SilenceRun = 0;
+
+		// The padding already holds the frames that confirmed the start.
+		for (int32 Read = Padding.Read(Scratch.GetData(), Scratch.Num()); Read > 0; Read = Padding.Read(Scratch.GetData(), Scratch.Num()))
+		{
+			Emit(Scratch.GetData(), Read);
+		}
+		OnEvent(EGXVoiceActivityEvent::SpeechStarted);
+	}
+}
+
+bool FGXVoiceActivityDetector::IsSpeechFrame(const int16* Samples)
+{
+	constexpr float Scale = 1.f / 32768.f;
+
+	float Energy = 0.f;
+	float BandEnergy = 0.f;
+	int32 Crossings = 0;
+	bool bWasNegative = Samples[0] < 0;
+
+	for (int32 Index = 0; Index < FrameSamples; ++Index)
+	{
+		const float Sample = Samples[Index] * Scale;
+		Energy += Sample * Sample;
+
+		BandTop += BandTopAlpha * (Sample - BandTop);
+		BandBottom += BandBottomAlpha * (Sample - BandBottom);
+		const float Band = BandTop - BandBottom;
+		BandEnergy += Band * Band;
+
+		const bool bNegative = Samples[Index] < 0;
+		Crossings += bNegative != bWasNegative;
+		bWasNegative = bNegative;
+	}
+
+	LastRms = FMath::Sqrt(Energy / FrameSamples);
+	const float LevelDb = 20.f * FMath::LogX(10.f, FMath::Max(LastRms, 1e-6f));
+	const float BandRatio = Energy > 0.f ? BandEnergy / Energy : 0.f;
+	const float ZeroCrossingRate = static_cast<float>(Crossings) / FrameSamples;
+
+	const bool bSpeech = LevelDb >= Config.ThresholdDb
+		&& LevelDb >= NoiseFloorDb + Config.NoiseMarginDb
+		&& BandRatio >= GMinBandRatio
+		&& ZeroCrossingRate <= GMaxZeroCrossingRate;
+
+	const float Rate = LevelDb < NoiseFloorDb ? GNoiseFall : (bSpeaking ? GNoiseRiseSpeaking : GNoiseRiseIdle);
+	NoiseFloorDb += Rate * (LevelDb - NoiseFloorDb);
+
+	return bSpeech;
+}
@@ -0,0 +1,327 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXVoiceCaptureSubsystem.h"
+#include "AudioCaptureCore.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXVoiceCapture, Log, All);
+
+namespace
+{
+	/** Capture callback size; about 10 ms at 48 kHz, in step with the VAD's frames. */
+	constexpr uint32 GFramesPerCallback = 480;
+
+	/** Frames normally come back within one callback; a few spares cover listeners that hold on to one. */
+	constexpr int32 GInitialPoolFrames = 4;
+
+	constexpr float GFocusUpdateIntervalSeconds = 0.1f;
+}
+
+UGXVoiceCaptureSubsystem::~UGXVoiceCaptureSubsystem() = default;
+
+void UGXVoiceCaptureSubsystem::Deinitialize()
+{
+	CloseStream();
+	Listeners.Reset();
+	Super::Deinitialize();
+}
+
+bool UGXVoiceCaptureSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UGXVoiceCaptureSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGXVoiceCaptureSubsystem, STATGROUP_Tickables);
+}
+
+UGXVoiceCaptureSubsystem* UGXVoiceCaptureSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGXVoiceCaptureSubsystem>() : nullptr;
+}
+
+void UGXVoiceCaptureSubsystem::Tick(float DeltaTime)
+{
+	FocusUpdateAccumulator += DeltaTime;
+	if (FocusUpdateAccumulator >= GFocusUpdateIntervalSeconds)
+	{
+		FocusUpdateAccumulator = 0.f;
+		UpdateFocus();
+	}
+}
+
+int32 UGXVoiceCaptureSubsystem::AddListener(const AActor* Owner, FOnFrame OnFrame, FOnFocusChanged OnFocusChanged)
+{
+	if (!bInjectedInput && (!Capture || !Capture->IsStreamOpen()))
+	{
+		if (!OpenStream())
+		{
+			return INDEX_NONE;
+		}
+	}
+
+	TUniquePtr<FListener> Listener = MakeUnique<FListener>();
+	Listener->Id = NextListenerId++;
+	Listener->Owner = Owner;
+	Listener->bHasOwner = Owner != nullptr;
+	Listener->OnFrame = MoveTemp(OnFrame);
+	Listener->OnFocusChanged = MoveTemp(OnFocusChanged);
+	const int32 Id = Listener->Id;
+	{
+		FScopeLock Lock(&ListenersLock);
+		Listeners.Add(MoveTemp(Listener));
+	}
+
+	UpdateFocus();
+	return Id;
+}
+
+void UGXVoiceCaptureSubsystem::RemoveListener(int32 ListenerId)
+{
+	{
+		FScopeLock Lock(&ListenersLock);
+		Listeners.RemoveAll([ListenerId](const TUniquePtr<FListener>& Listener) { return Listener->Id == ListenerId; });
+	}
+
+	if (Listeners.Num() == 0)
+	{
+		CloseStream();
+	}
+	else
+	{
+		UpdateFocus();
+	}
+}
+
+void UGXVoiceCaptureSubsystem::SetInjectedInput(bool bInjected)
+{
+	if (bInjectedInput == bInjected)
+	{
+		return;
+	}
+
+	bInjectedInput = bInjected;
+	if (bInjected)
+	{
+		// Joins the capture thread, so the device and the injecting thread never share the converter.
+		CloseStream();
+		Converter.Reset();
+		ReserveFramePool();
+		UE_LOG(LogGXVoiceCapture, Log, TEXT("Microphone replaced by injected audio."));
+	}
+	else if (Listeners.Num() > 0 && !OpenStream())
+	{
+		UE_LOG(LogGXVoiceCapture, Warning, TEXT("Injected audio ended; %d voice session(s) are left without a microphone."), Listeners.Num());
+	}
+}
+
+void UGXVoiceCaptureSubsystem::InjectAudio(const float* Audio, int32 NumFrames, int32 NumChannels, int32 SampleRate)
+{
+	if (!ensureMsgf(bInjectedInput, TEXT("InjectAudio needs SetInjectedInput(true) first.")) || NumChannels <= 0 || SampleRate <= 0)
+	{
+		return;
+	}
+	OnAudioCaptured(Audio, NumFrames, NumChannels, SampleRate);
+}
+
+void UGXVoiceCaptureSubsystem::SetFocusedActor(AActor* Actor)
+{
+	FocusedActor = Actor;
+	UpdateFocus();
+}
+
+bool UGXVoiceCaptureSubsystem::IsFocused(const AActor* Actor) const
+{
+	for (const TUniquePtr<FListener>& Listener : Listeners)
+	{
+		if (Listener->Owner.Get() == Actor && Listener->bFocused.load(std::memory_order_relaxed))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UGXVoiceCaptureSubsystem::UpdateFocus()
+{
+	// An explicitly focused actor takes the microphone for all of its sessions.
+	if (const AActor* Focused = FocusedActor.Get())
+	{
+		for (const TUniquePtr<FListener>& Listener : Listeners)
+		{
+			Listener->bFocused.store(Listener->Owner.Get() == Focused, std::memory_order_relaxed);
+		}
+		return;
+	}
+
+	FVector ViewLocation = FVector::ZeroVector;
+	bool bHasView = false;
+	if (const APlayerController* Player = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr)
+	{
+		FRotator ViewRotation;
+		Player->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		bHasView = true;
+	}
+
+	// Partial selection of the nearest few; the count is small and the listener list is short.
+	// A lone session has nobody to share with, so the radius does not apply to it.
+	TArray<TPair<float, int32>, TInlineAllocator<16>> Candidates;
+	const bool bLoneListener = Listeners.Num() == 1;
+	const float MaxDistanceSquared = FocusRadius > 0.f ? FMath::Square(FocusRadius) : TNumericLimits<float>::Max();
+	for (int32 Index = 0; Index < Listeners.Num(); ++Index)
+	{
+		const FListener& Listener = *Listeners[Index];
+		float DistanceSquared = 0.f;
+		if (Listener.bHasOwner)
+		{
+			const AActor* Owner = Listener.Owner.Get();
+			if (!Owner)
+			{
+				continue;
+			}
+			DistanceSquared = bHasView ? FVector::DistSquared(Owner->GetActorLocation(), ViewLocation) : 0.f;
+		}
+		if (bLoneListener || DistanceSquared <= MaxDistanceSquared)
+		{
+			Candidates.Emplace(DistanceSquared, Index);
+		}
+	}
+	Candidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+
+	for (const TUniquePtr<FListener>& Listener : Listeners)
+	{
+		Listener->bFocused.store(false, std::memory_order_relaxed);
+	}
+	for (int32 Rank = 0; Rank < FMath::Min(Candidates.Num(), MaxFocusedSessions); ++Rank)
+	{
+		Listeners[Candidates[Rank].Value]->bFocused.store(true, std::memory_order_relaxed);
+	}
+}
+
+bool UGXVoiceCaptureSubsystem::OpenStream()
+{
+	if (!Capture)
+	{
+		Capture = MakeUnique<Audio::FAudioCapture>();
+	}
+
+	Audio::FCaptureDeviceInfo DeviceInfo;
+	if (!Capture->GetCaptureDeviceInfo(DeviceInfo))
+	{
+		UE_LOG(LogGXVoiceCapture, Warning, TEXT("No audio input device is available."));
+		return false;
+	}
+
+	// Configured here so the capture thread only reconfigures if the device reports a different format.
+	Converter.Configure(DeviceInfo.PreferredSampleRate, DeviceInfo.InputChannels, OutputSampleRate);
+	ReserveFramePool();
+
+	Audio::FAudioCaptureDeviceParams Params;
+	Audio::FOnCaptureFunction OnCapture = [this](const float* Audio, int32 NumFrames, int32 NumChannels, int32 SampleRate, double StreamTime, bool bOverflow)
+	{
+		OnAudioCaptured(Audio, NumFrames, NumChannels, SampleRate);
+	};
+
+	if (!Capture->OpenCaptureStream(Params, MoveTemp(OnCapture), GFramesPerCallback) || !Capture->StartStream())
+	{
+		UE_LOG(LogGXVoiceCapture, Warning, TEXT("Could not open the input device '%s'."), *DeviceInfo.DeviceName);
+		CloseStream();
+		return false;
+	}
+
+	UE_LOG(LogGXVoiceCapture, Log, TEXT("Sharing '%s' (%d Hz, %d channel(s)) between voice sessions."),
+		*DeviceInfo.DeviceName, DeviceInfo.PreferredSampleRate, DeviceInfo.InputChannels);
+	return true;
+}
+
+void UGXVoiceCaptureSubsystem::CloseStream()
+{
+	// Stopping joins the capture thread, so no callback is running once this returns.
+	if (Capture && Capture->IsStreamOpen())
+	{
+		Capture->StopStream();
+		Capture->CloseStream();
+	}
+}
+
+void UGXVoiceCaptureSubsystem::ReserveFramePool()
+{
+	if (FramePool.Num() == 0)
+	{
+		for (int32 Index = 0; Index < GInitialPoolFrames; ++Index)
+		{
+			FramePool.Add(MakeShared<FGXCapturedFrame, ESPMode::ThreadSafe>());
+		}
+	}
+}
+
+TSharedRef<FGXCapturedFrame, ESPMode::ThreadSafe> UGXVoiceCaptureSubsystem::AcquireFrame()
+{
+	for (int32 Attempt = 0; Attempt < FramePool.Num(); ++Attempt)
+	{
+		const int32 Index = (NextPoolFrame + Attempt) % FramePool.Num();
+		if (FramePool[Index].GetSharedReferenceCount() == 1)
+		{
+			NextPoolFrame = (Index + 1) % FramePool.Num();
+			return FramePool[Index];
+		}
+	}
+
+	// Every frame is still held by a listener; grow the pool rather than overwrite audio in use.
+	return FramePool.Add_GetRef(MakeShared<FGXCapturedFrame, ESPMode::ThreadSafe>());
+}
+
+void UGXVoiceCaptureSubsystem::OnAudioCaptured(const float* Audio, int32 NumFrames, int32 NumChannels, int32 SampleRate)
+{
+	FScopeLock Lock(&ListenersLock);
+
+	bool bAnyFocused = false;
+	for (const TUniquePtr<FListener>& Listener : Listeners)
+	{
+		const bool bFocused = Listener->bFocused.load(std::memory_order_relaxed);
+		if (bFocused != Listener->bDeliveredFocus)
+		{
+			Listener->bDeliveredFocus = bFocused;
+			if (Listener->OnFocusChanged) Listener->OnFocusChanged(bFocused);
+		}
+		bAnyFocused |= bFocused;
+	}
+
+	// Nobody is listening: skip the conversion entirely, so idle NPCs cost nothing.
+	if (!bAnyFocused)
+	{
+		return;
+	}
+
+	if (SampleRate != Converter.GetInputSampleRate() || NumChannels != Converter.GetInputChannels())
+	{
+		Converter.Configure(SampleRate, NumChannels, OutputSampleRate);
+	}
+
+	const TSharedRef<FGXCapturedFrame, ESPMode::ThreadSafe> Frame = AcquireFrame();
+	Frame->CaptureSeconds = FPlatformTime::Seconds();
+	Converter.Convert(Audio, NumFrames * NumChannels, Frame->PCM);
+
+	const int16* Samples = Frame->GetSamples();
+	const int32 NumSamples = Frame->GetNumSamples();
+	float Energy = 0.f;
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const float Sample = Samples[Index] / 32768.f;
+		Energy += Sample * Sample;
+	}
+	Frame->Rms = NumSamples > 0 ? FMath::Sqrt(Energy / NumSamples) : 0.f;
+
+	const FGXCapturedFrameRef Shared = Frame;
+	for (const TUniquePtr<FListener>& Listener : Listeners)
+	{
+		if (Listener->bDeliveredFocus && Listener->OnFrame)
+		{
+			Listener->OnFrame(Shared);
+		}
+	}
+}
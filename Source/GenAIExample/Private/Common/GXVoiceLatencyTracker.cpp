@@ -0,0 +1,147 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "Common/GXVoiceLatencyTracker.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXVoiceLatency, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("GenAI Voice"), STATGROUP_GXVoice, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Turns"), STAT_GXVoiceTurns, STATGROUP_GXVoice);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("End of turn (ms)"), STAT_GXVoiceEndOfTurnMs, STATGROUP_GXVoice);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Server VAD (ms)"), STAT_GXVoiceServerVADMs, STATGROUP_GXVoice);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Response (ms)"), STAT_GXVoiceResponseMs, STATGROUP_GXVoice);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("First audio (ms)"), STAT_GXVoiceFirstAudioMs, STATGROUP_GXVoice);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Playout (ms)"), STAT_GXVoicePlayoutMs, STATGROUP_GXVoice);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Total (ms)"), STAT_GXVoiceTotalMs, STATGROUP_GXVoice);
+
+CSV_DEFINE_CATEGORY(GXVoice, true);
+
+void FGXVoiceLatencyTracker::BeginTurn(double UserSpeechEndSeconds)
+{
+	for (std::atomic<double>& Stamp : Stamps)
+	{
+		Stamp.store(0.0);
+	}
+	Stamps[static_cast<int32>(EGXVoiceStage::UserSpeechEnd)].store(UserSpeechEndSeconds > 0.0 ? UserSpeechEndSeconds : FPlatformTime::Seconds());
+	bTurnOpen.store(true);
+}
+
+void FGXVoiceLatencyTracker::Mark(EGXVoiceStage Stage, double Seconds)
+{
+	if (Seconds <= 0.0)
+	{
+		Seconds = FPlatformTime::Seconds();
+	}
+
+	// Sessions with server VAD have no local speech end; the server's report opens the turn instead.
+	if (Stage == EGXVoiceStage::ServerSpeechStopped && !bTurnOpen.load())
+	{
+		for (std::atomic<double>& Stamp : Stamps)
+		{
+			Stamp.store(0.0);
+		}
+		bTurnOpen.store(true);
+	}
+
+	if (!bTurnOpen.load())
+	{
+		return;
+	}
+
+	double Unset = 0.0;
+	Stamps[static_cast<int32>(Stage)].compare_exchange_strong(Unset, Seconds);
+
+	if (Stage == EGXVoiceStage::FirstAudioAudible && bTurnOpen.exchange(false))
+	{
+		Complete();
+	}
+}
+
+void FGXVoiceLatencyTracker::Reset()
+{
+	bTurnOpen.store(false);
+	TurnCount.store(0);
+}
+
+void FGXVoiceLatencyTracker::Complete()
+{
+	const int32 TurnIndex = TurnCount.fetch_add(1) + 1;
+
+	// Turns are seconds apart; one completing before the game thread took the previous one is dropped rather
+	// than overwrite stamps that may be in the middle of being read.
+	if (bCompletedPending.load(std::memory_order_acquire))
+	{
+		return;
+	}
+	for (int32 Index = 0; Index < static_cast<int32>(EGXVoiceStage::Num); ++Index)
+	{
+		CompletedStamps[Index] = Stamps[Index].load();
+	}
+	CompletedTurnIndex = TurnIndex;
+	bCompletedPending.store(true, std::memory_order_release);
+}
+
+void FGXVoiceLatencyTracker::PublishCompletedTurn()
+{
+	check(IsInGameThread());
+	if (!bCompletedPending.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	// Each stage runs from the latest earlier point that was stamped, so missing stages add nothing.
+	float StageMs[static_cast<int32>(EGXVoiceStage::Num)] = {};
+	double First = 0.0;
+	double Previous = 0.0;
+	for (int32 Index = 0; Index < static_cast<int32>(EGXVoiceStage::Num); ++Index)
+	{
+		const double Stamp = CompletedStamps[Index];
+		if (Stamp <= 0.0)
+		{
+			continue;
+		}
+		if (Previous > 0.0)
+		{
+			StageMs[Index] = static_cast<float>(FMath::Max(0.0, Stamp - Previous) * 1000.0);
+		}
+		else
+		{
+			First = Stamp;
+		}
+		Previous = Stamp;
+	}
+
+	FGXVoiceTurnTimings Timings;
+	Timings.TurnIndex = CompletedTurnIndex;
+	Timings.EndOfTurnMs = StageMs[static_cast<int32>(EGXVoiceStage::TurnCommitted)];
+	Timings.ServerVADMs = StageMs[static_cast<int32>(EGXVoiceStage::ServerSpeechStopped)];
+	Timings.ResponseMs = StageMs[static_cast<int32>(EGXVoiceStage::FirstResponseByte)];
+	Timings.FirstAudioMs = StageMs[static_cast<int32>(EGXVoiceStage::FirstAudioQueued)];
+	Timings.PlayoutMs = StageMs[static_cast<int32>(EGXVoiceStage::FirstAudioAudible)];
+	Timings.TotalMs = static_cast<float>((Previous - First) * 1000.0);
+	bCompletedPending.store(false, std::memory_order_release);
+
+	UE_LOG(LogGXVoiceLatency, Log, TEXT("Turn %d: %.0f ms total = end of turn %.0f + server VAD %.0f + response %.0f + first audio %.0f + playout %.0f"),
+		Timings.TurnIndex, Timings.TotalMs, Timings.EndOfTurnMs, Timings.ServerVADMs, Timings.ResponseMs, Timings.FirstAudioMs, Timings.PlayoutMs);
+
+	SET_DWORD_STAT(STAT_GXVoiceTurns, Timings.TurnIndex);
+	SET_FLOAT_STAT(STAT_GXVoiceEndOfTurnMs, Timings.EndOfTurnMs);
+	SET_FLOAT_STAT(STAT_GXVoiceServerVADMs, Timings.ServerVADMs);
+	SET_FLOAT_STAT(STAT_GXVoiceResponseMs, Timings.ResponseMs);
+	SET_FLOAT_STAT(STAT_GXVoiceFirstAudioMs, Timings.FirstAudioMs);
+	SET_FLOAT_STAT(STAT_GXVoicePlayoutMs, Timings.PlayoutMs);
+	SET_FLOAT_STAT(STAT_GXVoiceTotalMs, Timings.TotalMs);
+
+	CSV_CUSTOM_STAT(GXVoice, EndOfTurnMs, Timings.EndOfTurnMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(GXVoice, ServerVADMs, Timings.ServerVADMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(GXVoice, ResponseMs, Timings.ResponseMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(GXVoice, FirstAudioMs, Timings.FirstAudioMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(GXVoice, PlayoutMs, Timings.PlayoutMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(GXVoice, TotalMs, Timings.TotalMs, ECsvCustomStatOp::Set);
+
+	if (OnTurnComplete)
+	{
+		OnTurnComplete(Timings);
+	}
+}
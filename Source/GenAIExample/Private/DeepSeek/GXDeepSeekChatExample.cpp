@@ -8,6 +8,7 @@
 #include "Data/GenAIMessageStructs.h"
 #include "Data/DeepSeek/GenDeepSeekStructs.h"
 #include "Utilities/GenUtils.h"
+#include "Common/GXModelRouter.h"
 #endif
 
 AGXDeepSeekChatExample::AGXDeepSeekChatExample()
@@ -21,6 +22,8 @@ AGXDeepSeekChatExample::AGXDeepSeekChatExample()
 void AGXDeepSeekChatExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 #if WITH_GENAI_MODULE
+    NonStreamingWatchdog.Stop();
+    StreamingWatchdog.Stop();
     if (ActiveRequestNonStreaming.IsValid() && ActiveRequestNonStreaming->GetStatus() == EHttpRequestStatus::Processing)
     {
         ActiveRequestNonStreaming->CancelRequest();
@@ -38,6 +41,13 @@ void AGXDeepSeekChatExample::RequestNonStreamingChat(const FString& UserMessage,
 #if WITH_GENAI_MODULE
     if (ActiveRequestNonStreaming.IsValid()) return;
 
+    // Fail fast instead of hammering an endpoint whose circuit breaker is open.
+    if (!UGXModelRouter::TryAcquireFor(this, EGXChatProvider::DeepSeek, ModelName))
+    {
+        OnUINonStreamingResponse.Broadcast(FString::Printf(TEXT("%s is unavailable (circuit open). Try again later."), *ModelName), false);
+        return;
+    }
+
     if (!SystemPrompt.IsEmpty())
     {
         if (ConversationHistory.Num() > 0 && ConversationHistory[0].Role == TEXT("system"))
@@ -56,12 +66,18 @@ void AGXDeepSeekChatExample::RequestNonStreamingChat(const FString& UserMessage,
     ChatSettings.Model = ModelName;  // Set model directly as string
     ChatSettings.Messages = ConversationHistory;
 
-    ActiveRequestNonStreaming = UGenDSeekChat::SendChatRequest(
+    const uint32 Generation = NonStreamingWatchdog.Begin();
+    const FHttpRequestPtr Request = UGenDSeekChat::SendChatRequest(
         ChatSettings,
         FOnDSeekChatCompletionResponse::CreateLambda(
-            [this](const FString& Response, const FString& Error, bool bSuccess)
+            [this, ModelName, Generation](const FString& Response, const FString& Error, bool bSuccess)
             {
                 if (!UGenUtils::IsContextStillValid(this)) return;
+                // The watchdog already gave up on this request and cleaned up after it.
+                if (!NonStreamingWatchdog.IsCurrent(Generation)) return;
+                NonStreamingWatchdog.Stop();
+
+                UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::DeepSeek, ModelName, bSuccess);
 
                 if (bSuccess)
                 {
@@ -76,6 +92,19 @@ void AGXDeepSeekChatExample::RequestNonStreamingChat(const FString& UserMessage,
                 ActiveRequestNonStreaming.Reset();
             })
     );
+
+    // Enforce the deadlines; on expiry the request is cancelled and the turn rolled back
+    if (NonStreamingWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveRequestNonStreaming = Request;
+        NonStreamingWatchdog.Watch(ActiveRequestNonStreaming, RequestTimeouts, false, [this, ModelName](EGXTimeoutKind Kind)
+        {
+            UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::DeepSeek, ModelName, false, true);
+            OnUINonStreamingResponse.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind), false);
+            ConversationHistory.Pop();
+            ActiveRequestNonStreaming.Reset();
+        });
+    }
 #else
     UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestNonStreamingChat will do nothing."));
 #endif
@@ -86,6 +115,13 @@ void AGXDeepSeekChatExample::RequestStreamingChat(const FString& UserMessage, co
 #if WITH_GENAI_MODULE
     if (ActiveRequestStreaming.IsValid()) return;
 
+    if (!UGXModelRouter::TryAcquireFor(this, EGXChatProvider::DeepSeek, ModelName))
+    {
+        OnUIStreamingError.Broadcast(FString::Printf(TEXT("%s is unavailable (circuit open). Try again later."), *ModelName));
+        return;
+    }
+    ActiveStreamingModel = ModelName;
+
     if (!SystemPrompt.IsEmpty())
     {
         if (ConversationHistory.Num() > 0 && ConversationHistory[0].Role == TEXT("system"))
@@ -104,8 +140,22 @@ void AGXDeepSeekChatExample::RequestStreamingChat(const FString& UserMessage, co
     ChatSettings.Model = ModelName;  // Set model directly as string
     ChatSettings.Messages = ConversationHistory;
 
+    const uint32 Generation = StreamingWatchdog.Begin();
     // This delegate is of type FOnDSeekChatStreamResponse, which we now correctly handle in OnStreamingChatEvent.
-    ActiveRequestStreaming = UGenDSeekChatStream::SendStreamChatRequest(ChatSettings, FOnDSeekChatStreamResponse::CreateUObject(this, &AGXDeepSeekChatExample::OnStreamingChatEvent));
+    const FHttpRequestPtr Request = UGenDSeekChatStream::SendStreamChatRequest(ChatSettings, FOnDSeekChatStreamResponse::CreateUObject(this, &AGXDeepSeekChatExample::OnStreamingChatEvent, Generation));
+
+    // Enforce the deadlines; a stalled stream is cancelled and the turn rolled back
+    if (StreamingWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveRequestStreaming = Request;
+        StreamingWatchdog.Watch(ActiveRequestStreaming, RequestTimeouts, true, [this](EGXTimeoutKind Kind)
+        {
+            UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::DeepSeek, ActiveStreamingModel, false, true);
+            OnUIStreamingError.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind));
+            ConversationHistory.Pop();
+            ActiveRequestStreaming.Reset();
+        });
+    }
 #else
     UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestStreamingChat will do nothing."));
 #endif
@@ -122,15 +172,19 @@ void AGXDeepSeekChatExample::ClearConversation()
 }
 
 #if WITH_GENAI_MODULE
-void AGXDeepSeekChatExample::OnStreamingChatEvent(EDeepSeekStreamEventType EventType, const FString& Payload, bool bSuccess)
+void AGXDeepSeekChatExample::OnStreamingChatEvent(EDeepSeekStreamEventType EventType, const FString& Payload, bool bSuccess, uint32 RequestGeneration)
 {
     if (!UGenUtils::IsContextStillValid(this)) return;
+    if (!StreamingWatchdog.IsCurrent(RequestGeneration)) return;
+    StreamingWatchdog.NotifyActivity();
 
     if (!bSuccess)
     {
         // For any kind of failure, broadcast the error, pop the user message, and reset.
+        UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::DeepSeek, ActiveStreamingModel, false);
         OnUIStreamingError.Broadcast(Payload);
         ConversationHistory.Pop();
+        StreamingWatchdog.Stop();
         ActiveRequestStreaming.Reset();
         return;
     }
@@ -144,15 +198,19 @@ void AGXDeepSeekChatExample::OnStreamingChatEvent(EDeepSeekStreamEventType Event
 
         case EDeepSeekStreamEventType::Completion:
             // The payload is the final, complete message.
+            UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::DeepSeek, ActiveStreamingModel, true);
             ConversationHistory.Add(FGenChatMessage(TEXT("assistant"), {FGenAIMessageContent::FromText(Payload)}));
             OnUIStreamingResponseCompleted.Broadcast(Payload);
+            StreamingWatchdog.Stop();
             ActiveRequestStreaming.Reset();
             break;
 
         case EDeepSeekStreamEventType::Error:
+             UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::DeepSeek, ActiveStreamingModel, false);
              // This case is now handled by the initial !bSuccess check, but we keep it for clarity.
              OnUIStreamingError.Broadcast(Payload);
              ConversationHistory.Pop();
+             StreamingWatchdog.Stop();
              ActiveRequestStreaming.Reset();
              break;
         
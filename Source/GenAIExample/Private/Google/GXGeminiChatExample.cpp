@@ -6,6 +6,7 @@
 #include "Models/Google/GenGeminiChat.h"
 #include "Models/Google/GenGeminiChatStream.h"
 #include "Utilities/GenUtils.h"
+#include "Common/GXModelRouter.h"
 #endif
 
 AGXGeminiChatExample::AGXGeminiChatExample()
@@ -34,6 +35,13 @@ void AGXGeminiChatExample::ClearConversation()
 void AGXGeminiChatExample::RequestNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt)
 {
 #if WITH_GENAI_MODULE
+    // Fail fast instead of hammering an endpoint whose circuit breaker is open.
+    if (!UGXModelRouter::TryAcquireFor(this, EGXChatProvider::Google, ModelName))
+    {
+        OnUINonStreamingResponse.Broadcast(FString::Printf(TEXT("%s is unavailable (circuit open). Try again later."), *ModelName), false);
+        return;
+    }
+
     if (!SystemPrompt.IsEmpty())
     {
         if (ConversationHistory.Num() > 0)
@@ -58,12 +66,18 @@ void AGXGeminiChatExample::RequestNonStreamingChat(const FString& UserMessage, c
     ChatSettings.Temperature = 0.7f;
 
     // 3. Send the request
-    ActiveRequestNonStreaming = UGenGeminiChat::SendChatRequest(
+    const uint32 Generation = NonStreamingWatchdog.Begin();
+    const FHttpRequestPtr Request = UGenGeminiChat::SendChatRequest(
         ChatSettings,
         FOnGeminiChatCompletionResponse::CreateLambda(
-            [this](const FString& Response, const FString& ErrorMessage, bool bSuccess)
+            [this, ModelName, Generation](const FString& Response, const FString& ErrorMessage, bool bSuccess)
             {
                 if (!UGenUtils::IsContextStillValid(this)) return;
+                // The watchdog already gave up on this request and cleaned up after it.
+                if (!NonStreamingWatchdog.IsCurrent(Generation)) return;
+                NonStreamingWatchdog.Stop();
+
+                UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::Google, ModelName, bSuccess);
 
                 if (bSuccess)
                 {
@@ -78,6 +92,19 @@ void AGXGeminiChatExample::RequestNonStreamingChat(const FString& UserMessage, c
                 ActiveRequestNonStreaming.Reset();
             })
     );
+
+    // Enforce the deadlines; on expiry the request is cancelled and the turn rolled back
+    if (NonStreamingWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveRequestNonStreaming = Request;
+        NonStreamingWatchdog.Watch(ActiveRequestNonStreaming, RequestTimeouts, false, [this, ModelName](EGXTimeoutKind Kind)
+        {
+            UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::Google, ModelName, false, true);
+            OnUINonStreamingResponse.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind), false);
+            ConversationHistory.Pop();
+            ActiveRequestNonStreaming.Reset();
+        });
+    }
 #else
     UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestNonStreamingChat will do nothing."));
 #endif
@@ -86,6 +113,13 @@ void AGXGeminiChatExample::RequestNonStreamingChat(const FString& UserMessage, c
 void AGXGeminiChatExample::RequestStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt)
 {
 #if WITH_GENAI_MODULE
+    if (!UGXModelRouter::TryAcquireFor(this, EGXChatProvider::Google, ModelName))
+    {
+        OnUIStreamingError.Broadcast(FString::Printf(TEXT("%s is unavailable (circuit open). Try again later."), *ModelName));
+        return;
+    }
+    ActiveStreamingModel = ModelName;
+
     if (!SystemPrompt.IsEmpty())
     {
         if (ConversationHistory.Num() > 0)
@@ -109,24 +143,42 @@ void AGXGeminiChatExample::RequestStreamingChat(const FString& UserMessage, cons
     ChatSettings.Messages = ConversationHistory;
 
     // 3. Send the request
-    ActiveRequestStreaming = UGenGeminiChatStream::SendStreamChatRequest(
+    const uint32 Generation = StreamingWatchdog.Begin();
+    const FHttpRequestPtr Request = UGenGeminiChatStream::SendStreamChatRequest(
         ChatSettings,
-        FOnGeminiChatStreamResponse::CreateUObject(this, &AGXGeminiChatExample::OnStreamingChatEvent)
+        FOnGeminiChatStreamResponse::CreateUObject(this, &AGXGeminiChatExample::OnStreamingChatEvent, Generation)
     );
+
+    // Enforce the deadlines; a stalled stream is cancelled and the turn rolled back
+    if (StreamingWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveRequestStreaming = Request;
+        StreamingWatchdog.Watch(ActiveRequestStreaming, RequestTimeouts, true, [this](EGXTimeoutKind Kind)
+        {
+            UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::Google, ActiveStreamingModel, false, true);
+            OnUIStreamingError.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind));
+            ConversationHistory.Pop();
+            ActiveRequestStreaming.Reset();
+        });
+    }
 #else
     UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestStreamingChat will do nothing."));
 #endif
 }
 
 #if WITH_GENAI_MODULE
-void AGXGeminiChatExample::OnStreamingChatEvent(EGoogleGeminiStreamEventType EventType, const FGeminiGenerateContentResponseChunk& Chunk, const FString& ErrorMessage, bool bSuccess)
+void AGXGeminiChatExample::OnStreamingChatEvent(EGoogleGeminiStreamEventType EventType, const FGeminiGenerateContentResponseChunk& Chunk, const FString& ErrorMessage, bool bSuccess, uint32 RequestGeneration)
 {
     if (!UGenUtils::IsContextStillValid(this)) return;
+    if (!StreamingWatchdog.IsCurrent(RequestGeneration)) return;
+    StreamingWatchdog.NotifyActivity();
 
     if (!bSuccess)
     {
+        UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::Google, ActiveStreamingModel, false);
         OnUIStreamingError.Broadcast(ErrorMessage);
         ConversationHistory.Pop();
+        StreamingWatchdog.Stop();
         ActiveRequestStreaming.Reset();
         return;
     }
@@ -146,14 +198,18 @@ void AGXGeminiChatExample::OnStreamingChatEvent(EGoogleGeminiStreamEventType Eve
             break;
 
         case EGoogleGeminiStreamEventType::Completed:
+            UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::Google, ActiveStreamingModel, true);
             ConversationHistory.Add(FGenGeminiMessage(TEXT("model"), AccumulatedStreamedResponse));
             OnUIStreamingResponseCompleted.Broadcast(TEXT("")); // Final full message is already accumulated
+            StreamingWatchdog.Stop();
             ActiveRequestStreaming.Reset();
             break;
 
         case EGoogleGeminiStreamEventType::Error:
+            UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::Google, ActiveStreamingModel, false);
             OnUIStreamingError.Broadcast(ErrorMessage);
             ConversationHistory.Pop();
+            StreamingWatchdog.Stop();
             ActiveRequestStreaming.Reset();
             break;
         
@@ -166,6 +222,8 @@ void AGXGeminiChatExample::OnStreamingChatEvent(EGoogleGeminiStreamEventType Eve
 void AGXGeminiChatExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 #if WITH_GENAI_MODULE
+    NonStreamingWatchdog.Stop();
+    StreamingWatchdog.Stop();
     if (ActiveRequestNonStreaming.IsValid() && ActiveRequestNonStreaming->GetStatus() == EHttpRequestStatus::Processing)
     {
         ActiveRequestNonStreaming->CancelRequest();
@@ -42,6 +42,11 @@ void AGXGoogleAudioExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 #if WITH_GENAI_MODULE
     // Clear any pending timers
     GetWorld()->GetTimerManager().ClearTimer(FileWriteDelayTimer);
+    SegmentTranscriber.Cancel();
+    MicCapture.Cancel();
+
+    TTSWatchdog.Stop();
+    TranscriptionWatchdog.Stop();
 
     // Cancel any pending HTTP requests
     if (ActiveTTSRequest.IsValid() && ActiveTTSRequest->GetStatus() == EHttpRequestStatus::Processing)
@@ -67,13 +72,15 @@ void AGXGoogleAudioExample::RequestTextToSpeech(const FString& TextToSpeak, cons
     TTSSettings.SpeechConfig.Voice = StringToGoogleVoice(VoiceName);
 
     TWeakObjectPtr<AGXGoogleAudioExample> WeakThis(this);
+    const uint32 Generation = TTSWatchdog.Begin();
     
-    ActiveTTSRequest = UGenGoogleTextToSpeech::SendTextToSpeechRequest(
+    const FHttpRequestPtr Request = UGenGoogleTextToSpeech::SendTextToSpeechRequest(
         TTSSettings,
         FOnGoogleTTSCompletionResponse::CreateLambda(
-            [WeakThis](const TArray<uint8>& AudioData, const FString& Error, bool bSuccess)
+            [WeakThis, Generation](const TArray<uint8>& AudioData, const FString& Error, bool bSuccess)
             {
-                if (!WeakThis.IsValid()) return;
+                if (!WeakThis.IsValid() || !WeakThis->TTSWatchdog.IsCurrent(Generation)) return;
+                WeakThis->TTSWatchdog.Stop();
                 
                 if (bSuccess)
                 {
@@ -96,6 +103,16 @@ void AGXGoogleAudioExample::RequestTextToSpeech(const FString& TextToSpeak, cons
                 
                 WeakThis->ActiveTTSRequest.Reset();
             }));
+
+    if (TTSWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveTTSRequest = Request;
+        TTSWatchdog.Watch(ActiveTTSRequest, RequestTimeouts, false, [this](EGXTimeoutKind Kind)
+        {
+            ActiveTTSRequest.Reset();
+            OnUITTSResponse.Broadcast(nullptr, FGXRequestWatchdog::DescribeTimeout(Kind), false);
+        });
+    }
 #else
     UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestTextToSpeech will do nothing."));
 #endif
@@ -118,17 +135,25 @@ void AGXGoogleAudioExample::RequestTranscriptionFromFile(const FString& AudioFil
     TranscriptionSettings.Prompt = Prompt;
 
     TWeakObjectPtr<AGXGoogleAudioExample> WeakThis(this);
+    const uint32 Generation = TranscriptionWatchdog.Begin();
 
-    ActiveTranscriptionRequest = UGenGoogleTranscription::SendTranscriptionRequest(
+    const FHttpRequestPtr Request = UGenGoogleTranscription::SendTranscriptionRequest(
         AudioFilePath,
         TranscriptionSettings,
         FOnGoogleTranscriptionCompletionResponse::CreateLambda(
-            [WeakThis](const FString& Transcript, const FString& Error, bool bSuccess)
+            [WeakThis, Generation](const FString& Transcript, const FString& Error, bool bSuccess)
             {
-                if (!WeakThis.IsValid()) return;
+                if (!WeakThis.IsValid() || !WeakThis->TranscriptionWatchdog.IsCurrent(Generation)) return;
+                WeakThis->TranscriptionWatchdog.Stop();
                 WeakThis->OnUITranscriptionResponse.Broadcast(bSuccess ? Transcript : Error, bSuccess);
                 WeakThis->ActiveTranscriptionRequest.Reset();
             }));
+
+    if (TranscriptionWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveTranscriptionRequest = Request;
+        TranscriptionWatchdog.Watch(ActiveTranscriptionRequest, RequestTimeouts, false, [this](EGXTimeoutKind Kind) { OnTranscriptionTimedOut(Kind); });
+    }
 #else
     UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestTranscriptionFromFile will do nothing."));
 #endif
@@ -148,17 +173,25 @@ void AGXGoogleAudioExample::RequestTranscriptionFromData(const TArray<uint8>& Au
     TranscriptionSettings.Prompt = Prompt;
 
     TWeakObjectPtr<AGXGoogleAudioExample> WeakThis(this);
+    const uint32 Generation = TranscriptionWatchdog.Begin();
 
-    ActiveTranscriptionRequest = UGenGoogleTranscription::SendTranscriptionRequestFromData(
+    const FHttpRequestPtr Request = UGenGoogleTranscription::SendTranscriptionRequestFromData(
         AudioData,
         TranscriptionSettings,
         FOnGoogleTranscriptionCompletionResponse::CreateLambda(
-            [WeakThis](const FString& Transcript, const FString& Error, bool bSuccess)
+            [WeakThis, Generation](const FString& Transcript, const FString& Error, bool bSuccess)
             {
-                if (!WeakThis.IsValid()) return;
+                if (!WeakThis.IsValid() || !WeakThis->TranscriptionWatchdog.IsCurrent(Generation)) return;
+                WeakThis->TranscriptionWatchdog.Stop();
                 WeakThis->OnUITranscriptionResponse.Broadcast(bSuccess ? Transcript : Error, bSuccess);
                 WeakThis->ActiveTranscriptionRequest.Reset();
             }));
+
+    if (TranscriptionWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveTranscriptionRequest = Request;
+        TranscriptionWatchdog.Watch(ActiveTranscriptionRequest, RequestTimeouts, false, [this](EGXTimeoutKind Kind) { OnTranscriptionTimedOut(Kind); });
+    }
 #else
     UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestTranscriptionFromData will do nothing."));
 #endif
@@ -167,15 +200,34 @@ void AGXGoogleAudioExample::RequestTranscriptionFromData(const TArray<uint8>& Au
 void AGXGoogleAudioExample::StartRecording(const FString& ModelName, const FString& Prompt)
 {
 #if WITH_GENAI_MODULE
+    TranscriptionModelName = ModelName;
+    TranscriptionPrompt = Prompt;
+
+    if (bUseInMemoryCapture)
+    {
+        if (!MicCapture.Start(MaxRecordingSeconds))
+        {
+            OnUITranscriptionResponse.Broadcast(TEXT("Could not open the microphone."), false);
+            return;
+        }
+
+        if (bSegmentedTranscription)
+        {
+            SegmentTranscriber.Start(MicCapture, SegmentedTranscription, 24000,
+                [this](TArray<uint8>&& WavData, const FString& SegmentPrompt, FGXSegmentedTranscriber::FOnSegmentDone OnDone)
+                {
+                    return SendTranscriptionSegment(MoveTemp(WavData), SegmentPrompt, MoveTemp(OnDone));
+                });
+        }
+        return;
+    }
+
     if (!RecordingSubmix)
     {
         UE_LOG(LogTemp, Warning, TEXT("StartRecording: No RecordingSubmix specified. Please assign it in the editor."));
         return;
     }
 
-    TranscriptionModelName = ModelName;
-    TranscriptionPrompt = Prompt;
-
     UAudioMixerBlueprintLibrary::StartRecordingOutput(this, 0.f, RecordingSubmix);
     UE_LOG(LogTemp, Log, TEXT("Started recording submix '%s'"), *RecordingSubmix->GetName());
 #else
@@ -186,6 +238,33 @@ void AGXGoogleAudioExample::StartRecording(const FString& ModelName, const FStri
 void AGXGoogleAudioExample::StopRecordingAndTranscribe()
 {
 #if WITH_GENAI_MODULE
+    if (MicCapture.IsRecording() && SegmentTranscriber.IsActive())
+    {
+        // Earlier segments are already uploaded or on their way; only the audio since the last pause is left.
+        MicCapture.Stop();
+        TWeakObjectPtr<AGXGoogleAudioExample> WeakThis(this);
+        SegmentTranscriber.Finish([WeakThis](bool bSuccess, const FString& TranscriptOrError)
+        {
+            if (!WeakThis.IsValid()) return;
+            WeakThis->OnUITranscriptionResponse.Broadcast(TranscriptOrError, bSuccess);
+        });
+        return;
+    }
+
+    if (MicCapture.IsRecording())
+    {
+        TArray<uint8> WavData;
+        if (!MicCapture.Stop(24000, WavData))
+        {
+            OnUITranscriptionResponse.Broadcast(TEXT("No audio was recorded."), false);
+            return;
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("Sending %d bytes of WAV data (%.1f s) for transcription."), WavData.Num(), MicCapture.GetRecordedSeconds());
+        RequestTranscriptionFromData(WavData, TranscriptionModelName, TranscriptionPrompt);
+        return;
+    }
+
     if (!RecordingSubmix)
     {
         UE_LOG(LogTemp, Warning, TEXT("StopRecordingAndTranscribe: No RecordingSubmix specified."));
@@ -211,6 +290,35 @@ void AGXGoogleAudioExample::StopRecordingAndTranscribe()
 }
 
 #if WITH_GENAI_MODULE
+void AGXGoogleAudioExample::OnTranscriptionTimedOut(EGXTimeoutKind Kind)
+{
+    ActiveTranscriptionRequest.Reset();
+    OnUITranscriptionResponse.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind), false);
+}
+
+FHttpRequestPtr AGXGoogleAudioExample::SendTranscriptionSegment(TArray<uint8>&& WavData, const FString& Prompt, FGXSegmentedTranscriber::FOnSegmentDone OnDone)
+{
+    FGoogleTranscriptionSettings TranscriptionSettings;
+    TranscriptionSettings.Model = TranscriptionModelName;
+    TranscriptionSettings.Prompt = TranscriptionPrompt;
+    if (!Prompt.IsEmpty())
+    {
+        // Gemini takes the prompt as an instruction, so the transcript so far is framed as context.
+        TranscriptionSettings.Prompt += FString::Printf(TEXT("\n\nThis audio continues a recording transcribed so far as: \"%s\". Transcribe only this audio."), *Prompt);
+    }
+
+    TWeakObjectPtr<AGXGoogleAudioExample> WeakThis(this);
+    return UGenGoogleTranscription::SendTranscriptionRequestFromData(
+        WavData,
+        TranscriptionSettings,
+        FOnGoogleTranscriptionCompletionResponse::CreateLambda(
+            [WeakThis, OnDone](const FString& Transcript, const FString& Error, bool bSuccess)
+            {
+                if (!WeakThis.IsValid()) return;
+                OnDone(bSuccess, bSuccess ? Transcript : Error);
+            }));
+}
+
 void AGXGoogleAudioExample::ProcessRecordedFile(FString BaseFileName)
 {
     UE_LOG(LogTemp, Log, TEXT("Timer finished. Processing file: %s.wav"), *BaseFileName);
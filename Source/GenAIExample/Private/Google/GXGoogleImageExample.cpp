@@ -6,9 +6,10 @@
 #include "Models/Google/GenGoogleImageGeneration.h"
 #include "Data/Google/GenGoogleImageStructs.h"
 #include "Utilities/GenUtils.h"
-#include "ImageUtils.h" // Include for FImageUtils
-#include "IImageWrapperModule.h"
-#include "IImageWrapper.h"
+#include "Common/GXImageCache.h"
+#include "Common/GXTextureDecoder.h"
+#include "Common/GXTextureEncoder.h"
+#include "Common/GXTexturePool.h"
 #endif
 
 AGXGoogleImageExample::AGXGoogleImageExample()
@@ -16,15 +17,28 @@ AGXGoogleImageExample::AGXGoogleImageExample()
 #if WITH_GENAI_MODULE
 	PrimaryActorTick.bCanEverTick = false;
 #endif
+	RequestTimeouts.ConnectSeconds = 30.f;
+	RequestTimeouts.TotalSeconds = 240.f;
 }
 
 void AGXGoogleImageExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 #if WITH_GENAI_MODULE
+	// Invalidates a pending source encode or cache load as well as the request.
+	Watchdog.Begin();
+	bEncodingEditSource = false;
+	bLoadingFromCache = false;
 	if (ActiveRequest.IsValid() && ActiveRequest->GetStatus() == EHttpRequestStatus::Processing)
 	{
 		ActiveRequest->CancelRequest();
 	}
+
+	UGXTexturePool* Pool = UGXTexturePool::Get(this);
+	if (Pool && DeliveredTexture)
+	{
+		Pool->ReleaseTexture(DeliveredTexture);
+	}
+	DeliveredTexture = nullptr;
 #endif
 	Super::EndPlay(EndPlayReason);
 }
@@ -32,7 +46,7 @@ void AGXGoogleImageExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 void AGXGoogleImageExample::RequestGoogleImage(const FString& Prompt, const FString& ModelName)
 {
 #if WITH_GENAI_MODULE
-	if (ActiveRequest.IsValid()) return;
+	if (ActiveRequest.IsValid() || bEncodingEditSource || bLoadingFromCache) return;
 
 	FGenGoogleImageSettings Settings;
 	Settings.Prompt = Prompt;
@@ -40,7 +54,32 @@ void AGXGoogleImageExample::RequestGoogleImage(const FString& Prompt, const FStr
 	Settings.AspectRatio = EGenGoogleImageAspectRatio::Ratio_1_1;
 	Settings.NumberOfImages = 1;
 
-	ActiveRequest = UGenGoogleImageGeneration::SendImageGenerationRequest(Settings, FOnGoogleImageGenerationCompletionResponse::CreateUObject(this, &AGXGoogleImageExample::OnImageResponse));
+	// Everything that changes the output is part of the key.
+	ActiveCacheKey = bUseImageCache ? FGXImageCache::MakeKey(TEXT("Google"), ModelName, Prompt, { TEXT("1:1") }) : FString();
+	if (!ActiveCacheKey.IsEmpty() && FGXImageCache::Contains(ActiveCacheKey))
+	{
+		bLoadingFromCache = true;
+		const uint32 Generation = Watchdog.Begin();
+		TWeakObjectPtr<AGXGoogleImageExample> WeakThis(this);
+		FGXImageCache::LoadAsync(ActiveCacheKey, CacheMaxDimension, [WeakThis, Generation, Settings](UTexture2D* Texture)
+		{
+			if (!WeakThis.IsValid() || !WeakThis->Watchdog.IsCurrent(Generation)) return;
+			WeakThis->bLoadingFromCache = false;
+
+			if (Texture)
+			{
+				WeakThis->DeliverImage(Texture);
+			}
+			else
+			{
+				// The entry was damaged and has been removed; generate the image instead.
+				WeakThis->SendImageRequest(Settings);
+			}
+		});
+		return;
+	}
+
+	SendImageRequest(Settings);
 #else
 	UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestGoogleImage will do nothing."));
 #endif
@@ -49,63 +88,127 @@ void AGXGoogleImageExample::RequestGoogleImage(const FString& Prompt, const FStr
 void AGXGoogleImageExample::RequestGoogleImageEdit(const FString& Prompt, UTexture2D* Image, const FString& ModelName)
 {
 #if WITH_GENAI_MODULE
-	if (ActiveRequest.IsValid()) return;
+	if (ActiveRequest.IsValid() || bEncodingEditSource || bLoadingFromCache) return;
 	if (!Image)
 	{
 		OnImageGenerationError.Broadcast("Input image is null.");
 		return;
 	}
 
-	FGenGoogleImageSettings Settings;
-	Settings.Prompt = Prompt;
-	Settings.Model = ModelName;
+	ActiveCacheKey.Reset();
 
-	TArray<uint8> ImageData;
-	if (Image->GetPlatformData() && Image->GetPlatformData()->Mips.Num() > 0)
+	// The PNG encode runs on a worker; the request is sent once it is done. Taking a generation now
+	// makes an encode that finishes after EndPlay or a newer request a no-op.
+	bEncodingEditSource = true;
+	const uint32 Generation = Watchdog.Begin();
+	TWeakObjectPtr<AGXGoogleImageExample> WeakThis(this);
+	FGXTextureEncoder::EncodePNGAsync(this, Image, [WeakThis, Generation, Prompt, ModelName](const TArray<uint8>& PNG, const FString& EncodeError)
 	{
-		FTexture2DMipMap& Mip = Image->GetPlatformData()->Mips[0];
-		void* TextureData = Mip.BulkData.Lock(LOCK_READ_ONLY);
-		
-		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+		if (!WeakThis.IsValid() || !WeakThis->Watchdog.IsCurrent(Generation)) return;
+		WeakThis->bEncodingEditSource = false;
 
-		if (ImageWrapper.IsValid() && ImageWrapper->SetRaw(TextureData, Mip.BulkData.GetBulkDataSize(), Image->GetSizeX(), Image->GetSizeY(), ERGBFormat::BGRA, 8))
+		if (PNG.Num() == 0)
 		{
-			TArray64<uint8> CompressedData = ImageWrapper->GetCompressed(100);
-			ImageData.Append(CompressedData.GetData(), CompressedData.Num());
+			WeakThis->OnImageGenerationError.Broadcast(FString::Printf(TEXT("Failed to convert image to bytes: %s"), *EncodeError));
+			return;
 		}
-
-		Mip.BulkData.Unlock();
-	}
-
-	if (ImageData.Num() == 0)
-	{
-		OnImageGenerationError.Broadcast("Failed to convert image to bytes.");
-		return;
-	}
-	
-	Settings.ImageBytes = ImageData;
-	Settings.MimeType = TEXT("image/png");
-
-	ActiveRequest = UGenGoogleImageGeneration::SendImageGenerationRequest(Settings, FOnGoogleImageGenerationCompletionResponse::CreateUObject(this, &AGXGoogleImageExample::OnImageResponse));
+		WeakThis->SendImageEditRequest(Prompt, ModelName, PNG, Generation);
+	});
 #else
 	UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestGoogleImageEdit will do nothing."));
 #endif
 }
 
 #if WITH_GENAI_MODULE
-void AGXGoogleImageExample::OnImageResponse(const TArray<uint8>& ImageBytes, const FString& Error, bool bSuccess)
+void AGXGoogleImageExample::SendImageRequest(const FGenGoogleImageSettings& Settings)
 {
-	if (bSuccess)
+	const uint32 Generation = Watchdog.Begin();
+	const FHttpRequestPtr Request = UGenGoogleImageGeneration::SendImageGenerationRequest(Settings, FOnGoogleImageGenerationCompletionResponse::CreateUObject(this, &AGXGoogleImageExample::OnImageResponse, Generation));
+	if (Watchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
 	{
-		// Use the engine's built-in utility to create the texture
-		UTexture2D* Texture = FImageUtils::ImportBufferAsTexture2D(ImageBytes);
-		OnImageGenerated.Broadcast(Texture, true);
+		ActiveRequest = Request;
+		Watchdog.Watch(ActiveRequest, RequestTimeouts, false, [this](EGXTimeoutKind Kind) { OnRequestTimedOut(Kind); });
 	}
-	else
+}
+
+void AGXGoogleImageExample::SendImageEditRequest(const FString& Prompt, const FString& ModelName, const TArray<uint8>& PNG, uint32 Generation)
+{
+	FGenGoogleImageSettings Settings;
+	Settings.Prompt = Prompt;
+	Settings.Model = ModelName;
+	Settings.ImageBytes = PNG;
+	Settings.MimeType = TEXT("image/png");
+
+	const FHttpRequestPtr Request = UGenGoogleImageGeneration::SendImageGenerationRequest(Settings, FOnGoogleImageGenerationCompletionResponse::CreateUObject(this, &AGXGoogleImageExample::OnImageResponse, Generation));
+	if (Watchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+	{
+		ActiveRequest = Request;
+		Watchdog.Watch(ActiveRequest, RequestTimeouts, false, [this](EGXTimeoutKind Kind) { OnRequestTimedOut(Kind); });
+	}
+}
+
+void AGXGoogleImageExample::OnImageResponse(const TArray<uint8>& ImageBytes, const FString& Error, bool bSuccess, uint32 RequestGeneration)
+{
+	// A response that arrives after the watchdog gave up belongs to nobody.
+	if (!Watchdog.IsCurrent(RequestGeneration)) return;
+	Watchdog.Stop();
+
+	if (!bSuccess)
 	{
 		OnImageGenerationError.Broadcast(Error);
+		ActiveRequest.Reset();
+		return;
 	}
+
+	// Fresh images go to the cache straight from the decode worker.
+	FGXOnPixelsReady StoreInCache;
+	if (!ActiveCacheKey.IsEmpty())
+	{
+		StoreInCache = [Key = ActiveCacheKey](const TArray64<uint8>& Pixels, int32 Width, int32 Height)
+		{
+			FGXImageCache::StoreAsync(Key, TArray64<uint8>(Pixels), Width, Height);
+		};
+	}
+
+	// Decode off the game thread. ActiveRequest stays set until the texture is delivered, so the
+	// generation cannot change and a second request cannot start meanwhile.
+	TWeakObjectPtr<AGXGoogleImageExample> WeakThis(this);
+	FGXTextureDecoder::DecodeAsync(ImageBytes, [WeakThis, RequestGeneration](UTexture2D* Texture, const FString& DecodeError, const FGXTextureDecodeTiming& Timing)
+	{
+		if (!WeakThis.IsValid() || !WeakThis->Watchdog.IsCurrent(RequestGeneration)) return;
+		WeakThis->ActiveRequest.Reset();
+
+		if (!Texture)
+		{
+			WeakThis->OnImageGenerationError.Broadcast(DecodeError);
+			return;
+		}
+		UE_LOG(LogTemp, Log, TEXT("Image %dx%d ready: decode %.1f ms, compress %.1f ms, game thread %.2f ms, total %.1f ms, %lld KB resident"),
+			Timing.Width, Timing.Height, Timing.DecodeMs, Timing.CompressMs, Timing.GameThreadMs, Timing.TotalMs, Timing.TextureBytes / 1024);
+		WeakThis->OnImageDecodeTimings.Broadcast(Timing.DecodeMs, Timing.CompressMs, Timing.GameThreadMs, Timing.TotalMs);
+
+		WeakThis->DeliverImage(Texture);
+	}, MoveTemp(StoreInCache), UGXTexturePool::MakeFactory(this), TextureCompression);
+}
+
+void AGXGoogleImageExample::DeliverImage(UTexture2D* Texture)
+{
+	// Compressed and cached textures are created outside the pool's factory; registering an already pooled one is a no-op.
+	if (UGXTexturePool* Pool = UGXTexturePool::Get(this))
+	{
+		Pool->RegisterTexture(Texture);
+		if (DeliveredTexture && DeliveredTexture != Texture)
+		{
+			Pool->ReleaseTexture(DeliveredTexture);
+		}
+	}
+	DeliveredTexture = Texture;
+	OnImageGenerated.Broadcast(Texture, true);
+}
+
+void AGXGoogleImageExample::OnRequestTimedOut(EGXTimeoutKind Kind)
+{
 	ActiveRequest.Reset();
+	OnImageGenerationError.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind));
 }
 #endif
\ No newline at end of file
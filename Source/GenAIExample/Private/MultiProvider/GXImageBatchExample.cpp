@@ -0,0 +1,324 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "MultiProvider/GXImageBatchExample.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Common/GXTextureDecoder.h"
+#include "Engine/Texture2D.h"
+#include "Engine/Texture2DArray.h"
+
+#if WITH_GENAI_MODULE
+#include "Models/OpenAI/GenOAIImageGeneration.h"
+#include "Data/OpenAI/GenOAIImageStructs.h"
+#include "Models/Google/GenGoogleImageGeneration.h"
+#include "Data/Google/GenGoogleImageStructs.h"
+#endif
+
+namespace
+{
+	/**
+	 * Copies Source into a CellWidth x CellHeight region of Dest, box-filtering when the cell is smaller.
+	 * Each destination pixel averages the source pixels it covers, so downscaled icons do not alias.
+	 */
+	void BlitBoxFiltered(const uint8* Source, int32 SourceWidth, int32 SourceHeight, uint8* Dest, int64 DestPitch, int32 CellWidth, int32 CellHeight)
+	{
+		for (int32 Y = 0; Y < CellHeight; ++Y)
+		{
+			const int32 SourceY0 = static_cast<int32>(static_cast<int64>(Y) * SourceHeight / CellHeight);
+			const int32 SourceY1 = FMath::Max(SourceY0 + 1, static_cast<int32>(static_cast<int64>(Y + 1) * SourceHeight / CellHeight));
+			uint8* DestRow = Dest + Y * DestPitch;
+
+			if (CellWidth == SourceWidth && CellHeight == SourceHeight)
+			{
+				FMemory::Memcpy(DestRow, Source + static_cast<int64>(Y) * SourceWidth * 4, static_cast<int64>(CellWidth) * 4);
+				continue;
+			}
+
+			for (int32 X = 0; X < CellWidth; ++X)
+			{
+				const int32 SourceX0 = static_cast<int32>(static_cast<int64>(X) * SourceWidth / CellWidth);
+				const int32 SourceX1 = FMath::Max(SourceX0 + 1, static_cast<int32>(static_cast<int64>(X + 1) * SourceWidth / CellWidth));
+
+				uint32 Sum[4] = { 0, 0, 0, 0 };
+				for (int32 SY = SourceY0; SY < SourceY1; ++SY)
+				{
+					const uint8* Pixel = Source + (static_cast<int64>(SY) * SourceWidth + SourceX0) * 4;
+					for (int32 SX = SourceX0; SX < SourceX1; ++SX, Pixel += 4)
+					{
+						Sum[0] += Pixel[0];
+						Sum[1] += Pixel[1];
+						Sum[2] += Pixel[2];
+						Sum[3] += Pixel[3];
+					}
+				}
+
+				const uint32 Count = static_cast<uint32>((SourceY1 - SourceY0) * (SourceX1 - SourceX0));
+				for (int32 Channel = 0; Channel < 4; ++Channel)
+				{
+					DestRow[X * 4 + Channel] = static_cast<uint8>(Sum[Channel] / Count);
+				}
+			}
+		}
+	}
+}
+
+AGXImageBatchExample::AGXImageBatchExample()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	RequestTimeouts.ConnectSeconds = 30.f;
+	RequestTimeouts.TotalSeconds = 240.f;
+}
+
+void AGXImageBatchExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CancelImageBatch();
+	Super::EndPlay(EndPlayReason);
+}
+
+void AGXImageBatchExample::RequestImageBatch(EGXChatProvider Provider, const FString& Prompt, const FString& ModelName, int32 Count, EGXImageBatchPacking Packing)
+{
+#if WITH_GENAI_MODULE
+	if (bBatchRunning) return;
+	if (Provider != EGXChatProvider::OpenAI && Provider != EGXChatProvider::Google)
+	{
+		OnImageGenerationError.Broadcast(FString::Printf(TEXT("%s has no image generation API."), *GXChatProviderToString(Provider)));
+		return;
+	}
+	if (Count <= 0) return;
+
+	ResetBatch();
+	BatchProvider = Provider;
+	BatchPrompt = Prompt;
+	BatchModel = ModelName;
+	BatchPacking = Packing;
+	BatchCount = Count;
+	Decoded.Reserve(Count);
+	bBatchRunning = true;
+
+	StartPendingRequests();
+#else
+	UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestImageBatch will do nothing."));
+#endif
+}
+
+void AGXImageBatchExample::CancelImageBatch()
+{
+	for (TUniquePtr<FRequestSlot>& Slot : Slots)
+	{
+		// Begin() makes the slot's outstanding response stale before the request is cancelled.
+		Slot->Watchdog.Begin();
+		if (Slot->Request.IsValid() && Slot->Request->GetStatus() == EHttpRequestStatus::Processing)
+		{
+			Slot->Request->CancelRequest();
+		}
+		Slot->Request.Reset();
+		Slot->bBusy = false;
+	}
+	ResetBatch();
+}
+
+void AGXImageBatchExample::StartPendingRequests()
+{
+	while (bBatchRunning && RequestsStarted < BatchCount)
+	{
+		int32 FreeSlot = Slots.IndexOfByPredicate([](const TUniquePtr<FRequestSlot>& Slot) { return !Slot->bBusy; });
+		if (FreeSlot == INDEX_NONE)
+		{
+			if (Slots.Num() >= MaxConcurrentRequests) return;
+			FreeSlot = Slots.Add(MakeUnique<FRequestSlot>());
+		}
+		StartRequest(FreeSlot);
+	}
+}
+
+void AGXImageBatchExample::StartRequest(int32 SlotIndex)
+{
+#if WITH_GENAI_MODULE
+	FRequestSlot& Slot = *Slots[SlotIndex];
+	Slot.bBusy = true;
+	++RequestsStarted;
+
+	// Each response carries a single image's bytes, so every request asks for exactly one.
+	const uint32 Generation = Slot.Watchdog.Begin();
+	FHttpRequestPtr Request;
+	if (BatchProvider == EGXChatProvider::OpenAI)
+	{
+		FGenOAIImageSettings Settings;
+		Settings.Prompt = BatchPrompt;
+		Settings.Model = BatchModel;
+		Settings.Size = EGenAIImageSize::Size1024x1024;
+		Settings.Quality = BatchModel == TEXT("gpt-image-1") ? EGenAIImageQuality::Medium : EGenAIImageQuality::Standard;
+		Settings.N = 1;
+		Request = UGenOAIImageGeneration::SendImageGenerationRequest(Settings, FOnImageGenerationCompletionResponse::CreateUObject(this, &AGXImageBatchExample::OnImageResponse, SlotIndex, Generation));
+	}
+	else
+	{
+		FGenGoogleImageSettings Settings;
+		Settings.Prompt = BatchPrompt;
+		Settings.Model = BatchModel;
+		Settings.AspectRatio = EGenGoogleImageAspectRatio::Ratio_1_1;
+		Settings.NumberOfImages = 1;
+		Request = UGenGoogleImageGeneration::SendImageGenerationRequest(Settings, FOnGoogleImageGenerationCompletionResponse::CreateUObject(this, &AGXImageBatchExample::OnImageResponse, SlotIndex, Generation));
+	}
+
+	// A response delivered inside the send already freed the slot, and may have started the next image in it.
+	if (!Slot.Watchdog.IsCurrent(Generation) || !Slot.bBusy) return;
+
+	if (!Request.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Image batch request could not be sent."));
+		Slot.Watchdog.Stop();
+		Slot.bBusy = false;
+		OnImageFinished(TArray64<uint8>(), 0, 0);
+		return;
+	}
+
+	Slot.Request = Request;
+	if (!FGXRequestWatchdog::IsInFlight(Request)) return;
+	Slot.Watchdog.Watch(Request, RequestTimeouts, false, [this, SlotIndex](EGXTimeoutKind Kind)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Image batch request failed: %s"), *FGXRequestWatchdog::DescribeTimeout(Kind));
+		Slots[SlotIndex]->Request.Reset();
+		Slots[SlotIndex]->bBusy = false;
+		OnImageFinished(TArray64<uint8>(), 0, 0);
+		StartPendingRequests();
+	});
+#endif
+}
+
+void AGXImageBatchExample::OnImageResponse(const TArray<uint8>& ImageBytes, const FString& Error, bool bSuccess, int32 SlotIndex, uint32 RequestGeneration)
+{
+	FRequestSlot& Slot = *Slots[SlotIndex];
+	if (!Slot.Watchdog.IsCurrent(RequestGeneration)) return;
+	Slot.Watchdog.Stop();
+	Slot.Request.Reset();
+	Slot.bBusy = false;
+
+	// Free the slot first so the next request overlaps with this image's decode.
+	StartPendingRequests();
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Image batch request failed: %s"), *Error);
+		OnImageFinished(TArray64<uint8>(), 0, 0);
+		return;
+	}
+
+	TWeakObjectPtr<AGXImageBatchExample> WeakThis(this);
+	const uint32 Batch = BatchGeneration;
+	FGXTextureDecoder::DecodePixelsAsync(ImageBytes, [WeakThis, Batch](TArray64<uint8>&& Pixels, int32 Width, int32 Height, const FString& DecodeError)
+	{
+		if (!WeakThis.IsValid() || WeakThis->BatchGeneration != Batch) return;
+		if (!DecodeError.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Image batch decode failed: %s"), *DecodeError);
+		}
+		WeakThis->OnImageFinished(MoveTemp(Pixels), Width, Height);
+	});
+}
+
+void AGXImageBatchExample::OnImageFinished(TArray64<uint8>&& Pixels, int32 Width, int32 Height)
+{
+	if (Pixels.Num() > 0)
+	{
+		Decoded.Add({ MoveTemp(Pixels), Width, Height });
+	}
+	else
+	{
+		++ImagesFailed;
+	}
+
+	++ImagesFinished;
+	OnImageBatchProgress.Broadcast(ImagesFinished, BatchCount);
+	if (ImagesFinished == BatchCount)
+	{
+		PackBatch();
+	}
+}
+
+void AGXImageBatchExample::PackBatch()
+{
+	const int32 ImageCount = Decoded.Num();
+	if (ImageCount == 0)
+	{
+		const int32 Failed = ImagesFailed;
+		ResetBatch();
+		OnImageGenerationError.Broadcast(FString::Printf(TEXT("All %d images of the batch failed."), Failed));
+		return;
+	}
+
+	// Cells take the size of the first image; models return a fixed size per request, so this is normally exact.
+	const bool bAtlas = BatchPacking == EGXImageBatchPacking::Atlas;
+	const int32 Columns = bAtlas ? FMath::CeilToInt(FMath::Sqrt(static_cast<float>(ImageCount))) : 1;
+	const int32 Rows = bAtlas ? FMath::DivideAndRoundUp(ImageCount, Columns) : 1;
+	const float Fit = bAtlas ? FMath::Min(1.f, MaxAtlasSize / static_cast<float>(FMath::Max(Columns * Decoded[0].Width, Rows * Decoded[0].Height))) : 1.f;
+	const int32 CellWidth = FMath::Max(1, FMath::FloorToInt(Decoded[0].Width * Fit));
+	const int32 CellHeight = FMath::Max(1, FMath::FloorToInt(Decoded[0].Height * Fit));
+	const int32 PackedWidth = CellWidth * Columns;
+	const int32 PackedHeight = CellHeight * Rows;
+
+	TArray<FBox2D> Regions;
+	for (int32 Index = 0; Index < ImageCount; ++Index)
+	{
+		const FVector2D Min(static_cast<double>(Index % Columns) / Columns, static_cast<double>(Index / Columns) / Rows);
+		Regions.Emplace(bAtlas ? Min : FVector2D::ZeroVector, bAtlas ? Min + FVector2D(1.0 / Columns, 1.0 / Rows) : FVector2D::UnitVector);
+	}
+
+	TWeakObjectPtr<AGXImageBatchExample> WeakThis(this);
+	const uint32 Batch = BatchGeneration;
+	const int32 Failed = ImagesFailed;
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Batch, Failed, Images = MoveTemp(Decoded), Regions = MoveTemp(Regions), bAtlas, Columns, CellWidth, CellHeight, PackedWidth, PackedHeight]() mutable
+	{
+		const int32 Count = Images.Num();
+		const int64 SliceBytes = static_cast<int64>(PackedWidth) * PackedHeight * 4;
+		TArray64<uint8> Packed;
+		Packed.SetNumZeroed(bAtlas ? SliceBytes : SliceBytes * Count);
+
+		ParallelFor(Count, [&](int32 Index)
+		{
+			const FDecodedImage& Image = Images[Index];
+			const int64 Pitch = static_cast<int64>(PackedWidth) * 4;
+			uint8* Dest = bAtlas
+				? Packed.GetData() + (static_cast<int64>(Index / Columns) * CellHeight) * Pitch + static_cast<int64>(Index % Columns) * CellWidth * 4
+				: Packed.GetData() + SliceBytes * Index;
+			BlitBoxFiltered(Image.Pixels.GetData(), Image.Width, Image.Height, Dest, Pitch, CellWidth, CellHeight);
+		});
+		Images.Empty();
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Batch, Failed, Packed = MoveTemp(Packed), Regions = MoveTemp(Regions), bAtlas, Count, PackedWidth, PackedHeight]()
+		{
+			if (!WeakThis.IsValid() || WeakThis->BatchGeneration != Batch) return;
+
+			float GameThreadMs = 0.f;
+			UTexture* Texture = bAtlas
+				? static_cast<UTexture*>(FGXTextureDecoder::CreateTexture(Packed, PackedWidth, PackedHeight, &GameThreadMs))
+				: static_cast<UTexture*>(FGXTextureDecoder::CreateTextureArray(Packed, PackedWidth, PackedHeight, Count, &GameThreadMs));
+			UE_LOG(LogTemp, Log, TEXT("Packed %d images into %dx%d%s, game thread %.2f ms"), Count, PackedWidth, PackedHeight, bAtlas ? TEXT("") : *FString::Printf(TEXT("x%d"), Count), GameThreadMs);
+
+			if (!Texture)
+			{
+				WeakThis->ResetBatch();
+				WeakThis->OnImageGenerationError.Broadcast(TEXT("Failed to create the batch texture."));
+				return;
+			}
+
+			FGXTextureDecoder::WhenRenderResourceReady(Texture, [WeakThis, Batch, Failed, Regions](UTexture* ReadyTexture)
+			{
+				if (!WeakThis.IsValid() || WeakThis->BatchGeneration != Batch) return;
+				WeakThis->ResetBatch();
+				WeakThis->OnImageBatchGenerated.Broadcast(ReadyTexture, Regions, Failed);
+			});
+		});
+	});
+}
+
+void AGXImageBatchExample::ResetBatch()
+{
+	++BatchGeneration;
+	bBatchRunning = false;
+	BatchCount = 0;
+	RequestsStarted = 0;
+	ImagesFinished = 0;
+	ImagesFailed = 0;
+	Decoded.Empty();
+}
@@ -0,0 +1,282 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "MultiProvider/GXRoutedChatExample.h"
+#include "Common/GXChatDispatch.h"
+#include "Common/GXConversationArchive.h"
+
+AGXRoutedChatExample::AGXRoutedChatExample()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	SystemPrompt = TEXT("You are a helpful assistant integrated into an Unreal Engine application.");
+}
+
+void AGXRoutedChatExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Watchdog.Stop();
+	// Cancel any in-flight request when the actor is destroyed to prevent crashes.
+	if (ActiveRequest.IsValid() && ActiveRequest->GetStatus() == EHttpRequestStatus::Processing)
+	{
+		ActiveRequest->CancelRequest();
+	}
+	ActiveRequest.Reset();
+	Super::EndPlay(EndPlayReason);
+}
+
+void AGXRoutedChatExample::ClearConversation()
+{
+	ConversationHistory.Empty();
+}
+
+bool AGXRoutedChatExample::SaveConversation(const FString& SlotName)
+{
+	// Mid-request the history ends with an unanswered user turn.
+	if (ActiveRequest.IsValid()) return false;
+
+	FString Error;
+	if (!FGXConversationArchive::Save(FGXConversationArchive::GetSlotPath(SlotName), SystemPrompt, ConversationHistory, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SaveConversation: %s"), *Error);
+		return false;
+	}
+	return true;
+}
+
+bool AGXRoutedChatExample::ResumeConversation(const FString& SlotName)
+{
+	if (ActiveRequest.IsValid()) return false;
+
+	FGXConversationArchiveReader Reader;
+	TArray<FGXChatTurn> Turns;
+	FString Error;
+	if (!Reader.Open(FGXConversationArchive::GetSlotPath(SlotName), Error) || !Reader.DecodeTurns(Turns, true, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ResumeConversation: %s"), *Error);
+		return false;
+	}
+
+	const FString SavedSystemPrompt = Reader.GetSystemPrompt();
+	if (!SavedSystemPrompt.IsEmpty())
+	{
+		SystemPrompt = SavedSystemPrompt;
+	}
+	ConversationHistory = MoveTemp(Turns);
+	return true;
+}
+
+void AGXRoutedChatExample::RequestRoutedChat(const FString& UserMessage, FGXRoutingPolicy Policy, const FString& InSystemPrompt, UTexture2D* Image)
+{
+	if (ActiveRequest.IsValid()) return;
+
+	if (Image != nullptr)
+	{
+		Policy.RequiredCapabilities |= static_cast<int32>(EGXModelCapability::Vision);
+	}
+
+	bUseExplicitChain = false;
+	ExplicitChain.Reset();
+	ActivePolicy = Policy;
+	BeginRequest(UserMessage, InSystemPrompt, Image);
+}
+
+void AGXRoutedChatExample::RequestChatWithFailover(const FString& UserMessage, const TArray<FGXModelEndpoint>& FailoverChain, const FString& InSystemPrompt, UTexture2D* Image)
+{
+	if (ActiveRequest.IsValid()) return;
+
+	if (FailoverChain.Num() == 0)
+	{
+		OnUIStreamingError.Broadcast(TEXT("The failover chain is empty."));
+		return;
+	}
+
+	bUseExplicitChain = true;
+	ExplicitChain = FailoverChain;
+	BeginRequest(UserMessage, InSystemPrompt, Image);
+}
+
+void AGXRoutedChatExample::BeginRequest(const FString& UserMessage, const FString& InSystemPrompt, UTexture2D* Image)
+{
+	if (!InSystemPrompt.IsEmpty())
+	{
+		SystemPrompt = InSystemPrompt;
+	}
+
+	// 1. Add the user turn to the neutral history. Every attempt replays this same history.
+	FGXChatTurn Turn(TEXT("user"), UserMessage);
+	if (Image != nullptr)
+	{
+		Turn.Images.Add(Image);
+	}
+	ConversationHistory.Add(MoveTemp(Turn));
+
+	ActivePrompt = UserMessage;
+	NextChainIndex = 0;
+	TriedEndpoints.Reset();
+	AttemptCount = 0;
+	LastError = TEXT("No endpoint is available.");
+
+	// 2. Dispatch to the first endpoint that will take it
+	if (!StartNextAttempt())
+	{
+		FailRequest(LastError);
+	}
+}
+
+bool AGXRoutedChatExample::StartNextAttempt()
+{
+	UGXModelRouter* Router = UGXModelRouter::Get(this);
+	if (!Router)
+	{
+		LastError = TEXT("Model router is not available (no game instance).");
+		return false;
+	}
+
+	while (AttemptCount < MaxAttempts)
+	{
+		FGXModelEndpoint Endpoint;
+		if (bUseExplicitChain)
+		{
+			if (!ExplicitChain.IsValidIndex(NextChainIndex)) return false;
+			Endpoint = ExplicitChain[NextChainIndex++];
+		}
+		else if (!Router->SelectEndpointExcluding(ActivePolicy, ActivePrompt, TriedEndpoints, Endpoint))
+		{
+			return false;
+		}
+
+		TriedEndpoints.Add(Endpoint.GetKey());
+		if (!Router->TryAcquireEndpoint(Endpoint))
+		{
+			// Circuit is open: skip without spending an attempt on a dead endpoint.
+			continue;
+		}
+
+		++AttemptCount;
+		ActiveEndpoint = Endpoint;
+		RequestStartSeconds = FPlatformTime::Seconds();
+		bFirstTokenReported = false;
+		OnUIRouteSelected.Broadcast(Endpoint.Provider, Endpoint.Model);
+
+		// Callbacks from an attempt the watchdog already abandoned must not touch the next attempt.
+		const uint32 Generation = Watchdog.Begin();
+		TWeakObjectPtr<AGXRoutedChatExample> WeakThis(this);
+		FGXChatDispatchCallbacks Callbacks;
+		Callbacks.OnDelta = [WeakThis, Generation](const FString& Delta)
+		{
+			if (WeakThis.IsValid() && WeakThis->Watchdog.IsCurrent(Generation)) WeakThis->HandleDelta(Delta);
+		};
+		Callbacks.OnComplete = [WeakThis, Generation](const FString& Response, const FString& Error, bool bSuccess)
+		{
+			if (WeakThis.IsValid() && WeakThis->Watchdog.IsCurrent(Generation)) WeakThis->HandleComplete(Response, Error, bSuccess);
+		};
+
+		// Stored only once it is known to be in flight: a request that completed inside Send has already been
+		// handled, possibly by starting the next attempt, and keeping it would block every later send.
+		const FHttpRequestPtr Request = FGXChatDispatch::Send(Endpoint, SystemPrompt, ConversationHistory, MoveTemp(Callbacks));
+		if (!Watchdog.IsCurrent(Generation) || (Request.IsValid() && !FGXRequestWatchdog::IsInFlight(Request)))
+		{
+			return true;
+		}
+		if (Request.IsValid())
+		{
+			ActiveRequest = Request;
+			Watchdog.Watch(ActiveRequest, RequestTimeouts, FGXChatDispatch::SupportsStreaming(Endpoint.Provider), [this](EGXTimeoutKind Kind)
+			{
+				HandleTimeout(Kind);
+			});
+			return true;
+		}
+
+		Router->ReportOutcome(Endpoint, false);
+		LastError = TEXT("Failed to start the request.");
+	}
+	return false;
+}
+
+void AGXRoutedChatExample::HandleDelta(const FString& Delta)
+{
+	Watchdog.NotifyActivity();
+	if (!bFirstTokenReported)
+	{
+		bFirstTokenReported = true;
+		if (UGXModelRouter* Router = UGXModelRouter::Get(this))
+		{
+			Router->ReportFirstToken(ActiveEndpoint, static_cast<float>((FPlatformTime::Seconds() - RequestStartSeconds) * 1000.0));
+		}
+	}
+	OnUIStreamingResponseDelta.Broadcast(Delta);
+}
+
+void AGXRoutedChatExample::HandleComplete(const FString& Response, const FString& Error, bool bSuccess)
+{
+	Watchdog.Stop();
+	ActiveRequest.Reset();
+
+	if (UGXModelRouter* Router = UGXModelRouter::Get(this))
+	{
+		// Non-streaming providers only produce a first token when the whole response lands.
+		if (bSuccess && !bFirstTokenReported)
+		{
+			Router->ReportFirstToken(ActiveEndpoint, static_cast<float>((FPlatformTime::Seconds() - RequestStartSeconds) * 1000.0));
+		}
+		Router->ReportOutcome(ActiveEndpoint, bSuccess);
+	}
+
+	if (bSuccess)
+	{
+		if (!bFirstTokenReported)
+		{
+			OnUIStreamingResponseDelta.Broadcast(Response);
+		}
+		ConversationHistory.Add(FGXChatTurn(TEXT("assistant"), Response));
+		OnUIStreamingResponseCompleted.Broadcast(Response);
+		return;
+	}
+
+	LastError = Error;
+
+	// Once text has reached the UI, switching providers would splice two answers together.
+	if (!bFirstTokenReported)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s failed (%s). Failing over."), *ActiveEndpoint.GetKey(), *Error);
+		if (StartNextAttempt())
+		{
+			return;
+		}
+	}
+
+	FailRequest(LastError);
+}
+
+void AGXRoutedChatExample::HandleTimeout(EGXTimeoutKind Kind)
+{
+	// The watchdog already cancelled the request.
+	ActiveRequest.Reset();
+	LastError = FGXRequestWatchdog::DescribeTimeout(Kind);
+
+	if (UGXModelRouter* Router = UGXModelRouter::Get(this))
+	{
+		Router->ReportOutcome(ActiveEndpoint, false, true);
+	}
+
+	// A stream that stalled after showing text cannot be resumed elsewhere without duplicating it.
+	if (!bFirstTokenReported)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s timed out (%s). Failing over."), *ActiveEndpoint.GetKey(), *LastError);
+		if (StartNextAttempt())
+		{
+			return;
+		}
+	}
+
+	FailRequest(LastError);
+}
+
+void AGXRoutedChatExample::FailRequest(const FString& Error)
+{
+	// Remove the user turn so the history stays balanced.
+	if (ConversationHistory.Num() > 0)
+	{
+		ConversationHistory.Pop();
+	}
+	OnUIStreamingError.Broadcast(Error);
+}
@@ -40,7 +40,12 @@ void AGXOpenAIAudioExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 #if WITH_GENAI_MODULE
     // Clear any pending timers
     GetWorld()->GetTimerManager().ClearTimer(FileWriteDelayTimer);
+    SegmentTranscriber.Cancel();
+    MicCapture.Cancel();
     
+    TTSWatchdog.Stop();
+    TranscriptionWatchdog.Stop();
+
     // Cancel any pending requests when the actor is destroyed
     if (ActiveTTSRequest.IsValid() && ActiveTTSRequest->GetStatus() == EHttpRequestStatus::Processing)
     {
@@ -64,13 +69,15 @@ void AGXOpenAIAudioExample::RequestTextToSpeech(const FString& TextToSpeak, cons
     TTSSettings.Voice = EGenAIVoice::Alloy;
 
     TWeakObjectPtr<AGXOpenAIAudioExample> WeakThis(this);
+    const uint32 Generation = TTSWatchdog.Begin();
     
-    ActiveTTSRequest = UGenOAITextToSpeech::SendTextToSpeechRequest(
+    const FHttpRequestPtr Request = UGenOAITextToSpeech::SendTextToSpeechRequest(
         TTSSettings,
         FOnTTSCompletionResponse::CreateLambda(
-            [WeakThis](const TArray<uint8>& AudioData, const FString& Error, bool bSuccess)
+            [WeakThis, Generation](const TArray<uint8>& AudioData, const FString& Error, bool bSuccess)
             {
-                if (!WeakThis.IsValid()) return;
+                if (!WeakThis.IsValid() || !WeakThis->TTSWatchdog.IsCurrent(Generation)) return;
+                WeakThis->TTSWatchdog.Stop();
 
                 if (bSuccess)
                 {
@@ -93,6 +100,16 @@ void AGXOpenAIAudioExample::RequestTextToSpeech(const FString& TextToSpeak, cons
                 
                 WeakThis->ActiveTTSRequest.Reset();
             }));
+
+    if (TTSWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveTTSRequest = Request;
+        TTSWatchdog.Watch(ActiveTTSRequest, RequestTimeouts, false, [this](EGXTimeoutKind Kind)
+        {
+            ActiveTTSRequest.Reset();
+            OnUITTSResponse.Broadcast(nullptr, FGXRequestWatchdog::DescribeTimeout(Kind), false);
+        });
+    }
 #else
     UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestTextToSpeech will do nothing."));
 #endif
@@ -113,17 +130,25 @@ void AGXOpenAIAudioExample::RequestTranscriptionFromFile(const FString& AudioFil
     TranscriptionSettings.Language = Language;
 
     TWeakObjectPtr<AGXOpenAIAudioExample> WeakThis(this);
+    const uint32 Generation = TranscriptionWatchdog.Begin();
 
-    ActiveTranscriptionRequest = UGenOAITranscription::SendTranscriptionRequest(
+    const FHttpRequestPtr Request = UGenOAITranscription::SendTranscriptionRequest(
         AudioFilePath,
         TranscriptionSettings,
         FOnTranscriptionCompletionResponse::CreateLambda(
-            [WeakThis](const FString& Transcript, const FString& Error, bool bSuccess)
+            [WeakThis, Generation](const FString& Transcript, const FString& Error, bool bSuccess)
             {
-                if (!WeakThis.IsValid()) return;
+                if (!WeakThis.IsValid() || !WeakThis->TranscriptionWatchdog.IsCurrent(Generation)) return;
+                WeakThis->TranscriptionWatchdog.Stop();
                 WeakThis->OnUITranscriptionResponse.Broadcast(bSuccess ? Transcript : Error, bSuccess);
                 WeakThis->ActiveTranscriptionRequest.Reset();
             }));
+
+    if (TranscriptionWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveTranscriptionRequest = Request;
+        TranscriptionWatchdog.Watch(ActiveTranscriptionRequest, RequestTimeouts, false, [this](EGXTimeoutKind Kind) { OnTranscriptionTimedOut(Kind); });
+    }
 #else
     UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestTranscriptionFromFile will do nothing."));
 #endif
@@ -144,17 +169,25 @@ void AGXOpenAIAudioExample::RequestTranscriptionFromData(const TArray<uint8>& Au
     TranscriptionSettings.Language = Language;
 
     TWeakObjectPtr<AGXOpenAIAudioExample> WeakThis(this);
+    const uint32 Generation = TranscriptionWatchdog.Begin();
 
-    ActiveTranscriptionRequest = UGenOAITranscription::SendTranscriptionRequestFromData(
+    const FHttpRequestPtr Request = UGenOAITranscription::SendTranscriptionRequestFromData(
         AudioData,
         TranscriptionSettings,
         FOnTranscriptionCompletionResponse::CreateLambda(
-            [WeakThis](const FString& Transcript, const FString& Error, bool bSuccess)
+            [WeakThis, Generation](const FString& Transcript, const FString& Error, bool bSuccess)
             {
-                if (!WeakThis.IsValid()) return;
+                if (!WeakThis.IsValid() || !WeakThis->TranscriptionWatchdog.IsCurrent(Generation)) return;
+                WeakThis->TranscriptionWatchdog.Stop();
                 WeakThis->OnUITranscriptionResponse.Broadcast(bSuccess ? Transcript : Error, bSuccess);
                 WeakThis->ActiveTranscriptionRequest.Reset();
             }));
+
+    if (TranscriptionWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveTranscriptionRequest = Request;
+        TranscriptionWatchdog.Watch(ActiveTranscriptionRequest, RequestTimeouts, false, [this](EGXTimeoutKind Kind) { OnTranscriptionTimedOut(Kind); });
+    }
 #else
     UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestTranscriptionFromData will do nothing."));
 #endif
@@ -163,6 +196,29 @@ void AGXOpenAIAudioExample::RequestTranscriptionFromData(const TArray<uint8>& Au
 void AGXOpenAIAudioExample::StartRecording(const FString& ModelName, const FString& Prompt, const FString& Language)
 {
 #if WITH_GENAI_MODULE
+    TranscriptionModelName = ModelName;
+    TranscriptionPrompt = Prompt;
+    TranscriptionLanguage = Language;
+
+    if (bUseInMemoryCapture)
+    {
+        if (!MicCapture.Start(MaxRecordingSeconds))
+        {
+            OnUITranscriptionResponse.Broadcast(TEXT("Could not open the microphone."), false);
+            return;
+        }
+
+        if (bSegmentedTranscription)
+        {
+            SegmentTranscriber.Start(MicCapture, SegmentedTranscription, 24000,
+                [this](TArray<uint8>&& WavData, const FString& SegmentPrompt, FGXSegmentedTranscriber::FOnSegmentDone OnDone)
+                {
+                    return SendTranscriptionSegment(MoveTemp(WavData), SegmentPrompt, MoveTemp(OnDone));
+                });
+        }
+        return;
+    }
+
     if (!RecordingSubmix)
     {
         UE_LOG(LogTemp, Warning, TEXT("StartRecording: No RecordingSubmix specified. Please assign it in the editor."));
@@ -175,10 +231,6 @@ void AGXOpenAIAudioExample::StartRecording(const FString& ModelName, const FStri
         return;
     }
 
-    TranscriptionModelName = ModelName;
-    TranscriptionPrompt = Prompt;
-    TranscriptionLanguage = Language;
-    
     AudioCapture->SoundSubmix = RecordingSubmix;
     // Route the audio capture to the recording submix
     AudioCapture->SetSubmixSend(RecordingSubmix, 1.0f);
@@ -196,6 +248,34 @@ void AGXOpenAIAudioExample::StartRecording(const FString& ModelName, const FStri
 void AGXOpenAIAudioExample::StopRecordingAndTranscribe()
 {
 #if WITH_GENAI_MODULE
+    if (MicCapture.IsRecording() && SegmentTranscriber.IsActive())
+    {
+        // Earlier segments are already uploaded or on their way; only the audio since the last pause is left.
+        MicCapture.Stop();
+        TWeakObjectPtr<AGXOpenAIAudioExample> WeakThis(this);
+        SegmentTranscriber.Finish([WeakThis](bool bSuccess, const FString& TranscriptOrError)
+        {
+            if (!WeakThis.IsValid()) return;
+            WeakThis->OnUITranscriptionResponse.Broadcast(TranscriptOrError, bSuccess);
+        });
+        return;
+    }
+
+    if (MicCapture.IsRecording())
+    {
+        // Whisper accepts any rate; 24 kHz mono matches what the file path sends.
+        TArray<uint8> WavData;
+        if (!MicCapture.Stop(24000, WavData))
+        {
+            OnUITranscriptionResponse.Broadcast(TEXT("No audio was recorded."), false);
+            return;
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("Sending %d bytes of WAV data (%.1f s) for transcription."), WavData.Num(), MicCapture.GetRecordedSeconds());
+        RequestTranscriptionFromData(WavData, TranscriptionModelName, TranscriptionPrompt, TranscriptionLanguage);
+        return;
+    }
+
     if (!RecordingSubmix)
     {
         UE_LOG(LogTemp, Warning, TEXT("StopRecordingAndTranscribe: No RecordingSubmix specified."));
@@ -231,6 +311,32 @@ void AGXOpenAIAudioExample::StopRecordingAndTranscribe()
 }
 
 #if WITH_GENAI_MODULE
+void AGXOpenAIAudioExample::OnTranscriptionTimedOut(EGXTimeoutKind Kind)
+{
+    ActiveTranscriptionRequest.Reset();
+    OnUITranscriptionResponse.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind), false);
+}
+
+FHttpRequestPtr AGXOpenAIAudioExample::SendTranscriptionSegment(TArray<uint8>&& WavData, const FString& Prompt, FGXSegmentedTranscriber::FOnSegmentDone OnDone)
+{
+    FGenOAITranscriptionSettings TranscriptionSettings;
+    TranscriptionSettings.Model = TranscriptionModelName;
+    // Whisper reads the prompt as the text preceding the audio, so the transcript so far goes last.
+    TranscriptionSettings.Prompt = TranscriptionPrompt.IsEmpty() || Prompt.IsEmpty() ? TranscriptionPrompt + Prompt : TranscriptionPrompt + TEXT(" ") + Prompt;
+    TranscriptionSettings.Language = TranscriptionLanguage;
+
+    TWeakObjectPtr<AGXOpenAIAudioExample> WeakThis(this);
+    return UGenOAITranscription::SendTranscriptionRequestFromData(
+        WavData,
+        TranscriptionSettings,
+        FOnTranscriptionCompletionResponse::CreateLambda(
+            [WeakThis, OnDone](const FString& Transcript, const FString& Error, bool bSuccess)
+            {
+                if (!WeakThis.IsValid()) return;
+                OnDone(bSuccess, bSuccess ? Transcript : Error);
+            }));
+}
+
 void AGXOpenAIAudioExample::ProcessRecordedFile(FString BaseFileName)
 {
     UE_LOG(LogTemp, Log, TEXT("Timer finished. Processing file: %s.wav"), *BaseFileName);
@@ -6,6 +6,7 @@
 #include "Models/OpenAI/GenOAIChat.h"
 #include "Models/OpenAI/GenOAIChatStream.h"
 #include "Utilities/GenUtils.h"
+#include "Common/GXModelRouter.h"
 #include "Misc/Paths.h"
 #include "UObject/UObjectGlobals.h"
 #include "UObject/EnumProperty.h"
@@ -30,7 +31,10 @@ AGXOpenAIChatExample::AGXOpenAIChatExample()
 
 void AGXOpenAIChatExample::ClearConversation()
 {
+    SentImages.Empty();
+
 #if WITH_GENAI_MODULE
+    ++PrepareGeneration;
     ConversationHistory.Empty();
     ConversationHistory.Add(FGenChatMessage(TEXT("system"), TEXT("You are a helpful assistant integrated into an Unreal Engine application.")));
 #else
@@ -39,8 +43,57 @@ void AGXOpenAIChatExample::ClearConversation()
 }
 
 void AGXOpenAIChatExample::RequestNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, UTexture2D* Image)
+{
+    TArray<UTexture2D*> Images;
+    if (Image != nullptr)
+    {
+        Images.Add(Image);
+    }
+    RequestNonStreamingChatWithImages(UserMessage, ModelName, SystemPrompt, Images);
+}
+
+void AGXOpenAIChatExample::RequestNonStreamingChatWithImages(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<UTexture2D*>& Images)
 {
 #if WITH_GENAI_MODULE
+    const uint32 Generation = ++PrepareGeneration;
+    if (Images.Num() == 0)
+    {
+        SendNonStreamingChat(UserMessage, ModelName, SystemPrompt, {});
+        return;
+    }
+
+    // The attachments are resized concurrently off the game thread; the request goes out once all of them are ready.
+    TWeakObjectPtr<AGXOpenAIChatExample> WeakThis(this);
+    FGXImagePreprocessor::PrepareAllAsync(this, Images, EGXChatProvider::OpenAI, ModelName, ImagePreprocessing,
+        [WeakThis, Generation, UserMessage, ModelName, SystemPrompt](TArray<FGXImagePreprocessStats>&& Prepared)
+        {
+            // A later send or ClearConversation superseded this turn while its images were being prepared;
+            // the UI is told, so it does not wait on a reply that will never come.
+            AGXOpenAIChatExample* Self = WeakThis.Get();
+            if (Self && Self->PrepareGeneration == Generation)
+            {
+                Self->SendNonStreamingChat(UserMessage, ModelName, SystemPrompt, Prepared);
+            }
+            else if (Self)
+            {
+                Self->OnUINonStreamingResponse.Broadcast(TEXT("Cancelled: a newer message or ClearConversation replaced this one before it was sent."), false);
+            }
+        });
+#else
+    UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestNonStreamingChatWithImages will do nothing."));
+#endif
+}
+
+#if WITH_GENAI_MODULE
+void AGXOpenAIChatExample::SendNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<FGXImagePreprocessStats>& Images)
+{
+    // Fail fast instead of hammering an endpoint whose circuit breaker is open.
+    if (!UGXModelRouter::TryAcquireFor(this, EGXChatProvider::OpenAI, ModelName))
+    {
+        OnUINonStreamingResponse.Broadcast(FString::Printf(TEXT("%s is unavailable (circuit open). Try again later."), *ModelName), false);
+        return;
+    }
+
     if (!SystemPrompt.IsEmpty())
     {
         if (ConversationHistory.Num() > 0 && ConversationHistory[0].Role == TEXT("system"))
@@ -57,9 +110,11 @@ void AGXOpenAIChatExample::RequestNonStreamingChat(const FString& UserMessage, c
     TArray<FGenAIMessageContent> MessageContent;
     MessageContent.Add(FGenAIMessageContent::FromText(UserMessage));
     
-    if (Image != nullptr)
+    for (const FGXImagePreprocessStats& Prepared : Images)
     {
-        MessageContent.Add(FGenAIMessageContent::FromTexture2D(Image, EGenAIImageDetail::Auto));
+        MessageContent.Add(FGXImagePreprocessor::MakeImageContent(Prepared, EGXChatProvider::OpenAI, ImagePreprocessing));
+        SentImages.Add(Prepared.SentTexture);
+        OnImagePreprocessed.Broadcast(Prepared);
     }
 
     // 2. Add the complete user message to our history
@@ -75,12 +130,18 @@ void AGXOpenAIChatExample::RequestNonStreamingChat(const FString& UserMessage, c
     ChatSettings.bStream = false;
 
     // 4. Send the request using the static function and a lambda for the response
-    ActiveRequestNonStreaming = UGenOAIChat::SendChatRequest(
+    const uint32 Generation = NonStreamingWatchdog.Begin();
+    const FHttpRequestPtr Request = UGenOAIChat::SendChatRequest(
         ChatSettings,
         FOnChatCompletionResponse::CreateLambda(
-            [this](const FString& Response, const FString& ErrorMessage, bool bSuccess)
+            [this, ModelName, Generation](const FString& Response, const FString& ErrorMessage, bool bSuccess)
             {
                 if (!UGenUtils::IsContextStillValid(this)) return;
+                // The watchdog already gave up on this request and cleaned up after it.
+                if (!NonStreamingWatchdog.IsCurrent(Generation)) return;
+                NonStreamingWatchdog.Stop();
+
+                UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::OpenAI, ModelName, bSuccess);
                 
                 if (bSuccess)
                 {
@@ -99,14 +160,74 @@ void AGXOpenAIChatExample::RequestNonStreamingChat(const FString& UserMessage, c
                 ActiveRequestNonStreaming.Reset();
             })
     );
-#else
-    UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestNonStreamingChat will do nothing."));
-#endif
+
+    // 5. Enforce the deadlines; on expiry the request is cancelled and the turn rolled back
+    if (NonStreamingWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveRequestNonStreaming = Request;
+        NonStreamingWatchdog.Watch(ActiveRequestNonStreaming, RequestTimeouts, false, [this, ModelName](EGXTimeoutKind Kind)
+        {
+            UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::OpenAI, ModelName, false, true);
+            OnUINonStreamingResponse.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind), false);
+            ConversationHistory.Pop();
+            ActiveRequestNonStreaming.Reset();
+        });
+    }
 }
+#endif
 
 void AGXOpenAIChatExample::RequestStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, UTexture2D* Image)
 {
+    TArray<UTexture2D*> Images;
+    if (Image != nullptr)
+    {
+        Images.Add(Image);
+    }
+    RequestStreamingChatWithImages(UserMessage, ModelName, SystemPrompt, Images);
+}
+
+void AGXOpenAIChatExample::RequestStreamingChatWithImages(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<UTexture2D*>& Images)
+{
+#if WITH_GENAI_MODULE
+    const uint32 Generation = ++PrepareGeneration;
+    if (Images.Num() == 0)
+    {
+        SendStreamingChat(UserMessage, ModelName, SystemPrompt, {});
+        return;
+    }
+
+    // The attachments are resized concurrently off the game thread; the request goes out once all of them are ready.
+    TWeakObjectPtr<AGXOpenAIChatExample> WeakThis(this);
+    FGXImagePreprocessor::PrepareAllAsync(this, Images, EGXChatProvider::OpenAI, ModelName, ImagePreprocessing,
+        [WeakThis, Generation, UserMessage, ModelName, SystemPrompt](TArray<FGXImagePreprocessStats>&& Prepared)
+        {
+            // A later send or ClearConversation superseded this turn while its images were being prepared;
+            // the UI is told, so it does not wait on a reply that will never come.
+            AGXOpenAIChatExample* Self = WeakThis.Get();
+            if (Self && Self->PrepareGeneration == Generation)
+            {
+                Self->SendStreamingChat(UserMessage, ModelName, SystemPrompt, Prepared);
+            }
+            else if (Self)
+            {
+                Self->OnUIStreamingError.Broadcast(TEXT("Cancelled: a newer message or ClearConversation replaced this one before it was sent."));
+            }
+        });
+#else
+    UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestStreamingChatWithImages will do nothing."));
+#endif
+}
+
 #if WITH_GENAI_MODULE
+void AGXOpenAIChatExample::SendStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<FGXImagePreprocessStats>& Images)
+{
+    if (!UGXModelRouter::TryAcquireFor(this, EGXChatProvider::OpenAI, ModelName))
+    {
+        OnUIStreamingError.Broadcast(FString::Printf(TEXT("%s is unavailable (circuit open). Try again later."), *ModelName));
+        return;
+    }
+    ActiveStreamingModel = ModelName;
+
     if (!SystemPrompt.IsEmpty())
     {
         if (ConversationHistory.Num() > 0 && ConversationHistory[0].Role == TEXT("system"))
@@ -123,9 +244,11 @@ void AGXOpenAIChatExample::RequestStreamingChat(const FString& UserMessage, cons
     TArray<FGenAIMessageContent> MessageContent;
     MessageContent.Add(FGenAIMessageContent::FromText(UserMessage));
 
-    if (Image != nullptr)
+    for (const FGXImagePreprocessStats& Prepared : Images)
     {
-        MessageContent.Add(FGenAIMessageContent::FromTexture2D(Image, EGenAIImageDetail::Auto));
+        MessageContent.Add(FGXImagePreprocessor::MakeImageContent(Prepared, EGXChatProvider::OpenAI, ImagePreprocessing));
+        SentImages.Add(Prepared.SentTexture);
+        OnImagePreprocessed.Broadcast(Prepared);
     }
     
     // 2. Add to history
@@ -140,26 +263,42 @@ void AGXOpenAIChatExample::RequestStreamingChat(const FString& UserMessage, cons
     ChatSettings.bStream = true; // Implicitly handled, but good for clarity
 
     // 4. Send the request, binding our handler function to the delegate
-    ActiveRequestStreaming = UGenOAIChatStream::SendStreamChatRequest(
+    const uint32 Generation = StreamingWatchdog.Begin();
+    const FHttpRequestPtr Request = UGenOAIChatStream::SendStreamChatRequest(
         ChatSettings, 
-        FOnOpenAIChatStreamResponse::CreateUObject(this, &AGXOpenAIChatExample::OnStreamingChatEvent)
+        FOnOpenAIChatStreamResponse::CreateUObject(this, &AGXOpenAIChatExample::OnStreamingChatEvent, Generation)
     );
-#else
-    UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestStreamingChat will do nothing."));
-#endif
+
+    // 5. Enforce the deadlines; a stalled stream is cancelled and the turn rolled back
+    if (StreamingWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+    {
+        ActiveRequestStreaming = Request;
+        StreamingWatchdog.Watch(ActiveRequestStreaming, RequestTimeouts, true, [this](EGXTimeoutKind Kind)
+        {
+            UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::OpenAI, ActiveStreamingModel, false, true);
+            OnUIStreamingError.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind));
+            ConversationHistory.Pop();
+            ActiveRequestStreaming.Reset();
+        });
+    }
 }
+#endif
 
 #if WITH_GENAI_MODULE
-void AGXOpenAIChatExample::OnStreamingChatEvent(const FGenOpenAIStreamEvent& StreamEvent)
+void AGXOpenAIChatExample::OnStreamingChatEvent(const FGenOpenAIStreamEvent& StreamEvent, uint32 RequestGeneration)
 {
     if (!UGenUtils::IsContextStillValid(this)) return;
+    if (!StreamingWatchdog.IsCurrent(RequestGeneration)) return;
+    StreamingWatchdog.NotifyActivity();
 
     if (!StreamEvent.bSuccess)
     {
+        UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::OpenAI, ActiveStreamingModel, false);
         // Broadcast a specific error event for the UI
         OnUIStreamingError.Broadcast(StreamEvent.ErrorMessage);
         // Clean up on failure
         ConversationHistory.Pop(); 
+        StreamingWatchdog.Stop();
         ActiveRequestStreaming.Reset();
         return;
     }
@@ -176,15 +315,19 @@ void AGXOpenAIChatExample::OnStreamingChatEvent(const FGenOpenAIStreamEvent& Str
 
         case EOpenAIStreamEventType::ResponseCompleted:
             // The stream is done. The 'DeltaContent' now holds the rest of the message if any... 
+            UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::OpenAI, ActiveStreamingModel, true);
             ConversationHistory.Add(FGenChatMessage(TEXT("assistant"), StreamEvent.DeltaContent));
             OnUIStreamingResponseCompleted.Broadcast(StreamEvent.DeltaContent);
+            StreamingWatchdog.Stop();
             ActiveRequestStreaming.Reset();
             break;
 
         case EOpenAIStreamEventType::ResponseFailed:
         case EOpenAIStreamEventType::Error:
+             UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::OpenAI, ActiveStreamingModel, false);
              OnUIStreamingError.Broadcast(StreamEvent.ErrorMessage);
              ConversationHistory.Pop();
+             StreamingWatchdog.Stop();
              ActiveRequestStreaming.Reset();
              break;
         
@@ -198,6 +341,8 @@ void AGXOpenAIChatExample::OnStreamingChatEvent(const FGenOpenAIStreamEvent& Str
 void AGXOpenAIChatExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 #if WITH_GENAI_MODULE
+    NonStreamingWatchdog.Stop();
+    StreamingWatchdog.Stop();
     // Cancel any in-flight requests when the actor is destroyed to prevent crashes.
     if (ActiveRequestNonStreaming.IsValid() && ActiveRequestNonStreaming->GetStatus() == EHttpRequestStatus::Processing)
     {
@@ -6,7 +6,10 @@
 #include "Models/OpenAI/GenOAIImageGeneration.h"
 #include "Data/OpenAI/GenOAIImageStructs.h"
 #include "Utilities/GenUtils.h"
-#include "ImageUtils.h"
+#include "Common/GXImageCache.h"
+#include "Common/GXProgressiveImageRequest.h"
+#include "Common/GXTextureDecoder.h"
+#include "Common/GXTexturePool.h"
 #endif
 
 AGXOpenAIImageExample::AGXOpenAIImageExample()
@@ -14,15 +17,27 @@ AGXOpenAIImageExample::AGXOpenAIImageExample()
 #if WITH_GENAI_MODULE
 	PrimaryActorTick.bCanEverTick = false;
 #endif
+	RequestTimeouts.ConnectSeconds = 30.f;
+	RequestTimeouts.TotalSeconds = 240.f;
 }
 
 void AGXOpenAIImageExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 #if WITH_GENAI_MODULE
+	// Invalidates a pending cache load as well as the request.
+	Watchdog.Begin();
+	bLoadingFromCache = false;
 	if (ActiveRequest.IsValid() && ActiveRequest->GetStatus() == EHttpRequestStatus::Processing)
 	{
 		ActiveRequest->CancelRequest();
 	}
+
+	UGXTexturePool* Pool = UGXTexturePool::Get(this);
+	if (Pool && DeliveredTexture)
+	{
+		Pool->ReleaseTexture(DeliveredTexture);
+	}
+	DeliveredTexture = nullptr;
 #endif
 	Super::EndPlay(EndPlayReason);
 }
@@ -30,7 +45,7 @@ void AGXOpenAIImageExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 void AGXOpenAIImageExample::RequestOpenAIImage(const FString& Prompt, const FString& ModelName)
 {
 #if WITH_GENAI_MODULE
-	if (ActiveRequest.IsValid()) return;
+	if (ActiveRequest.IsValid() || bLoadingFromCache) return;
 
 	FGenOAIImageSettings Settings;
 	Settings.Prompt = Prompt;
@@ -44,25 +59,227 @@ void AGXOpenAIImageExample::RequestOpenAIImage(const FString& Prompt, const FStr
 		Settings.Quality = EGenAIImageQuality::Medium;
 	}
 
-	ActiveRequest = UGenOAIImageGeneration::SendImageGenerationRequest(Settings, FOnImageGenerationCompletionResponse::CreateUObject(this, &AGXOpenAIImageExample::OnImageResponse));
+	// Everything that changes the output is part of the key.
+	ActiveCacheKey = bUseImageCache ? FGXImageCache::MakeKey(TEXT("OpenAI"), ModelName, Prompt, { TEXT("1024x1024"), FString::FromInt(static_cast<int32>(Settings.Quality)) }) : FString();
+	if (!ActiveCacheKey.IsEmpty() && FGXImageCache::Contains(ActiveCacheKey))
+	{
+		bLoadingFromCache = true;
+		const uint32 Generation = Watchdog.Begin();
+		TWeakObjectPtr<AGXOpenAIImageExample> WeakThis(this);
+		FGXImageCache::LoadAsync(ActiveCacheKey, CacheMaxDimension, [WeakThis, Generation, Settings](UTexture2D* Texture)
+		{
+			if (!WeakThis.IsValid() || !WeakThis->Watchdog.IsCurrent(Generation)) return;
+			WeakThis->bLoadingFromCache = false;
+
+			if (Texture)
+			{
+				WeakThis->DeliverImage(Texture);
+			}
+			else
+			{
+				// The entry was damaged and has been removed; generate the image instead.
+				WeakThis->SendImageRequest(Settings);
+			}
+		});
+		return;
+	}
+
+	SendImageRequest(Settings);
 #else
 	UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestOpenAIImage will do nothing."));
 #endif
 }
 
+void AGXOpenAIImageExample::RequestOpenAIImageProgressive(const FString& Prompt, const FString& ModelName, int32 PartialImages)
+{
 #if WITH_GENAI_MODULE
-void AGXOpenAIImageExample::OnImageResponse(const TArray<uint8>& ImageBytes, const FString& Error, bool bSuccess)
+	if (ActiveRequest.IsValid() || bLoadingFromCache) return;
+
+	const uint32 Generation = Watchdog.Begin();
+	LastProgressiveIndex = INDEX_NONE;
+
+	TWeakObjectPtr<AGXOpenAIImageExample> WeakThis(this);
+	FGXProgressiveImageCallbacks Callbacks;
+	Callbacks.OnActivity = [WeakThis, Generation]()
+	{
+		if (WeakThis.IsValid() && WeakThis->Watchdog.IsCurrent(Generation))
+		{
+			WeakThis->Watchdog.NotifyActivity();
+		}
+	};
+	Callbacks.OnPartialImage = [WeakThis, Generation](TArray<uint8>&& ImageBytes, int32 PartialIndex)
+	{
+		if (WeakThis.IsValid() && WeakThis->Watchdog.IsCurrent(Generation))
+		{
+			WeakThis->ApplyProgressiveImage(MoveTemp(ImageBytes), PartialIndex, Generation);
+		}
+	};
+	Callbacks.OnComplete = [WeakThis, Generation](TArray<uint8>&& ImageBytes, const FString& Error, bool bSuccess)
+	{
+		if (!WeakThis.IsValid() || !WeakThis->Watchdog.IsCurrent(Generation)) return;
+		WeakThis->Watchdog.Stop();
+
+		if (!bSuccess)
+		{
+			WeakThis->ActiveRequest.Reset();
+			WeakThis->OnImageGenerationError.Broadcast(Error);
+			return;
+		}
+		WeakThis->ApplyProgressiveImage(MoveTemp(ImageBytes), INDEX_NONE, Generation);
+	};
+
+	const FHttpRequestPtr Request = FGXProgressiveImageRequest::Send(Prompt, ModelName, PartialImages, TEXT("1024x1024"), TEXT("medium"), MoveTemp(Callbacks));
+	if (!Request.IsValid())
+	{
+		Watchdog.Stop();
+		OnImageGenerationError.Broadcast(TEXT("No OpenAI API key is configured."));
+		return;
+	}
+	if (Watchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+	{
+		ActiveRequest = Request;
+		Watchdog.Watch(ActiveRequest, RequestTimeouts, true, [this](EGXTimeoutKind Kind)
+		{
+			ActiveRequest.Reset();
+			OnImageGenerationError.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind));
+		});
+	}
+#else
+	UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestOpenAIImageProgressive will do nothing."));
+#endif
+}
+
+#if WITH_GENAI_MODULE
+void AGXOpenAIImageExample::DeliverImage(UTexture2D* Texture)
 {
-	if (bSuccess)
+	// Compressed and cached textures are created outside the pool's factory; registering an already pooled one is a no-op.
+	if (UGXTexturePool* Pool = UGXTexturePool::Get(this))
 	{
-		// Use the engine's built-in utility to create the texture
-		UTexture2D* Texture = FImageUtils::ImportBufferAsTexture2D(ImageBytes);
-		OnImageGenerated.Broadcast(Texture, true);
+		Pool->RegisterTexture(Texture);
+		if (DeliveredTexture && DeliveredTexture != Texture)
+		{
+			Pool->ReleaseTexture(DeliveredTexture);
+		}
 	}
-	else
+	DeliveredTexture = Texture;
+	OnImageGenerated.Broadcast(Texture, true);
+}
+
+void AGXOpenAIImageExample::SendImageRequest(const FGenOAIImageSettings& Settings)
+{
+	const uint32 Generation = Watchdog.Begin();
+	const FHttpRequestPtr Request = UGenOAIImageGeneration::SendImageGenerationRequest(Settings, FOnImageGenerationCompletionResponse::CreateUObject(this, &AGXOpenAIImageExample::OnImageResponse, Generation));
+	if (Watchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+	{
+		ActiveRequest = Request;
+		Watchdog.Watch(ActiveRequest, RequestTimeouts, false, [this](EGXTimeoutKind Kind)
+		{
+			ActiveRequest.Reset();
+			OnImageGenerationError.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind));
+		});
+	}
+}
+
+void AGXOpenAIImageExample::ApplyProgressiveImage(TArray<uint8>&& ImageBytes, int32 PartialIndex, uint32 RequestGeneration)
+{
+	TWeakObjectPtr<AGXOpenAIImageExample> WeakThis(this);
+	FGXTextureDecoder::DecodePixelsAsync(MoveTemp(ImageBytes), [WeakThis, PartialIndex, RequestGeneration](TArray64<uint8>&& Pixels, int32 Width, int32 Height, const FString& DecodeError)
+	{
+		if (!WeakThis.IsValid() || !WeakThis->Watchdog.IsCurrent(RequestGeneration)) return;
+
+		// Decodes can finish out of order; never let an older preview overwrite a newer one or the final image.
+		const bool bFinal = PartialIndex == INDEX_NONE;
+		if (!bFinal && PartialIndex <= WeakThis->LastProgressiveIndex) return;
+		WeakThis->LastProgressiveIndex = bFinal ? MAX_int32 : PartialIndex;
+
+		if (!DecodeError.IsEmpty())
+		{
+			if (bFinal)
+			{
+				WeakThis->ActiveRequest.Reset();
+				WeakThis->OnImageGenerationError.Broadcast(DecodeError);
+			}
+			return;
+		}
+
+		if (bFinal)
+		{
+			// The final image is a pooled texture of its own, like a non-progressive result; the preview texture is
+			// let go so the next request's previews cannot overwrite an image the caller already has.
+			WeakThis->ProgressiveTexture = nullptr;
+			UGXTexturePool* Pool = UGXTexturePool::Get(WeakThis.Get());
+			UTexture2D* Final = Pool ? Pool->CreateTexture(MoveTemp(Pixels), Width, Height) : FGXTextureDecoder::CreateTexture(Pixels, Width, Height);
+			if (!Final)
+			{
+				WeakThis->ActiveRequest.Reset();
+				WeakThis->OnImageGenerationError.Broadcast(TEXT("Failed to create the image texture."));
+				return;
+			}
+
+			// ActiveRequest stays set until the texture is on the GPU, as for non-progressive results.
+			FGXTextureDecoder::WhenRenderResourceReady(Final, [WeakThis, RequestGeneration](UTexture* Ready)
+			{
+				if (!WeakThis.IsValid() || !WeakThis->Watchdog.IsCurrent(RequestGeneration)) return;
+				WeakThis->ActiveRequest.Reset();
+				WeakThis->DeliverImage(Cast<UTexture2D>(Ready));
+			});
+			return;
+		}
+
+		// Same size: overwrite the pixels of the existing resource. Otherwise this is the first preview or the size changed.
+		TObjectPtr<UTexture2D>& Texture = WeakThis->ProgressiveTexture;
+		if (!FGXTextureDecoder::UpdateTexture(Texture, MoveTemp(Pixels), Width, Height))
+		{
+			Texture = FGXTextureDecoder::CreateTexture(Pixels, Width, Height);
+		}
+		if (Texture)
+		{
+			WeakThis->OnImageGenerationProgress.Broadcast(Texture, PartialIndex);
+		}
+	});
+}
+
+void AGXOpenAIImageExample::OnImageResponse(const TArray<uint8>& ImageBytes, const FString& Error, bool bSuccess, uint32 RequestGeneration)
+{
+	// A response that arrives after the watchdog gave up belongs to nobody.
+	if (!Watchdog.IsCurrent(RequestGeneration)) return;
+	Watchdog.Stop();
+
+	if (!bSuccess)
 	{
 		OnImageGenerationError.Broadcast(Error);
+		ActiveRequest.Reset();
+		return;
+	}
+
+	// Fresh images go to the cache straight from the decode worker.
+	FGXOnPixelsReady StoreInCache;
+	if (!ActiveCacheKey.IsEmpty())
+	{
+		StoreInCache = [Key = ActiveCacheKey](const TArray64<uint8>& Pixels, int32 Width, int32 Height)
+		{
+			FGXImageCache::StoreAsync(Key, TArray64<uint8>(Pixels), Width, Height);
+		};
 	}
-	ActiveRequest.Reset();
+
+	// Decode off the game thread. ActiveRequest stays set until the texture is delivered, so the
+	// generation cannot change and a second request cannot start meanwhile.
+	TWeakObjectPtr<AGXOpenAIImageExample> WeakThis(this);
+	FGXTextureDecoder::DecodeAsync(ImageBytes, [WeakThis, RequestGeneration](UTexture2D* Texture, const FString& DecodeError, const FGXTextureDecodeTiming& Timing)
+	{
+		if (!WeakThis.IsValid() || !WeakThis->Watchdog.IsCurrent(RequestGeneration)) return;
+		WeakThis->ActiveRequest.Reset();
+
+		if (!Texture)
+		{
+			WeakThis->OnImageGenerationError.Broadcast(DecodeError);
+			return;
+		}
+		UE_LOG(LogTemp, Log, TEXT("Image %dx%d ready: decode %.1f ms, compress %.1f ms, game thread %.2f ms, total %.1f ms, %lld KB resident"),
+			Timing.Width, Timing.Height, Timing.DecodeMs, Timing.CompressMs, Timing.GameThreadMs, Timing.TotalMs, Timing.TextureBytes / 1024);
+		WeakThis->OnImageDecodeTimings.Broadcast(Timing.DecodeMs, Timing.CompressMs, Timing.GameThreadMs, Timing.TotalMs);
+
+		WeakThis->DeliverImage(Texture);
+	}, MoveTemp(StoreInCache), UGXTexturePool::MakeFactory(this), TextureCompression);
 }
 #endif
@@ -1,17 +1,31 @@
 // Copyright 2025, Muddy Terrain Games, All Rights Reserved.
 
 #include "OpenAI/GXOpenAIRealtimeExample.h"
+#include "OpenAI/GXRealtimeReplayHarness.h"
 
 #if WITH_GENAI_MODULE
-#include "Components/RealtimeAudioCaptureComponent.h"
 #include "Models/OpenAI/GenOAIRealtime.h"
-#include "Sound/SoundWaveProcedural.h"
+#include "Common/GXRealtimeSpeechWave.h"
 #include "Sound/SoundSubmix.h"
 #include "Engine/Engine.h"
-#include "Utilities/GenAIAudioUtils.h"
 #include "Async/Async.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogRealtimeFSM, Log, All);
+
+namespace
+{
+    /**
+     * Audio and transcript deltas of one response arrive back to back, faster than real time. After a barge-in,
+     * the first delta following a pause this long once the turn is committed is taken as the start of the reply
+     * to that turn.
+     *
+     * A heuristic: the plugin's response delegates carry no response or item id to key the discard on, only the
+     * speech events do. It fails both ways. A reply that starts within this gap of the interrupted response's last
+     * delta is dropped whole, and the session stays silent until the user speaks again. A network stall longer
+     * than the gap inside the interrupted response lets the rest of it through as if it were the reply.
+     */
+    constexpr double GResponseGapSeconds = 0.25;
+}
 #endif
 
 AGXOpenAIRealtimeExample::AGXOpenAIRealtimeExample()
@@ -28,13 +42,6 @@ void AGXOpenAIRealtimeExample::BeginPlay()
 {
     Super::BeginPlay();
 #if WITH_GENAI_MODULE
-    // Dynamically create the audio capture component here to ensure the audio engine is ready.
-    AudioCapture = NewObject<URealtimeAudioCaptureComponent>(this, TEXT("AudioCapture"));
-    if (AudioCapture)
-    {
-        AudioCapture->RegisterComponent(); // Important to register the new component
-    }
-    
     RealtimeService = UGenOAIRealtime::CreateRealtimeService(this);
     if (auto* Service = Cast<UGenOAIRealtime>(RealtimeService))
     {
@@ -48,22 +55,31 @@ void AGXOpenAIRealtimeExample::BeginPlay()
         Service->OnServerSpeechStoppedBP.AddDynamic(this, &AGXOpenAIRealtimeExample::HandleServerSpeechStopped);
     }
 
-    if (auto* Capture = Cast<URealtimeAudioCaptureComponent>(AudioCapture))
-    {
-        Capture->OnAudioGenerated_Native.AddUObject(this, &AGXOpenAIRealtimeExample::HandleAudioGenerated);
-    }
-    
     if (AIAudioPlayer)
     {
         AIAudioPlayer->OnAudioFinished.AddDynamic(this, &AGXOpenAIRealtimeExample::OnAIAudioFinished);
     }
+
+    TWeakObjectPtr<AGXOpenAIRealtimeExample> WeakThis(this);
+    TurnLatency.SetOnTurnComplete([WeakThis](const FGXVoiceTurnTimings& Timings)
+    {
+        if (AGXOpenAIRealtimeExample* This = WeakThis.Get())
+        {
+            if (This->Replay) This->Replay->ReceiveTurnTimings(Timings);
+            This->OnVoiceTurnTimings.Broadcast(Timings);
+        }
+    });
 #endif
 }
 
 void AGXOpenAIRealtimeExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 #if WITH_GENAI_MODULE
+    StateWatchdog.Stop();
+    StopReplay();
     ToggleConversation(false);
+    ReleaseCapture();
+    MicSender.Shutdown(false);
 #endif
     Super::EndPlay(EndPlayReason);
 }
@@ -90,9 +106,17 @@ void AGXOpenAIRealtimeExample::Tick(float DeltaSeconds)
     {
         OnAssistantTranscriptUpdated.Broadcast(AssistantTranscript);
     }
+
+    // Turns complete on the audio render thread; they are reported from here.
+    TurnLatency.PublishCompletedTurn();
 #endif
 }
 
+FGXSpeechPlayoutStats AGXOpenAIRealtimeExample::GetSpeechPlayoutStats() const
+{
+    return AIResponseWave ? AIResponseWave->GetStats() : FGXSpeechPlayoutStats();
+}
+
 void AGXOpenAIRealtimeExample::ToggleConversation(bool bShouldStart, const FString& Model, const FString& SystemPrompt)
 {
 #if WITH_GENAI_MODULE
@@ -125,25 +149,177 @@ void AGXOpenAIRealtimeExample::ToggleConversation(bool bShouldStart, const FStri
 #endif
 }
 
+bool AGXOpenAIRealtimeExample::StartReplay(const FString& WavPath, const FString& EventScriptPath, float Speed)
+{
+    return StartReplayWithBudgets(WavPath, EventScriptPath, Speed, FGXReplayBudgets());
+}
+
+bool AGXOpenAIRealtimeExample::StartReplayWithBudgets(const FString& WavPath, const FString& EventScriptPath, float Speed, const FGXReplayBudgets& Budgets)
+{
+#if WITH_GENAI_MODULE
+    if (CurrentState != ERealtimeConversationState::Idle)
+    {
+        UE_LOG(LogRealtimeFSM, Warning, TEXT("End the conversation before starting a replay."));
+        return false;
+    }
+
+    TSharedPtr<FGXRealtimeReplayHarness> Harness = MakeShared<FGXRealtimeReplayHarness>(this);
+    FString Error;
+    if (!Harness->Load(WavPath, EventScriptPath, Error))
+    {
+        UE_LOG(LogRealtimeFSM, Error, TEXT("Replay: %s"), *Error);
+        return false;
+    }
+
+    UGXVoiceCaptureSubsystem* Capture = UGXVoiceCaptureSubsystem::Get(this);
+    if (!Capture)
+    {
+        UE_LOG(LogRealtimeFSM, Error, TEXT("Replay: this world has no voice capture subsystem to inject the audio into."));
+        return false;
+    }
+
+    // The WAV goes through the shared capture in place of the microphone, so the replay measures the same
+    // conversion, pooling and focus path as a live session. This session takes the focus for the run.
+    Replay = Harness;
+    StartSession();
+    Capture->SetInjectedInput(true);
+    AcquireCapture();
+    Capture->SetFocusedActor(this);
+    SetState(ERealtimeConversationState::Connected_Ready);
+    if (!Harness->Start(Speed, Budgets))
+    {
+        // Unwinds the session and the injected input; callers such as the console command fail the run.
+        StopReplay();
+        return false;
+    }
+    return true;
+#else
+    UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. StartReplayWithBudgets will do nothing."));
+    return false;
+#endif
+}
+
+void AGXOpenAIRealtimeExample::StopReplay()
+{
+#if WITH_GENAI_MODULE
+    if (!Replay) return;
+
+    // The feed thread goes first, then SetState joins the sender, so neither can reach the harness once it is released.
+    Replay->Shutdown();
+    SetState(ERealtimeConversationState::Idle);
+    Replay.Reset();
+
+    // Live sessions go back to proximity focus and the microphone.
+    if (UGXVoiceCaptureSubsystem* Capture = UGXVoiceCaptureSubsystem::Get(this))
+    {
+        Capture->SetFocusedActor(nullptr);
+        Capture->SetInjectedInput(false);
+    }
+#endif
+}
+
 #if WITH_GENAI_MODULE
 void AGXOpenAIRealtimeExample::HandleRealtimeConnected(const FString& SessionId)
 {
-    AIResponseWave = NewObject<USoundWaveProcedural>();
-    AIResponseWave->SetSampleRate(24000);
-    AIResponseWave->NumChannels = 1;
-    AIResponseWave->Duration = INDEFINITELY_LOOPING_DURATION;
-    AIResponseWave->SoundGroup = SOUNDGROUP_Voice;
-    AIResponseWave->bLooping = false;
-    AIAudioPlayer->SetSound(AIResponseWave);
+    // A repeated connect event must not leave the previous registration delivering into the restarted session.
+    ReleaseCapture();
+    StartSession();
 
-    if (auto* Capture = Cast<URealtimeAudioCaptureComponent>(AudioCapture))
+    if (!AcquireCapture())
+    {
+        UE_LOG(LogRealtimeFSM, Warning, TEXT("No microphone; the session can only receive."));
+    }
+    else if (!UGXVoiceCaptureSubsystem::Get(this)->IsFocused(this))
     {
-        Capture->Activate();
+        UE_LOG(LogRealtimeFSM, Warning, TEXT("Connected without the microphone: another session is nearer or focused. Call SetFocusedActor on the voice capture subsystem to talk to this one."));
     }
     
     SetState(ERealtimeConversationState::Connected_Ready);
 }
 
+void AGXOpenAIRealtimeExample::StartSession()
+{
+    // The speech wave plays silence between responses, so the player runs for the whole session and a
+    // response starts on the next audio callback instead of waiting for the game thread to call Play().
+    TWeakObjectPtr<AGXOpenAIRealtimeExample> WeakThis(this);
+    AIResponseWave = NewObject<UGXRealtimeSpeechWave>(this);
+    AIResponseWave->Initialize(24000, 60.f, SpeechPlayout, [WeakThis]()
+    {
+        if (AGXOpenAIRealtimeExample* This = WeakThis.Get()) This->OnAIAudioFinished();
+    }, [WeakThis](const FGXSpeechInterruption& Interruption)
+    {
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Interruption]()
+        {
+            if (AGXOpenAIRealtimeExample* This = WeakThis.Get())
+            {
+                UE_LOG(LogRealtimeFSM, Log, TEXT("Barge-in: assistant silenced %.0f ms after the user started talking; %.0f ms heard, %.0f ms discarded."),
+                    Interruption.LatencyMs, Interruption.PlayedMs, Interruption.DiscardedMs);
+                This->OnAssistantInterrupted.Broadcast(Interruption);
+            }
+        });
+    }, [WeakThis]()
+    {
+        if (AGXOpenAIRealtimeExample* This = WeakThis.Get()) This->TurnLatency.Mark(EGXVoiceStage::FirstAudioAudible);
+    });
+    TurnLatency.Reset();
+    bDiscardResponseAudio = false;
+    DiscardTurnCommittedSeconds = 0.0;
+    LastResponseDeltaSeconds = 0.0;
+    AIAudioPlayer->SetSound(AIResponseWave);
+    AIAudioPlayer->Play();
+
+    FGXVoiceActivityConfig VADConfig;
+    VADConfig.SampleRate = 24000;
+    VADConfig.ThresholdDb = LocalVADThresholdDb;
+    VADConfig.SilenceMs = ServerVADSilenceMs;
+    VADConfig.PrefixPaddingMs = ServerVADPrefixPaddingMs;
+    MicVAD.Configure(VADConfig);
+
+    // With local VAD the session has no server-side turn detection, so each turn is committed here once
+    // its last frame has gone out. Committing from the sender thread keeps it behind that audio.
+    // The sender is joined before this actor goes away, so it can call back into it directly.
+    FGXAudioFrameSender::FOnFlushed CommitTurn;
+    if (bEnableLocalVAD)
+    {
+        CommitTurn = [this]() { CommitUserTurn(); };
+    }
+    MicSender.Start(24000, MicFrameMs, 2.f, [this](const TArray<uint8>& Frame) { SendMicFrame(Frame); }, MoveTemp(CommitTurn));
+}
+
+void AGXOpenAIRealtimeExample::SendMicFrame(const TArray<uint8>& Frame)
+{
+    if (Replay)
+    {
+        Replay->ReceiveAudio(Frame);
+    }
+    else if (auto* Service = Cast<UGenOAIRealtime>(RealtimeService))
+    {
+        Service->SendAudioToServer(Frame);
+    }
+}
+
+void AGXOpenAIRealtimeExample::CommitUserTurn()
+{
+    if (Replay)
+    {
+        Replay->ReceiveCommit();
+    }
+    else if (auto* Service = Cast<UGenOAIRealtime>(RealtimeService))
+    {
+        Service->CommitAudioBuffer();
+        if (bServerVADCreateResponse) Service->RequestModelResponse();
+    }
+    else
+    {
+        return;
+    }
+    if (bDiscardResponseAudio.load(std::memory_order_relaxed))
+    {
+        DiscardTurnCommittedSeconds.store(FPlatformTime::Seconds(), std::memory_order_relaxed);
+    }
+    TurnLatency.Mark(EGXVoiceStage::TurnCommitted);
+}
+
 void AGXOpenAIRealtimeExample::HandleRealtimeConnectionError(int32 StatusCode, const FString& Reason, bool bWasClean)
 {
     UE_LOG(LogRealtimeFSM, Error, TEXT("Connection Error: %s"), *Reason);
@@ -155,53 +331,147 @@ void AGXOpenAIRealtimeExample::HandleRealtimeDisconnected()
     SetState(ERealtimeConversationState::Idle);
 }
 
+bool AGXOpenAIRealtimeExample::AcceptResponseDelta()
+{
+    const double Now = FPlatformTime::Seconds();
+    const double PreviousDeltaSeconds = LastResponseDeltaSeconds.exchange(Now, std::memory_order_relaxed);
+    if (!bDiscardResponseAudio.load(std::memory_order_relaxed)) return true;
+
+    const double CommittedSeconds = DiscardTurnCommittedSeconds.load(std::memory_order_relaxed);
+    if (CommittedSeconds <= 0.0 || Now - PreviousDeltaSeconds < GResponseGapSeconds) return false;
+
+    DiscardTurnCommittedSeconds.store(0.0, std::memory_order_relaxed);
+    bDiscardResponseAudio = false;
+    return true;
+}
+
 void AGXOpenAIRealtimeExample::HandleRealtimeAudioResponse(const TArray<uint8>& AudioData)
 {
-    AsyncTask(ENamedThreads::GameThread, [this, AudioData]()
+    // Stamped before any early out, so an interrupted response still streaming during the user's turn keeps
+    // its gap short and is not mistaken for the reply.
+    const bool bAccepted = AcceptResponseDelta();
+
+    // Audio goes straight to the audio render thread; only the state change is posted to the game thread.
+    // Connected_Ready is accepted too, in case the network paused long enough for playback to drain.
+    const ERealtimeConversationState State = CurrentState;
+    if (State != ERealtimeConversationState::WaitingForAI && State != ERealtimeConversationState::SpeakingAI
+        && State != ERealtimeConversationState::Connected_Ready)
     {
-        if (CurrentState == ERealtimeConversationState::WaitingForAI)
-        {
-            SetState(ERealtimeConversationState::SpeakingAI);
-        }
-        
-        if (CurrentState == ERealtimeConversationState::SpeakingAI && AIResponseWave)
+        return;
+    }
+    if (!AIResponseWave) return;
+
+    if (!bAccepted) return;
+
+    TurnLatency.Mark(EGXVoiceStage::FirstResponseByte);
+    AIResponseWave->Enqueue(AudioData.GetData(), AudioData.Num());
+    TurnLatency.Mark(EGXVoiceStage::FirstAudioQueued);
+
+    if (State != ERealtimeConversationState::SpeakingAI)
+    {
+        AsyncTask(ENamedThreads::GameThread, [this]()
         {
-            AIResponseWave->QueueAudio(AudioData.GetData(), AudioData.Num());
-            if (AIAudioPlayer && !AIAudioPlayer->IsPlaying())
+            if (CurrentState == ERealtimeConversationState::WaitingForAI || CurrentState == ERealtimeConversationState::Connected_Ready)
             {
-                AIAudioPlayer->Play();
+                SetState(ERealtimeConversationState::SpeakingAI);
             }
-        }
-    });
+        });
+    }
 }
 
-void AGXOpenAIRealtimeExample::HandleAudioGenerated(const float* InAudio, int32 NumSamples)
+void AGXOpenAIRealtimeExample::HandleMicPCM(const int16* PCM, int32 NumPCM)
 {
     if (CurrentState != ERealtimeConversationState::Idle && CurrentState != ERealtimeConversationState::Connecting)
     {
-        if (auto* Service = Cast<UGenOAIRealtime>(RealtimeService))
+        // Both reuse their buffers, so the capture thread neither allocates nor waits on the socket here.
+        if (!bEnableLocalVAD)
         {
-            
-            const TArray<uint8> ConvertedAudio = UGenAIAudioUtils::ConvertAudioToPCM16Mono24kHz(InAudio, NumSamples, 2);
-            if(ConvertedAudio.Num() > 0)
+            MicSender.Push(PCM, NumPCM);
+
+            float Energy = 0.f;
+            for (int32 Index = 0; Index < NumPCM; ++Index)
             {
-                UE_LOG(LogRealtimeFSM, Verbose, TEXT("Sending %d samples of audio to server."), NumSamples);
-                
-                Service->SendAudioToServer(ConvertedAudio);
+                const float Sample = PCM[Index] / 32768.f;
+                Energy += Sample * Sample;
             }
+            DisplayMicRms.store(NumPCM > 0 ? FMath::Sqrt(Energy / NumPCM) : 0.f, std::memory_order_relaxed);
+            return;
         }
+
+        // Turn boundaries reuse the server VAD handlers, which move onto the game thread themselves.
+        MicVAD.Process(PCM, NumPCM,
+            [this](const int16* Samples, int32 Num) { MicSender.Push(Samples, Num); },
+            [this](EGXVoiceActivityEvent Event)
+            {
+                if (Event == EGXVoiceActivityEvent::SpeechStarted)
+                {
+                    // Silence the assistant from here rather than after a game-thread hop; the rest of its
+                    // reply is stale, and is dropped as it arrives until the reply to this turn starts.
+                    DiscardTurnCommittedSeconds.store(0.0, std::memory_order_relaxed);
+                    bDiscardResponseAudio = true;
+                    if (AIResponseWave) AIResponseWave->Interrupt(FPlatformTime::Seconds() - MicVAD.GetStartDelayMs() * 0.001);
+                    HandleServerSpeechStarted(FString());
+                }
+                else
+                {
+                    TurnLatency.BeginTurn(FPlatformTime::Seconds() - MicVAD.GetStopDelayMs() * 0.001);
+                    MicSender.Flush();
+                    HandleServerSpeechStopped(FString());
+                }
+            });
+        DisplayMicRms.store(MicVAD.GetLevel(), std::memory_order_relaxed);
+    }
+}
+
+void AGXOpenAIRealtimeExample::HandleCaptureFocusChanged(bool bFocused)
+{
+    UE_LOG(LogRealtimeFSM, Log, TEXT("%s the microphone."), bFocused ? TEXT("Gained") : TEXT("Lost"));
+    if (bFocused) return;
+
+    // No more audio arrives, so a turn in progress is ended as if the user had paused.
+    if (bEnableLocalVAD && MicVAD.IsSpeaking())
+    {
+        MicVAD.Reset();
+        TurnLatency.BeginTurn(FPlatformTime::Seconds());
+        MicSender.Flush();
+        HandleServerSpeechStopped(FString());
+    }
+    DisplayMicRms.store(0.f, std::memory_order_relaxed);
+}
+
+bool AGXOpenAIRealtimeExample::AcquireCapture()
+{
+    // The microphone is opened and converted once per world and only reaches this session while it has focus.
+    UGXVoiceCaptureSubsystem* Capture = UGXVoiceCaptureSubsystem::Get(this);
+    if (!Capture) return false;
+
+    CaptureListener = Capture->AddListener(this,
+        [this](const FGXCapturedFrameRef& Frame) { HandleMicPCM(Frame->GetSamples(), Frame->GetNumSamples()); },
+        [this](bool bFocused) { HandleCaptureFocusChanged(bFocused); });
+    return CaptureListener != INDEX_NONE;
+}
+
+void AGXOpenAIRealtimeExample::ReleaseCapture()
+{
+    if (CaptureListener == INDEX_NONE) return;
+
+    if (UGXVoiceCaptureSubsystem* Capture = UGXVoiceCaptureSubsystem::Get(this))
+    {
+        Capture->RemoveListener(CaptureListener);
     }
+    CaptureListener = INDEX_NONE;
 }
 
 void AGXOpenAIRealtimeExample::HandleServerSpeechStarted(const FString& ItemId)
 {
     AsyncTask(ENamedThreads::GameThread, [this]()
     {
-        if (CurrentState == ERealtimeConversationState::SpeakingAI)
+        // The local VAD has already interrupted playout, from the moment speech began; a second request here would
+        // restart the barge-in latency from this later hop.
+        if (CurrentState == ERealtimeConversationState::SpeakingAI && !bDiscardResponseAudio.load(std::memory_order_relaxed))
         {
             UE_LOG(LogRealtimeFSM, Warning, TEXT("Barge-in: Stopping current AI speech."));
-            if (AIAudioPlayer) AIAudioPlayer->Stop();
-            if (AIResponseWave) AIResponseWave->ResetAudio();
+            if (AIResponseWave) AIResponseWave->Interrupt();
         }
         
         FullUserTranscript.Empty();
@@ -215,6 +485,9 @@ void AGXOpenAIRealtimeExample::HandleServerSpeechStarted(const FString& ItemId)
 
 void AGXOpenAIRealtimeExample::HandleServerSpeechStopped(const FString& ItemId)
 {
+    // The local VAD calls this without an item; only the server's own event is a server VAD stamp.
+    if (!ItemId.IsEmpty()) TurnLatency.Mark(EGXVoiceStage::ServerSpeechStopped);
+
     AsyncTask(ENamedThreads::GameThread, [this]()
     {
         if (CurrentState == ERealtimeConversationState::UserIsSpeaking)
@@ -236,7 +509,14 @@ void AGXOpenAIRealtimeExample::OnAIAudioFinished()
 }
 
 void AGXOpenAIRealtimeExample::HandleUserTranscriptDelta(const FString& TranscriptDelta) { PendingUserTranscriptDeltas.Enqueue(TranscriptDelta); }
-void AGXOpenAIRealtimeExample::HandleAssistantTranscriptDelta(const FString& TranscriptDelta) { PendingAssistantTranscriptDeltas.Enqueue(TranscriptDelta); }
+void AGXOpenAIRealtimeExample::HandleAssistantTranscriptDelta(const FString& TranscriptDelta)
+{
+    // Text of an interrupted response is dropped with its audio, and must not stamp the next turn's latency.
+    if (!AcceptResponseDelta()) return;
+
+    TurnLatency.Mark(EGXVoiceStage::FirstResponseByte);
+    PendingAssistantTranscriptDeltas.Enqueue(TranscriptDelta);
+}
 
 void AGXOpenAIRealtimeExample::SetState(ERealtimeConversationState NewState)
 {
@@ -246,26 +526,60 @@ void AGXOpenAIRealtimeExample::SetState(ERealtimeConversationState NewState)
     CurrentState = NewState;
     OnStateChanged.Broadcast(NewState);
 
-    if (NewState == ERealtimeConversationState::Idle)
+    // Only the states that wait on the server have a deadline; entering any other state ends it.
+    StateWatchdog.Begin();
+    if (NewState == ERealtimeConversationState::Connecting)
     {
-        if (auto* Capture = Cast<URealtimeAudioCaptureComponent>(AudioCapture))
+        FGXRequestTimeouts Timeouts;
+        Timeouts.ConnectSeconds = RequestTimeouts.ConnectSeconds;
+        Timeouts.FirstByteSeconds = Timeouts.IdleSeconds = Timeouts.TotalSeconds = 0.f;
+        StateWatchdog.Watch([this]()
         {
-            if (Capture->IsActive()) Capture->Deactivate();
-        }
+            if (auto* Service = Cast<UGenOAIRealtime>(RealtimeService)) Service->DisconnectFromServer();
+        }, Timeouts, false, [this](EGXTimeoutKind Kind)
+        {
+            UE_LOG(LogRealtimeFSM, Error, TEXT("%s"), *FGXRequestWatchdog::DescribeTimeout(Kind));
+            SetState(ERealtimeConversationState::Idle);
+        });
+    }
+    else if (NewState == ERealtimeConversationState::WaitingForAI && RequestTimeouts.FirstByteSeconds > 0.f)
+    {
+        // Measured as a total limit: nothing but the first audio chunk ends this state.
+        FGXRequestTimeouts Timeouts;
+        Timeouts.ConnectSeconds = Timeouts.FirstByteSeconds = Timeouts.IdleSeconds = 0.f;
+        Timeouts.TotalSeconds = RequestTimeouts.FirstByteSeconds;
+        StateWatchdog.Watch(TFunction<void()>(), Timeouts, false, [this](EGXTimeoutKind Kind)
+        {
+            UE_LOG(LogRealtimeFSM, Warning, TEXT("No response audio after %.1fs; ready for the next turn."), RequestTimeouts.FirstByteSeconds);
+            SetState(ERealtimeConversationState::Connected_Ready);
+        });
+    }
+
+    if (NewState == ERealtimeConversationState::Idle)
+    {
+        ReleaseCapture();
+        MicSender.Shutdown(false);
         if (AIAudioPlayer && AIAudioPlayer->IsPlaying()) AIAudioPlayer->Stop();
     }
 }
 #else
 // Dummy implementations for when the module is not available
 void AGXOpenAIRealtimeExample::HandleRealtimeConnected(const FString& SessionId) {}
+void AGXOpenAIRealtimeExample::StartSession() {}
+bool AGXOpenAIRealtimeExample::AcquireCapture() { return false; }
+void AGXOpenAIRealtimeExample::ReleaseCapture() {}
+void AGXOpenAIRealtimeExample::SendMicFrame(const TArray<uint8>& Frame) {}
+void AGXOpenAIRealtimeExample::CommitUserTurn() {}
 void AGXOpenAIRealtimeExample::HandleRealtimeConnectionError(int32 StatusCode, const FString& Reason, bool bWasClean) {}
 void AGXOpenAIRealtimeExample::HandleRealtimeDisconnected() {}
+bool AGXOpenAIRealtimeExample::AcceptResponseDelta() { return true; }
 void AGXOpenAIRealtimeExample::HandleRealtimeAudioResponse(const TArray<uint8>& AudioData) {}
 void AGXOpenAIRealtimeExample::HandleUserTranscriptDelta(const FString& TranscriptDelta) {}
 void AGXOpenAIRealtimeExample::HandleAssistantTranscriptDelta(const FString& TranscriptDelta) {}
 void AGXOpenAIRealtimeExample::HandleServerSpeechStarted(const FString& ItemId) {}
 void AGXOpenAIRealtimeExample::HandleServerSpeechStopped(const FString& ItemId) {}
 void AGXOpenAIRealtimeExample::OnAIAudioFinished() {}
-void AGXOpenAIRealtimeExample::HandleAudioGenerated(const float* InAudio, int32 NumSamples) {}
+void AGXOpenAIRealtimeExample::HandleMicPCM(const int16* PCM, int32 NumPCM) {}
+void AGXOpenAIRealtimeExample::HandleCaptureFocusChanged(bool bFocused) {}
 void AGXOpenAIRealtimeExample::SetState(ERealtimeConversationState NewState) {}
 #endif
\ No newline at end of file
@@ -18,10 +18,8 @@ void AGXOpenAIStructuredOpExample::EndPlay(const EEndPlayReason::Type EndPlayRea
 {
 #if WITH_GENAI_MODULE
     // Cancel any active request when the actor is destroyed
-    if (ActiveStructuredOpRequest.IsValid())
-    {
-        ActiveStructuredOpRequest->Cancel();
-    }
+    Watchdog.Stop();
+    CancelActiveRequest();
 #endif
     Super::EndPlay(EndPlayReason);
 }
@@ -30,10 +28,8 @@ void AGXOpenAIStructuredOpExample::RequestStructuredOperation(const FString& Use
 {
 #if WITH_GENAI_MODULE
     // If there's an ongoing request, cancel it before starting a new one.
-    if (ActiveStructuredOpRequest.IsValid())
-    {
-        ActiveStructuredOpRequest->Cancel();
-    }
+    Watchdog.Begin();
+    CancelActiveRequest();
 
     // Set up the chat settings for the structured operation
     FGenOAIStructuredChatSettings StructuredChatSettings;
@@ -60,6 +56,15 @@ void AGXOpenAIStructuredOpExample::RequestStructuredOperation(const FString& Use
         AsyncAction->OnComplete.AddDynamic(this, &AGXOpenAIStructuredOpExample::OnStructuredOpCompleted);
         ActiveStructuredOpRequest = AsyncAction;
         UE_LOG(LogTemp, Log, TEXT("Requesting structured operation..."));
+
+        // The async action does not expose its HTTP request, so the watchdog cancels through the action.
+        // Without a response object the connect phase cannot be observed; only the total deadline applies.
+        FGXRequestTimeouts Timeouts = RequestTimeouts;
+        Timeouts.ConnectSeconds = 0.f;
+        Watchdog.Watch([this]() { CancelActiveRequest(); }, Timeouts, false, [this](EGXTimeoutKind Kind)
+        {
+            OnUIStructuredOpResponse.Broadcast(TEXT(""), FGXRequestWatchdog::DescribeTimeout(Kind), false);
+        });
     }
     else
     {
@@ -74,6 +79,8 @@ void AGXOpenAIStructuredOpExample::RequestStructuredOperation(const FString& Use
 #if WITH_GENAI_MODULE
 void AGXOpenAIStructuredOpExample::OnStructuredOpCompleted(const FString& Response, const FString& Error, bool bSuccess)
 {
+    Watchdog.Stop();
+
     if (bSuccess)
     {
         UE_LOG(LogTemp, Log, TEXT("Structured Operation Successful. Response: %s"), *Response);
@@ -89,6 +96,16 @@ void AGXOpenAIStructuredOpExample::OnStructuredOpCompleted(const FString& Respon
     // Clear the weak pointer as the action is now complete
     ActiveStructuredOpRequest.Reset();
 }
+
+void AGXOpenAIStructuredOpExample::CancelActiveRequest()
+{
+    if (ActiveStructuredOpRequest.IsValid())
+    {
+        ActiveStructuredOpRequest->OnComplete.RemoveAll(this);
+        ActiveStructuredOpRequest->Cancel();
+    }
+    ActiveStructuredOpRequest.Reset();
+}
 #else
 void AGXOpenAIStructuredOpExample::OnStructuredOpCompleted(const FString& Response, const FString& Error, bool bSuccess)
 {
@@ -0,0 +1,443 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#include "OpenAI/GXRealtimeReplayHarness.h"
+#include "OpenAI/GXOpenAIRealtimeExample.h"
+#include "Common/GXVoiceLatencyTracker.h"
+#include "Common/GXVoiceCaptureSubsystem.h"
+#include "Async/Async.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Base64.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Engine/World.h"
+#include "UObject/UObjectIterator.h"
+#include "Audio.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGXRealtimeReplay, Log, All);
+
+namespace
+{
+    /** Matches the capture component's buffer size at 48 kHz. */
+    constexpr int32 GFramesPerCallback = 1024;
+
+    /** Silence fed after the WAV so the VAD can close the last turn. */
+    constexpr double GTrailingSilenceSeconds = 1.5;
+
+    /** Time left after the last scripted event for its audio to reach the speaker. */
+    constexpr double GSettleSeconds = 1.0;
+
+    /** How long to wait for commits that the script still has turns for once the feed has ended. */
+    constexpr double GCommitGraceSeconds = 10.0;
+}
+
+FGXRealtimeReplayHarness::FGXRealtimeReplayHarness(AGXOpenAIRealtimeExample* InExample)
+    : Example(InExample)
+{
+}
+
+FGXRealtimeReplayHarness::~FGXRealtimeReplayHarness()
+{
+    Shutdown();
+}
+
+bool FGXRealtimeReplayHarness::Load(const FString& WavPath, const FString& ScriptPath, FString& OutError)
+{
+    TArray<uint8> WavBytes;
+    if (!FFileHelper::LoadFileToArray(WavBytes, *WavPath))
+    {
+        OutError = FString::Printf(TEXT("Could not read '%s'."), *WavPath);
+        return false;
+    }
+
+    FWaveModInfo WaveInfo;
+    if (!WaveInfo.ReadWaveInfo(WavBytes.GetData(), WavBytes.Num(), &OutError))
+    {
+        return false;
+    }
+    if (*WaveInfo.pBitsPerSample != 16)
+    {
+        OutError = FString::Printf(TEXT("'%s' is %d-bit; only 16-bit PCM is supported."), *WavPath, *WaveInfo.pBitsPerSample);
+        return false;
+    }
+
+    SampleRate = *WaveInfo.pSamplesPerSec;
+    NumChannels = *WaveInfo.pChannels;
+    const int32 NumSamples = WaveInfo.SampleDataSize / sizeof(int16);
+    const int16* PCM = reinterpret_cast<const int16*>(WaveInfo.SampleDataStart);
+    Samples.SetNumUninitialized(NumSamples);
+    for (int32 Index = 0; Index < NumSamples; ++Index)
+    {
+        Samples[Index] = PCM[Index] / 32768.f;
+    }
+
+    return LoadScript(ScriptPath, OutError);
+}
+
+bool FGXRealtimeReplayHarness::LoadScript(const FString& ScriptPath, FString& OutError)
+{
+    FString Text;
+    if (!FFileHelper::LoadFileToString(Text, *ScriptPath))
+    {
+        OutError = FString::Printf(TEXT("Could not read '%s'."), *ScriptPath);
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Root;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+    const TArray<TSharedPtr<FJsonValue>>* JsonTurns = nullptr;
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !Root->TryGetArrayField(TEXT("turns"), JsonTurns))
+    {
+        OutError = FString::Printf(TEXT("'%s' is not an event script: expected an object with a \"turns\" array."), *ScriptPath);
+        return false;
+    }
+
+    static const TMap<FString, EEventType> TypesByName = {
+        { TEXT("input_audio_buffer.speech_started"), EEventType::SpeechStarted },
+        { TEXT("input_audio_buffer.speech_stopped"), EEventType::SpeechStopped },
+        { TEXT("conversation.item.input_audio_transcription.delta"), EEventType::UserTranscriptDelta },
+        { TEXT("response.audio_transcript.delta"), EEventType::AssistantTranscriptDelta },
+        { TEXT("response.audio.delta"), EEventType::AudioDelta },
+    };
+
+    Turns.Reset();
+    for (const TSharedPtr<FJsonValue>& JsonTurn : *JsonTurns)
+    {
+        const TSharedPtr<FJsonObject>* TurnObject = nullptr;
+        const TArray<TSharedPtr<FJsonValue>>* JsonEvents = nullptr;
+        if (!JsonTurn->TryGetObject(TurnObject) || !(*TurnObject)->TryGetArrayField(TEXT("events"), JsonEvents))
+        {
+            OutError = FString::Printf(TEXT("Turn %d has no \"events\" array."), Turns.Num());
+            return false;
+        }
+
+        FScriptedTurn& Turn = Turns.AddDefaulted_GetRef();
+        double AtMs = -1.0;
+        if ((*TurnObject)->TryGetNumberField(TEXT("at_ms"), AtMs))
+        {
+            Turn.AtSeconds = AtMs * 0.001;
+        }
+
+        for (const TSharedPtr<FJsonValue>& JsonEvent : *JsonEvents)
+        {
+            const TSharedPtr<FJsonObject>* EventObject = nullptr;
+            FString TypeName;
+            if (!JsonEvent->TryGetObject(EventObject) || !(*EventObject)->TryGetStringField(TEXT("type"), TypeName))
+            {
+                OutError = FString::Printf(TEXT("Turn %d has an event without a \"type\"."), Turns.Num() - 1);
+                return false;
+            }
+            const EEventType* Type = TypesByName.Find(TypeName);
+            if (!Type)
+            {
+                UE_LOG(LogGXRealtimeReplay, Verbose, TEXT("Skipping unsupported event '%s'."), *TypeName);
+                continue;
+            }
+
+            FScriptedEvent& Event = Turn.Events.AddDefaulted_GetRef();
+            Event.Type = *Type;
+            Event.OffsetSeconds = (*EventObject)->GetNumberField(TEXT("t_ms")) * 0.001;
+            if (Event.Type == EEventType::AudioDelta)
+            {
+                FBase64::Decode((*EventObject)->GetStringField(TEXT("delta")), Event.Audio);
+            }
+            else if (Event.Type == EEventType::SpeechStarted || Event.Type == EEventType::SpeechStopped)
+            {
+                Event.Text = (*EventObject)->GetStringField(TEXT("item_id"));
+            }
+            else
+            {
+                Event.Text = (*EventObject)->GetStringField(TEXT("delta"));
+            }
+        }
+
+        Turn.Events.StableSort([](const FScriptedEvent& A, const FScriptedEvent& B) { return A.OffsetSeconds < B.OffsetSeconds; });
+    }
+    return true;
+}
+
+bool FGXRealtimeReplayHarness::Start(float InSpeed, const FGXReplayBudgets& InBudgets)
+{
+    Shutdown();
+
+    Capture = UGXVoiceCaptureSubsystem::Get(Example);
+    Speed = InSpeed > 0.f ? InSpeed : 1.f;
+    Budgets = InBudgets;
+    TurnTotalsMs.Reset();
+    StartSeconds = FPlatformTime::Seconds();
+    bStopping = false;
+    bFeedDone = false;
+    CommitsReceived = 0;
+    CommitsUsed = NextTurn = NextEvent = 0;
+    TurnStartSeconds = -1.0;
+    UplinkBytes = 0;
+    UplinkFrames = 0;
+    FeedCycles = MaxCallbackCycles = 0;
+    Callbacks = 0;
+
+    UE_LOG(LogGXRealtimeReplay, Log, TEXT("Replaying %.1f s of %d Hz, %d channel audio and %d scripted turns at %.1fx."),
+        static_cast<float>(Samples.Num()) / (SampleRate * NumChannels), SampleRate, NumChannels, Turns.Num(), Speed);
+
+    Thread = FRunnableThread::Create(this, TEXT("GXRealtimeReplayFeed"), 0, TPri_AboveNormal);
+    if (!Thread)
+    {
+        UE_LOG(LogGXRealtimeReplay, Error, TEXT("Replay FAILED: could not start the feed thread."));
+        return false;
+    }
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGXRealtimeReplayHarness::Tick));
+    return true;
+}
+
+void FGXRealtimeReplayHarness::Shutdown()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+}
+
+void FGXRealtimeReplayHarness::ReceiveAudio(const TArray<uint8>& Frame)
+{
+    UplinkBytes.fetch_add(Frame.Num(), std::memory_order_relaxed);
+    UplinkFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FGXRealtimeReplayHarness::ReceiveCommit()
+{
+    CommitsReceived.fetch_add(1);
+}
+
+void FGXRealtimeReplayHarness::ReceiveTurnTimings(const FGXVoiceTurnTimings& Timings)
+{
+    TurnTotalsMs.Add(Timings.TotalMs);
+}
+
+uint32 FGXRealtimeReplayHarness::Run()
+{
+    const int32 NumFrames = Samples.Num() / FMath::Max(NumChannels, 1);
+    const int32 TotalFrames = NumFrames + FMath::CeilToInt(GTrailingSilenceSeconds * SampleRate);
+    TArray<float> Silence;
+    Silence.SetNumZeroed(GFramesPerCallback * NumChannels);
+
+    // Paced against the start time rather than per buffer, so sleep overshoot does not accumulate.
+    const double FeedStart = FPlatformTime::Seconds();
+    for (int32 Frame = 0; Frame < TotalFrames && !bStopping; Frame += GFramesPerCallback)
+    {
+        const int32 Count = FMath::Min(GFramesPerCallback, TotalFrames - Frame);
+        const float* Audio = Frame < NumFrames ? Samples.GetData() + Frame * NumChannels : Silence.GetData();
+        const int32 Available = Frame < NumFrames ? FMath::Min(Count, NumFrames - Frame) : Count;
+
+        const uint64 Before = FPlatformTime::Cycles64();
+        Capture->InjectAudio(Audio, Available, NumChannels, SampleRate);
+        const uint64 Spent = FPlatformTime::Cycles64() - Before;
+        FeedCycles += Spent;
+        MaxCallbackCycles = FMath::Max(MaxCallbackCycles, Spent);
+        ++Callbacks;
+
+        const double Due = FeedStart + static_cast<double>(Frame + Count) / SampleRate / Speed;
+        const double Wait = Due - FPlatformTime::Seconds();
+        if (Wait > 0.0)
+        {
+            FPlatformProcess::Sleep(static_cast<float>(Wait));
+        }
+    }
+
+    FeedWallSeconds = FPlatformTime::Seconds() - FeedStart;
+    FeedDoneSeconds = FPlatformTime::Seconds();
+    bFeedDone.store(true, std::memory_order_release);
+    return 0;
+}
+
+void FGXRealtimeReplayHarness::Stop()
+{
+    bStopping = true;
+}
+
+bool FGXRealtimeReplayHarness::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    if (TurnStartSeconds < 0.0 && NextTurn < Turns.Num())
+    {
+        const FScriptedTurn& Turn = Turns[NextTurn];
+        const bool bScheduled = Turn.AtSeconds >= 0.0;
+        if (bScheduled ? Now - StartSeconds >= Turn.AtSeconds / Speed : CommitsReceived.load() > CommitsUsed)
+        {
+            CommitsUsed += bScheduled ? 0 : 1;
+            TurnStartSeconds = Now;
+            NextEvent = 0;
+        }
+    }
+
+    if (TurnStartSeconds >= 0.0)
+    {
+        const FScriptedTurn& Turn = Turns[NextTurn];
+        while (NextEvent < Turn.Events.Num() && Now - TurnStartSeconds >= Turn.Events[NextEvent].OffsetSeconds / Speed)
+        {
+            Dispatch(Turn.Events[NextEvent++]);
+        }
+        if (NextEvent >= Turn.Events.Num())
+        {
+            TurnStartSeconds = -1.0;
+            ++NextTurn;
+        }
+    }
+
+    if (!bFeedDone.load(std::memory_order_acquire))
+    {
+        return true;
+    }
+
+    // Done once every turn has played out, or once the feed has ended and no commit came for the rest.
+    const double SinceFeed = Now - FeedDoneSeconds;
+    const bool bScriptDone = NextTurn >= Turns.Num() && SinceFeed >= GSettleSeconds;
+    const bool bStalled = TurnStartSeconds < 0.0 && SinceFeed >= GCommitGraceSeconds / Speed;
+    if (!bScriptDone && !bStalled)
+    {
+        return true;
+    }
+
+    if (!bScriptDone)
+    {
+        UE_LOG(LogGXRealtimeReplay, Warning, TEXT("Only %d of %d scripted turns were triggered; the VAD committed %d turns."),
+            NextTurn, Turns.Num(), CommitsReceived.load());
+    }
+    const bool bPassed = Report();
+
+    TickerHandle.Reset();
+    if (Budgets.bExitWhenDone)
+    {
+        FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+        return false;
+    }
+    TWeakObjectPtr<AGXOpenAIRealtimeExample> WeakExample(Example);
+    AsyncTask(ENamedThreads::GameThread, [WeakExample]()
+    {
+        if (AGXOpenAIRealtimeExample* Owner = WeakExample.Get()) Owner->StopReplay();
+    });
+    return false;
+}
+
+void FGXRealtimeReplayHarness::Dispatch(const FScriptedEvent& Event)
+{
+    switch (Event.Type)
+    {
+    case EEventType::SpeechStarted:
+        Example->HandleServerSpeechStarted(Event.Text);
+        break;
+    case EEventType::SpeechStopped:
+        Example->HandleServerSpeechStopped(Event.Text);
+        break;
+    case EEventType::UserTranscriptDelta:
+        Example->HandleUserTranscriptDelta(Event.Text);
+        break;
+    case EEventType::AssistantTranscriptDelta:
+        Example->HandleAssistantTranscriptDelta(Event.Text);
+        break;
+    case EEventType::AudioDelta:
+        Example->HandleRealtimeAudioResponse(Event.Audio);
+        break;
+    }
+}
+
+bool FGXRealtimeReplayHarness::Report() const
+{
+    const double AudioSeconds = static_cast<double>(Samples.Num()) / (SampleRate * NumChannels) + GTrailingSilenceSeconds;
+    const double FeedMs = FPlatformTime::ToMilliseconds64(FeedCycles);
+    const double UplinkSeconds = UplinkBytes.load() / (24000.0 * sizeof(int16));
+
+    UE_LOG(LogGXRealtimeReplay, Log, TEXT("Replay finished: %.1f s of audio in %.1f s (%.1fx)."), AudioSeconds, FeedWallSeconds, AudioSeconds / FMath::Max(FeedWallSeconds, 1e-3));
+    UE_LOG(LogGXRealtimeReplay, Log, TEXT("  Capture path: %d buffers, %.1f us average, %.1f us worst, %.3f%% of real time."),
+        Callbacks, Callbacks > 0 ? FeedMs * 1000.0 / Callbacks : 0.0, FPlatformTime::ToMilliseconds64(MaxCallbackCycles) * 1000.0, FeedMs / (AudioSeconds * 10.0));
+    UE_LOG(LogGXRealtimeReplay, Log, TEXT("  Uplink: %d frames, %.1f KB, %.1f s of audio (%.0f%% of the input); %d turns committed, %d of %d scripted turns replayed."),
+        UplinkFrames.load(), UplinkBytes.load() / 1024.0, UplinkSeconds, 100.0 * UplinkSeconds / AudioSeconds, CommitsReceived.load(), NextTurn, Turns.Num());
+
+    const float WorstTurnMs = TurnTotalsMs.Num() > 0 ? FMath::Max(TurnTotalsMs) : 0.f;
+    const double CapturePercent = FeedMs / (AudioSeconds * 10.0);
+    UE_LOG(LogGXRealtimeReplay, Log, TEXT("  Latency: %d turns heard, %.0f ms worst."), TurnTotalsMs.Num(), WorstTurnMs);
+
+    bool bPassed = true;
+    if (Budgets.MaxTurnMs > 0.f && WorstTurnMs > Budgets.MaxTurnMs)
+    {
+        UE_LOG(LogGXRealtimeReplay, Error, TEXT("Budget exceeded: worst turn took %.0f ms, the limit is %.0f ms."), WorstTurnMs, Budgets.MaxTurnMs);
+        bPassed = false;
+    }
+    if (Budgets.MaxCapturePercent > 0.f && CapturePercent > Budgets.MaxCapturePercent)
+    {
+        UE_LOG(LogGXRealtimeReplay, Error, TEXT("Budget exceeded: the capture path used %.3f%% of real time, the limit is %.3f%%."), CapturePercent, Budgets.MaxCapturePercent);
+        bPassed = false;
+    }
+    if (Budgets.bRequireAllTurns && (NextTurn < Turns.Num() || TurnTotalsMs.Num() < Turns.Num()))
+    {
+        UE_LOG(LogGXRealtimeReplay, Error, TEXT("Budget exceeded: %d of %d scripted turns were replayed and %d were heard."), NextTurn, Turns.Num(), TurnTotalsMs.Num());
+        bPassed = false;
+    }
+    UE_LOG(LogGXRealtimeReplay, Display, TEXT("Replay %s."), bPassed ? TEXT("passed") : TEXT("FAILED"));
+    return bPassed;
+}
+
+namespace
+{
+    void StartReplayCommand(const TArray<FString>& Args, UWorld* World)
+    {
+        TArray<FString> Positional;
+        FString Options;
+        for (const FString& Arg : Args)
+        {
+            if (Arg.StartsWith(TEXT("-")))
+            {
+                Options += TEXT(" ") + Arg;
+            }
+            else
+            {
+                Positional.Add(Arg);
+            }
+        }
+
+        FGXReplayBudgets Budgets;
+        FParse::Value(*Options, TEXT("-MaxTurnMs="), Budgets.MaxTurnMs);
+        FParse::Value(*Options, TEXT("-MaxCapturePercent="), Budgets.MaxCapturePercent);
+        Budgets.bRequireAllTurns = FParse::Param(*Options, TEXT("RequireAllTurns"));
+        Budgets.bExitWhenDone = FParse::Param(*Options, TEXT("ExitWhenDone"));
+
+        // A run that never starts must still fail an unattended job.
+        const auto Fail = [&Budgets]()
+        {
+            if (Budgets.bExitWhenDone) FPlatformMisc::RequestExitWithStatus(false, 1);
+        };
+
+        if (Positional.Num() < 2)
+        {
+            UE_LOG(LogGXRealtimeReplay, Warning, TEXT("Usage: GenAI.Realtime.Replay <WavPath> <ScriptPath> [Speed] [-MaxTurnMs=N] [-MaxCapturePercent=N] [-RequireAllTurns] [-ExitWhenDone]"));
+            Fail();
+            return;
+        }
+
+        const float Speed = Positional.Num() > 2 ? FCString::Atof(*Positional[2]) : 1.f;
+        for (TObjectIterator<AGXOpenAIRealtimeExample> It; It; ++It)
+        {
+            if (It->GetWorld() == World && !It->IsTemplate())
+            {
+                if (!It->StartReplayWithBudgets(Positional[0], Positional[1], Speed, Budgets)) Fail();
+                return;
+            }
+        }
+        UE_LOG(LogGXRealtimeReplay, Warning, TEXT("No AGXOpenAIRealtimeExample in this world to replay into."));
+        Fail();
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs GReplayCommand(
+        TEXT("GenAI.Realtime.Replay"),
+        TEXT("Replays a 16-bit WAV through the realtime example against a recorded server event script, without a microphone or connection. Arguments: WavPath ScriptPath [Speed=1] [-MaxTurnMs=N] [-MaxCapturePercent=N] [-RequireAllTurns] [-ExitWhenDone]."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&StartReplayCommand));
+}
@@ -7,6 +7,7 @@
 #include "Models/XAI/GenXAIChatStream.h"
 #include "Data/XAI/GenXAIChatStructs.h"
 #include "Utilities/GenUtils.h"
+#include "Common/GXModelRouter.h"
 #include "Misc/Paths.h"
 #endif
 
@@ -22,6 +23,8 @@ AGXXAIChatExample::AGXXAIChatExample()
 void AGXXAIChatExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 #if WITH_GENAI_MODULE
+	NonStreamingWatchdog.Stop();
+	StreamingWatchdog.Stop();
 	// Cancel any in-flight requests to prevent crashes on actor destruction
 	if (ActiveRequestNonStreaming.IsValid() && ActiveRequestNonStreaming->GetStatus() == EHttpRequestStatus::Processing)
 	{
@@ -36,10 +39,59 @@ void AGXXAIChatExample::EndPlay(const EEndPlayReason::Type EndPlayReason)
 }
 
 void AGXXAIChatExample::RequestNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, UTexture2D* Image)
+{
+	TArray<UTexture2D*> Images;
+	if (Image != nullptr)
+	{
+		Images.Add(Image);
+	}
+	RequestNonStreamingChatWithImages(UserMessage, ModelName, SystemPrompt, Images);
+}
+
+void AGXXAIChatExample::RequestNonStreamingChatWithImages(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<UTexture2D*>& Images)
 {
 #if WITH_GENAI_MODULE
+	const uint32 Generation = ++PrepareGeneration;
+	if (Images.Num() == 0)
+	{
+		SendNonStreamingChat(UserMessage, ModelName, SystemPrompt, {});
+		return;
+	}
+
+	// The attachments are resized concurrently off the game thread; the request goes out once all of them are ready.
+	TWeakObjectPtr<AGXXAIChatExample> WeakThis(this);
+	FGXImagePreprocessor::PrepareAllAsync(this, Images, EGXChatProvider::XAI, ModelName, ImagePreprocessing,
+		[WeakThis, Generation, UserMessage, ModelName, SystemPrompt](TArray<FGXImagePreprocessStats>&& Prepared)
+		{
+			// A later send or ClearConversation superseded this turn while its images were being prepared;
+			// the UI is told, so it does not wait on a reply that will never come.
+			AGXXAIChatExample* Self = WeakThis.Get();
+			if (Self && Self->PrepareGeneration == Generation)
+			{
+				Self->SendNonStreamingChat(UserMessage, ModelName, SystemPrompt, Prepared);
+			}
+			else if (Self)
+			{
+				Self->OnUINonStreamingResponse.Broadcast(TEXT("Cancelled: a newer message or ClearConversation replaced this one before it was sent."), false);
+			}
+		});
+#else
+    UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestNonStreamingChatWithImages will do nothing."));
+#endif
+}
+
+#if WITH_GENAI_MODULE
+void AGXXAIChatExample::SendNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<FGXImagePreprocessStats>& Images)
+{
 	if (ActiveRequestNonStreaming.IsValid()) return;
 
+	// Fail fast instead of hammering an endpoint whose circuit breaker is open.
+	if (!UGXModelRouter::TryAcquireFor(this, EGXChatProvider::XAI, ModelName))
+	{
+		OnUINonStreamingResponse.Broadcast(FString::Printf(TEXT("%s is unavailable (circuit open). Try again later."), *ModelName), false);
+		return;
+	}
+
     if (!SystemPrompt.IsEmpty())
     {
         if (ConversationHistory.Num() > 0 && ConversationHistory[0].Role == TEXT("system"))
@@ -55,10 +107,11 @@ void AGXXAIChatExample::RequestNonStreamingChat(const FString& UserMessage, cons
 	// 1. Construct the multimodal message content
 	TArray<FGenAIMessageContent> MessageContent;
 	MessageContent.Add(FGenAIMessageContent::FromText(UserMessage));
-	if (Image != nullptr)
+	for (const FGXImagePreprocessStats& Prepared : Images)
 	{
-		// XAI API expects a base64-encoded image URL string
-		MessageContent.Add(FGenAIMessageContent::FromTexture2D(Image, EGenAIImageDetail::Auto));
+		MessageContent.Add(FGXImagePreprocessor::MakeImageContent(Prepared, EGXChatProvider::XAI, ImagePreprocessing));
+		SentImages.Add(Prepared.SentTexture);
+		OnImagePreprocessed.Broadcast(Prepared);
 	}
 
 	// 2. Add the complete user message to our history
@@ -71,12 +124,18 @@ void AGXXAIChatExample::RequestNonStreamingChat(const FString& UserMessage, cons
 	ChatSettings.Messages = ConversationHistory;
 
 	// 4. Send the request using a lambda for the callback
-	ActiveRequestNonStreaming = UGenXAIChat::SendChatRequest(
+	const uint32 Generation = NonStreamingWatchdog.Begin();
+	const FHttpRequestPtr Request = UGenXAIChat::SendChatRequest(
 		ChatSettings,
 		FOnXAIChatCompletionResponse::CreateLambda(
-			[this](const FString& Response, const FString& Error, bool bSuccess)
+			[this, ModelName, Generation](const FString& Response, const FString& Error, bool bSuccess)
 			{
 				if (!UGenUtils::IsContextStillValid(this)) return;
+				// The watchdog already gave up on this request and cleaned up after it.
+				if (!NonStreamingWatchdog.IsCurrent(Generation)) return;
+				NonStreamingWatchdog.Stop();
+
+				UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::XAI, ModelName, bSuccess);
 
 				if (bSuccess)
 				{
@@ -93,16 +152,76 @@ void AGXXAIChatExample::RequestNonStreamingChat(const FString& UserMessage, cons
 				ActiveRequestNonStreaming.Reset();
 			})
 	);
-#else
-    UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestNonStreamingChat will do nothing."));
-#endif
+
+	// Enforce the deadlines; on expiry the request is cancelled and the turn rolled back
+	if (NonStreamingWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+	{
+		ActiveRequestNonStreaming = Request;
+		NonStreamingWatchdog.Watch(ActiveRequestNonStreaming, RequestTimeouts, false, [this, ModelName](EGXTimeoutKind Kind)
+		{
+			UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::XAI, ModelName, false, true);
+			OnUINonStreamingResponse.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind), false);
+			ConversationHistory.Pop();
+			ActiveRequestNonStreaming.Reset();
+		});
+	}
 }
+#endif
 
 void AGXXAIChatExample::RequestStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, UTexture2D* Image)
 {
+	TArray<UTexture2D*> Images;
+	if (Image != nullptr)
+	{
+		Images.Add(Image);
+	}
+	RequestStreamingChatWithImages(UserMessage, ModelName, SystemPrompt, Images);
+}
+
+void AGXXAIChatExample::RequestStreamingChatWithImages(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<UTexture2D*>& Images)
+{
+#if WITH_GENAI_MODULE
+	const uint32 Generation = ++PrepareGeneration;
+	if (Images.Num() == 0)
+	{
+		SendStreamingChat(UserMessage, ModelName, SystemPrompt, {});
+		return;
+	}
+
+	// The attachments are resized concurrently off the game thread; the request goes out once all of them are ready.
+	TWeakObjectPtr<AGXXAIChatExample> WeakThis(this);
+	FGXImagePreprocessor::PrepareAllAsync(this, Images, EGXChatProvider::XAI, ModelName, ImagePreprocessing,
+		[WeakThis, Generation, UserMessage, ModelName, SystemPrompt](TArray<FGXImagePreprocessStats>&& Prepared)
+		{
+			// A later send or ClearConversation superseded this turn while its images were being prepared;
+			// the UI is told, so it does not wait on a reply that will never come.
+			AGXXAIChatExample* Self = WeakThis.Get();
+			if (Self && Self->PrepareGeneration == Generation)
+			{
+				Self->SendStreamingChat(UserMessage, ModelName, SystemPrompt, Prepared);
+			}
+			else if (Self)
+			{
+				Self->OnUIStreamingError.Broadcast(TEXT("Cancelled: a newer message or ClearConversation replaced this one before it was sent."));
+			}
+		});
+#else
+    UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestStreamingChatWithImages will do nothing."));
+#endif
+}
+
 #if WITH_GENAI_MODULE
+void AGXXAIChatExample::SendStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<FGXImagePreprocessStats>& Images)
+{
 	if (ActiveRequestStreaming.IsValid()) return;
 
+	if (!UGXModelRouter::TryAcquireFor(this, EGXChatProvider::XAI, ModelName))
+	{
+		OnUIStreamingError.Broadcast(FString::Printf(TEXT("%s is unavailable (circuit open). Try again later."), *ModelName));
+		return;
+	}
+	ActiveStreamingModel = ModelName;
+
     if (!SystemPrompt.IsEmpty())
     {
         if (ConversationHistory.Num() > 0 && ConversationHistory[0].Role == TEXT("system"))
@@ -118,9 +237,11 @@ void AGXXAIChatExample::RequestStreamingChat(const FString& UserMessage, const F
 	// 1. Construct the multimodal message content
 	TArray<FGenAIMessageContent> MessageContent;
 	MessageContent.Add(FGenAIMessageContent::FromText(UserMessage));
-	if (Image != nullptr)
+	for (const FGXImagePreprocessStats& Prepared : Images)
 	{
-		MessageContent.Add(FGenAIMessageContent::FromTexture2D(Image, EGenAIImageDetail::Auto));
+		MessageContent.Add(FGXImagePreprocessor::MakeImageContent(Prepared, EGXChatProvider::XAI, ImagePreprocessing));
+		SentImages.Add(Prepared.SentTexture);
+		OnImagePreprocessed.Broadcast(Prepared);
 	}
 
 	// 2. Add to history
@@ -133,15 +254,30 @@ void AGXXAIChatExample::RequestStreamingChat(const FString& UserMessage, const F
 	ChatSettings.Messages = ConversationHistory;
 
 	// 4. Send the request, binding our handler function to the delegate
-	ActiveRequestStreaming = UGenXAIChatStream::SendStreamChatRequest(ChatSettings, FOnXAIChatStreamResponse::CreateUObject(this, &AGXXAIChatExample::OnStreamingChatEvent));
-#else
-    UE_LOG(LogTemp, Warning, TEXT("GenAI module is not available. RequestStreamingChat will do nothing."));
-#endif
+	const uint32 Generation = StreamingWatchdog.Begin();
+	const FHttpRequestPtr Request = UGenXAIChatStream::SendStreamChatRequest(ChatSettings, FOnXAIChatStreamResponse::CreateUObject(this, &AGXXAIChatExample::OnStreamingChatEvent, Generation));
+
+	// Enforce the deadlines; a stalled stream is cancelled and the turn rolled back
+	if (StreamingWatchdog.IsCurrent(Generation) && FGXRequestWatchdog::IsInFlight(Request))
+	{
+		ActiveRequestStreaming = Request;
+		StreamingWatchdog.Watch(ActiveRequestStreaming, RequestTimeouts, true, [this](EGXTimeoutKind Kind)
+		{
+			UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::XAI, ActiveStreamingModel, false, true);
+			OnUIStreamingError.Broadcast(FGXRequestWatchdog::DescribeTimeout(Kind));
+			ConversationHistory.Pop();
+			ActiveRequestStreaming.Reset();
+		});
+	}
 }
+#endif
 
 void AGXXAIChatExample::ClearConversation()
 {
+	SentImages.Empty();
+
 #if WITH_GENAI_MODULE
+	++PrepareGeneration;
 	ConversationHistory.Empty();
 	// Re-add the initial system message after clearing
 	ConversationHistory.Add(FGenXAIMessage(TEXT("system"), {FGenAIMessageContent::FromText(TEXT("You are a helpful assistant integrated into an Unreal Engine application."))}));
@@ -151,14 +287,18 @@ void AGXXAIChatExample::ClearConversation()
 }
 
 #if WITH_GENAI_MODULE
-void AGXXAIChatExample::OnStreamingChatEvent(EXAIStreamEventType EventType, const FString& Payload, bool bSuccess)
+void AGXXAIChatExample::OnStreamingChatEvent(EXAIStreamEventType EventType, const FString& Payload, bool bSuccess, uint32 RequestGeneration)
 {
 	if (!UGenUtils::IsContextStillValid(this)) return;
+	if (!StreamingWatchdog.IsCurrent(RequestGeneration)) return;
+	StreamingWatchdog.NotifyActivity();
 
 	if (!bSuccess)
 	{
+		UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::XAI, ActiveStreamingModel, false);
 		OnUIStreamingError.Broadcast(Payload);
 		ConversationHistory.Pop();
+		StreamingWatchdog.Stop();
 		ActiveRequestStreaming.Reset();
 		return;
 	}
@@ -172,15 +312,19 @@ void AGXXAIChatExample::OnStreamingChatEvent(EXAIStreamEventType EventType, cons
 
 		case EXAIStreamEventType::Completion:
 			// The payload is the final, complete message.
+			UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::XAI, ActiveStreamingModel, true);
 			ConversationHistory.Add(FGenXAIMessage(TEXT("assistant"), {FGenAIMessageContent::FromText(Payload)}));
 			OnUIStreamingResponseCompleted.Broadcast(Payload);
+			StreamingWatchdog.Stop();
 			ActiveRequestStreaming.Reset();
 			break;
 
 		case EXAIStreamEventType::Error:
+			 UGXModelRouter::ReportOutcomeFor(this, EGXChatProvider::XAI, ActiveStreamingModel, false);
 			 // This case is now handled by the initial !bSuccess check, but we keep it for clarity.
 			 OnUIStreamingError.Broadcast(Payload);
 			 ConversationHistory.Pop();
+			 StreamingWatchdog.Stop();
 			 ActiveRequestStreaming.Reset();
 			 break;
 	}
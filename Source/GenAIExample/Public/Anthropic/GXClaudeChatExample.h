@@ -4,6 +4,8 @@
 #include "CoreMinimal.h"
 #include "GenAIExampleDelegates.h"
 #include "GameFramework/Actor.h"
+#include "Common/GXRequestWatchdog.h"
+#include "Common/GXImagePreprocessor.h"
 #if WITH_GENAI_MODULE
 #include "Data/Anthropic/GenClaudeChatStructs.h"
 #include "Http.h"
@@ -31,22 +33,54 @@ public:
     UFUNCTION(BlueprintCallable, Category = "GenAI|Claude Examples")
     void RequestNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt = TEXT(""), UTexture2D* Image = nullptr);
 
+    /**
+     * @brief Sends a user message with any number of images for a complete, non-streaming response.
+     *        The images are prepared in parallel and the request is sent once all of them are ready.
+     * @param Images Textures to attach, in order. Null entries are skipped.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GenAI|Claude Examples")
+    void RequestNonStreamingChatWithImages(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<UTexture2D*>& Images);
+
 
     /** Clears the chat history. */
     UFUNCTION(BlueprintCallable, Category = "GenAI|Claude Examples")
     void ClearConversation();
 
+    /** Deadlines applied to every chat request. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+    FGXRequestTimeouts RequestTimeouts;
+
+    /** Resizes attached images to what the model actually looks at before sending them. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Preprocessing")
+    FGXImagePreprocessSettings ImagePreprocessing;
+
     // -- DELEGATES FOR BLUEPRINT UI --
     UPROPERTY(BlueprintAssignable, Category = "GenAI|Events")
     FOnUINonStreamingResponse OnUINonStreamingResponse;
 
-#if WITH_GENAI_MODULE
+    /** Fired for each attached image with the bytes and estimated vision tokens preprocessing saved. */
+    UPROPERTY(BlueprintAssignable, Category = "GenAI|Events")
+    FOnImagePreprocessed OnImagePreprocessed;
+
 private:
+    /** Resized attachments; ConversationHistory refers to them but does not keep them alive. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UTexture2D>> SentImages;
+
+#if WITH_GENAI_MODULE
+    /** Builds and sends the user turn once its images are prepared. */
+    void SendNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<FGXImagePreprocessStats>& Images);
 
     /** Stores the conversation history using Claude's message format */
     TArray<FGenClaudeChatMessage> ConversationHistory;
      
     /** Keeps track of the active HTTP requests to allow cancellation. */
     TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> ActiveRequestNonStreaming;
+
+    /** Enforces RequestTimeouts on ActiveRequestNonStreaming. */
+    FGXRequestWatchdog NonStreamingWatchdog;
+
+    /** Bumped by every send and by ClearConversation; a turn whose images finish preparing after that is dropped. */
+    uint32 PrepareGeneration = 0;
 #endif
 };
@@ -0,0 +1,71 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Turns captured float audio into mono 16-bit PCM at a fixed rate, for streaming microphone input.
+ *
+ * Each buffer is downmixed, resampled with a polyphase windowed-sinc filter and quantised. The filter
+ * keeps its history between buffers, so consecutive buffers join without clicks, and every working
+ * buffer is reused, so a steady stream does not allocate. The inner loops run on VectorRegister
+ * (SSE or NEON); quantisation uses the platform's saturating pack, with a scalar fallback elsewhere.
+ *
+ * Run GenAI.Audio.BenchmarkConverter in the console to compare it with the plugin's converter.
+ */
+class GENAIEXAMPLE_API FGXAudioConverter
+{
+public:
+	/**
+	 * @brief Sets the input and output formats, builds the filter and clears the stream state.
+	 * @param InSampleRate Rate of the captured audio, e.g. the capture device's preferred rate.
+	 * @param InNumChannels Interleaved channels in the captured audio.
+	 */
+	void Configure(int32 InSampleRate, int32 InNumChannels, int32 OutSampleRate = 24000);
+
+	bool IsConfigured() const { return NumChannels > 0; }
+
+	/** Forgets the filter history, e.g. between two recordings. */
+	void Reset();
+
+	/**
+	 * @brief Converts one buffer. Not thread safe: feed one stream from one thread at a time.
+	 * @param NumSamples Interleaved samples, i.e. frames times channels. A trailing partial frame is ignored.
+	 * @param OutPCM16 Resized to the converted audio; its allocation is kept across calls.
+	 */
+	void Convert(const float* InAudio, int32 NumSamples, TArray<uint8>& OutPCM16);
+
+	int32 GetInputSampleRate() const { return InputSampleRate; }
+	int32 GetInputChannels() const { return NumChannels; }
+	int32 GetOutputSampleRate() const { return OutputSampleRate; }
+
+	/** Averages interleaved channels into mono. Out may not alias In unless NumChannels is 1. */
+	static void Downmix(const float* In, int32 NumFrames, int32 NumChannels, float* Out);
+
+	/** Scales [-1, 1] floats to int16, rounding to nearest and saturating. */
+	static void FloatToPCM16(const float* In, int32 Num, int16* Out);
+
+private:
+	int32 Resample(float* Out);
+
+	int32 InputSampleRate = 0;
+	int32 NumChannels = 0;
+	int32 OutputSampleRate = 0;
+
+	/** Output positions advance DownFactor steps of a grid UpFactor times finer than the input. */
+	int32 UpFactor = 1;
+	int32 DownFactor = 1;
+
+	/** UpFactor phases of TapsPerPhase coefficients, each ordered oldest input sample first. */
+	TArray<float> Coefficients;
+
+	/** Mono input: TapsPerPhase - 1 samples of history followed by the current buffer. */
+	TArray<float> Work;
+	int32 NumWork = 0;
+
+	/** Next output position on the fine grid, relative to Work[0]. */
+	int64 Position = 0;
+
+	TArray<float> Resampled;
+};
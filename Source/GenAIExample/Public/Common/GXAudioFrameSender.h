@@ -0,0 +1,93 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Common/GXSpscRingBuffer.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+/**
+ * Batches streamed 16-bit PCM into fixed-duration frames and sends them from its own thread.
+ *
+ * The capture callback only copies samples into a lock-free ring buffer; a sender thread cuts them into
+ * frames of FrameMs and hands each one over in a buffer allocated when the sender starts. The audio thread
+ * never allocates or touches the network, and the server sees a steady frame rate instead of one message
+ * per capture callback. If the sender falls behind for longer than the ring holds, the newest audio is
+ * dropped and counted rather than blocking the capture.
+ */
+class GENAIEXAMPLE_API FGXAudioFrameSender : public FRunnable
+{
+public:
+	/** Sender thread. The frame buffer is reused, so copy it if it must outlive the call. */
+	using FSendFrame = TFunction<void(const TArray<uint8>& Frame)>;
+
+	/** Sender thread, after a Flush() has sent everything pushed before it. */
+	using FOnFlushed = TFunction<void()>;
+
+	FGXAudioFrameSender() = default;
+	virtual ~FGXAudioFrameSender() override;
+
+	FGXAudioFrameSender(const FGXAudioFrameSender&) = delete;
+	FGXAudioFrameSender& operator=(const FGXAudioFrameSender&) = delete;
+
+	/**
+	 * @brief Allocates the ring and frame buffers and starts the sender thread. Restarts if already running.
+	 * @param SampleRate Rate of the pushed mono PCM16.
+	 * @param FrameMs Duration of each sent frame, e.g. 20, 40 or 100.
+	 * @param BufferSeconds Audio the ring holds while the sender is busy.
+	 */
+	bool Start(int32 SampleRate, int32 FrameMs, float BufferSeconds, FSendFrame InSend, FOnFlushed InOnFlushed = nullptr);
+
+	/**
+	 * @brief Stops and joins the sender thread. Safe to call when not running.
+	 * @param bFlush Send what is still buffered, including a final short frame, before returning.
+	 */
+	void Shutdown(bool bFlush);
+
+	bool IsRunning() const { return Thread != nullptr; }
+
+	/**
+	 * Producer thread only. Never blocks or allocates; ignored unless running. Must not overlap Start(),
+	 * which reallocates the ring, but may race Shutdown().
+	 */
+	void Push(const int16* Samples, int32 NumSamples);
+
+	/**
+	 * Producer thread only. Sends what was pushed so far without waiting for a full frame, then calls the
+	 * OnFlushed callback, e.g. to commit a turn once its last audio is out. Never blocks.
+	 */
+	void Flush();
+
+	/** Samples lost to a full ring since Start(). */
+	int64 GetDroppedSamples() const { return DroppedSamples.load(std::memory_order_relaxed); }
+
+	//~ FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	/** Sends every complete frame; with bIncludePartial, also what is left over. */
+	void Drain(bool bIncludePartial);
+
+	TGXSpscRingBuffer<int16> Ring;
+
+	/** Preallocated at FrameSamples * 2 bytes; shrunk in place only for the last frame of a flush. */
+	TArray<uint8> FrameBuffer;
+	int32 FrameSamples = 0;
+	uint32 WaitMs = 0;
+
+	FSendFrame Send;
+	FOnFlushed OnFlushed;
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+
+	std::atomic<bool> bAccepting{ false };
+	std::atomic<bool> bStopping{ false };
+	std::atomic<bool> bFlushRequested{ false };
+	bool bFlushOnStop = false;
+	std::atomic<int64> DroppedSamples{ 0 };
+};
@@ -0,0 +1,82 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GXBlockCompressor.generated.h"
+
+UENUM(BlueprintType)
+enum class EGXTextureCompression : uint8
+{
+	/** Uncompressed BGRA8, 4 bytes per pixel. */
+	None,
+	/** Opaque, 0.5 bytes per pixel. Alpha is dropped. */
+	BC1,
+	/** With alpha, 1 byte per pixel. */
+	BC3,
+	/** BC1 if every pixel is opaque, otherwise BC3. */
+	Auto
+};
+
+UENUM(BlueprintType)
+enum class EGXCompressionQuality : uint8
+{
+	/** Bounding-box endpoints. Several times faster than High; visible banding on smooth gradients. */
+	Fast,
+	/** Endpoints on the principal axis of each block's colours. */
+	Balanced,
+	/** Principal axis plus least-squares refinement of the endpoints. */
+	High
+};
+
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXTextureCompressionSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Texture Compression")
+	EGXTextureCompression Compression = EGXTextureCompression::None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Texture Compression")
+	EGXCompressionQuality Quality = EGXCompressionQuality::Balanced;
+
+	/** Builds the full mip chain, adding a third to the memory but keeping minified images sharp and cheap to sample. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Texture Compression")
+	bool bGenerateMips = true;
+};
+
+/** A largest-first mip chain ready for FGXTextureDecoder::CreateTextureFromMips. */
+struct GENAIEXAMPLE_API FGXCompressedImage
+{
+	EPixelFormat Format = PF_Unknown;
+	int32 Width = 0;
+	int32 Height = 0;
+	TArray<TArray64<uint8>> Mips;
+
+	/** Worker time spent building mips and encoding blocks. */
+	float CompressMs = 0.f;
+
+	int64 GetSizeBytes() const;
+};
+
+/**
+ * CPU block compression of BGRA8 images, for generated textures that would otherwise stay uncompressed.
+ *
+ * Blocks are encoded in parallel rows with ParallelFor; colour maths runs on VectorRegister, so it compiles
+ * to SSE or NEON. Everything here is safe to call from any thread and does not touch UObjects.
+ */
+struct GENAIEXAMPLE_API FGXBlockCompressor
+{
+	/**
+	 * @brief Compresses an image and, optionally, its mip chain.
+	 * @param Pixels Tightly packed BGRA8 pixels, consumed.
+	 * @return False if the image cannot be block compressed (width or height not a multiple of 4); OutImage is untouched then.
+	 */
+	static bool Compress(TArray64<uint8>&& Pixels, int32 Width, int32 Height, const FGXTextureCompressionSettings& Settings, FGXCompressedImage& OutImage);
+
+	/** Halves a BGRA8 image repeatedly with a 2x2 box filter, down to 1x1. Element 0 is Pixels itself. */
+	static TArray<TArray64<uint8>> BuildMipChain(TArray64<uint8>&& Pixels, int32 Width, int32 Height);
+
+	/** True if every pixel of a BGRA8 image has full alpha. */
+	static bool IsOpaque(const TArray64<uint8>& Pixels);
+};
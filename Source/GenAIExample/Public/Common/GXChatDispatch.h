@@ -0,0 +1,38 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Http.h"
+#include "Common/GXChatTypes.h"
+#include "Common/GXModelRouter.h"
+
+/** Callbacks for a dispatched chat request. All of them run on the game thread. */
+struct GENAIEXAMPLE_API FGXChatDispatchCallbacks
+{
+	/** Called for each streamed text chunk. Non-streaming providers never call it. */
+	TFunction<void(const FString& Delta)> OnDelta;
+
+	/** Called exactly once with the full response, or with an error. */
+	TFunction<void(const FString& Response, const FString& Error, bool bSuccess)> OnComplete;
+};
+
+/**
+ * Sends a provider-neutral conversation to any supported provider.
+ * Builds the provider's own message structs from FGXChatTurn so a conversation can move between providers.
+ */
+struct GENAIEXAMPLE_API FGXChatDispatch
+{
+	/**
+	 * @brief Sends the conversation to the endpoint, streaming where the provider supports it.
+	 * @param Endpoint The provider and model to use.
+	 * @param SystemPrompt The system prompt, mapped to each provider's convention.
+	 * @param Turns The conversation so far, ending with the new user turn.
+	 * @param Callbacks Delta and completion handlers.
+	 * @return The in-flight request, for cancellation. Null if the GenAI module is unavailable.
+	 */
+	static FHttpRequestPtr Send(const FGXModelEndpoint& Endpoint, const FString& SystemPrompt, const TArray<FGXChatTurn>& Turns, FGXChatDispatchCallbacks Callbacks);
+
+	/** True if the provider has a streaming chat API in the plugin. */
+	static bool SupportsStreaming(EGXChatProvider Provider);
+};
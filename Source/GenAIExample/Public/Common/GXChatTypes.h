@@ -0,0 +1,61 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture2D.h"
+#include "GXChatTypes.generated.h"
+
+/** The chat providers the multi-provider examples know how to talk to. */
+UENUM(BlueprintType)
+enum class EGXChatProvider : uint8
+{
+	OpenAI,
+	Anthropic,
+	Google,
+	XAI,
+	DeepSeek
+};
+
+/** Capabilities a model endpoint can advertise, used as a bitmask. */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EGXModelCapability : uint8
+{
+	None       = 0 UMETA(Hidden),
+	Vision     = 1 << 0,
+	Structured = 1 << 1,
+	Reasoning  = 1 << 2,
+	Streaming  = 1 << 3
+};
+ENUM_CLASS_FLAGS(EGXModelCapability);
+
+/**
+ * A provider-neutral conversation turn.
+ * The multi-provider examples keep their history in this form and only build the
+ * provider specific message structs (FGenChatMessage, FGenClaudeChatMessage, ...) at send time.
+ */
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXChatTurn
+{
+	GENERATED_BODY()
+
+	FGXChatTurn() = default;
+	FGXChatTurn(const FString& InRole, const FString& InText)
+		: Role(InRole), Text(InText)
+	{
+	}
+
+	/** "user" or "assistant". System prompts are kept separately. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Conversation")
+	FString Role;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Conversation")
+	FString Text;
+
+	/** Optional image attachments. Only sent to providers with vision support. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Conversation")
+	TArray<TObjectPtr<UTexture2D>> Images;
+};
+
+/** Returns a short display name for a provider, e.g. for log lines and endpoint keys. */
+GENAIEXAMPLE_API FString GXChatProviderToString(EGXChatProvider Provider);
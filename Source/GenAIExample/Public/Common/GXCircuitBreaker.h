@@ -0,0 +1,73 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GXCircuitBreaker.generated.h"
+
+UENUM(BlueprintType)
+enum class EGXCircuitState : uint8
+{
+	/** Requests flow normally. */
+	Closed,
+	/** The endpoint is considered down; requests fail fast. */
+	Open,
+	/** The cool-down elapsed; a limited number of probe requests are let through. */
+	HalfOpen
+};
+
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXCircuitBreakerSettings
+{
+	GENERATED_BODY()
+
+	/** Number of most recent outcomes the error rate is computed over. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Circuit Breaker", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 WindowSize = 20;
+
+	/** The breaker never trips on the error rate before this many outcomes are in the window. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Circuit Breaker", meta = (ClampMin = "1"))
+	int32 MinimumSamples = 5;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Circuit Breaker", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float ErrorRateThreshold = 0.5f;
+
+	/** Timeouts are the most expensive failure, so a short run of them trips the breaker on its own. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Circuit Breaker", meta = (ClampMin = "1"))
+	int32 ConsecutiveTimeoutThreshold = 2;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Circuit Breaker", meta = (ClampMin = "0.0"))
+	float OpenDurationSeconds = 30.f;
+
+	/** Concurrent probes allowed while half-open. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Circuit Breaker", meta = (ClampMin = "1"))
+	int32 HalfOpenMaxProbes = 1;
+};
+
+/** Closed/open/half-open breaker for one endpoint, driven by a rolling window of outcomes. */
+struct GENAIEXAMPLE_API FGXCircuitBreaker
+{
+	/** Returns true if a request may be sent now. Counts a probe when half-open. */
+	bool TryAcquire(const FGXCircuitBreakerSettings& Settings, double NowSeconds);
+
+	/** Records the outcome of a request previously allowed by TryAcquire. */
+	void RecordOutcome(const FGXCircuitBreakerSettings& Settings, bool bSuccess, bool bTimedOut, double NowSeconds);
+
+	EGXCircuitState GetState(const FGXCircuitBreakerSettings& Settings, double NowSeconds) const;
+
+	/** Error rate over the current window, in [0, 1]. */
+	float GetWindowErrorRate() const { return WindowCount > 0 ? static_cast<float>(FMath::CountBits(FailureBits)) / WindowCount : 0.f; }
+
+private:
+	void Trip(double NowSeconds);
+	void Reset();
+
+	EGXCircuitState State = EGXCircuitState::Closed;
+	/** One bit per outcome in the window, 1 = failure. The newest outcome is bit 0. */
+	uint64 FailureBits = 0;
+	int32 WindowCount = 0;
+	int32 ConsecutiveTimeouts = 0;
+	int32 ProbesInFlight = 0;
+	double OpenedAtSeconds = 0.0;
+	double LastProbeSeconds = 0.0;
+};
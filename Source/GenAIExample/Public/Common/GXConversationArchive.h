@@ -0,0 +1,110 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Common/GXChatTypes.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Compact, versioned binary storage for provider-neutral conversation histories.
+ *
+ * File layout (little endian):
+ *   FHeader           32 bytes
+ *   FTurnEntry        16 bytes x TurnCount
+ *   FAttachmentEntry  20 bytes x AttachmentCount   (SHA1 of the PNG bytes)
+ *   String blob       [uint32 ByteLength][UTF-8 bytes] records, referenced by offset
+ *
+ * Image attachments are not embedded. They are written once to GetAttachmentDirectory()
+ * as <sha1>.png, so an image shared by many conversations is stored a single time, and are
+ * deleted by CollectAttachments() once no archive refers to them.
+ */
+struct GENAIEXAMPLE_API FGXConversationArchive
+{
+	static constexpr uint32 Magic = 0x56435847; // "GXCV"
+	static constexpr uint16 Version = 1;
+
+	/** Saved/GenAI/Conversations/ */
+	static FString GetDefaultDirectory();
+
+	/** Saved/GenAI/Attachments/ */
+	static FString GetAttachmentDirectory();
+
+	/** Resolves a slot name to a file in GetDefaultDirectory(). */
+	static FString GetSlotPath(const FString& SlotName);
+
+	/**
+	 * @brief Writes a conversation to disk. The file is written to a temporary path and moved into place.
+	 *        Images without a CPU copy in BGRA8 (compressed or streamed textures) are skipped with a warning.
+	 * @return False with OutError set if the file or an attachment could not be written.
+	 */
+	static bool Save(const FString& FilePath, const FString& SystemPrompt, const TArray<FGXChatTurn>& Turns, FString& OutError);
+
+	/**
+	 * @brief Deletes attachments that no archive under GetDefaultDirectory() refers to any more, e.g. after
+	 *        conversations were deleted. Opens every archive, so run it at load time or from the console.
+	 * @param MinAge Newer attachments are kept, as a Save in progress writes them before its archive.
+	 * @return Number of attachments deleted.
+	 */
+	static int32 CollectAttachments(FTimespan MinAge = FTimespan::FromHours(1.0));
+};
+
+/**
+ * Memory-mapped view of a conversation archive.
+ *
+ * Open() only maps the file and validates the header and tables, so opening hundreds of
+ * archives is cheap. Text is decoded per turn on demand and attachments are only loaded
+ * by DecodeTurns(), i.e. when a conversation is actually resumed.
+ */
+class GENAIEXAMPLE_API FGXConversationArchiveReader
+{
+public:
+	FGXConversationArchiveReader();
+	~FGXConversationArchiveReader();
+
+	FGXConversationArchiveReader(const FGXConversationArchiveReader&) = delete;
+	FGXConversationArchiveReader& operator=(const FGXConversationArchiveReader&) = delete;
+
+	bool Open(const FString& FilePath, FString& OutError);
+	void Close();
+	bool IsOpen() const { return Data != nullptr; }
+
+	int32 GetTurnCount() const { return TurnCount; }
+	FString GetSystemPrompt() const;
+	FString GetTurnRole(int32 TurnIndex) const;
+	FString GetTurnText(int32 TurnIndex) const;
+
+	int32 GetAttachmentCount() const { return AttachmentCount; }
+
+	/** File the attachment is stored in, whether or not it still exists. */
+	FString GetAttachmentPath(int32 AttachmentIndex) const;
+
+	/**
+	 * @brief Fully decodes the conversation.
+	 * @param bLoadAttachments If false, image attachments are skipped (no disk reads beyond the mapping).
+	 * @return False if the payload checksum or any record is invalid.
+	 */
+	bool DecodeTurns(TArray<FGXChatTurn>& OutTurns, bool bLoadAttachments, FString& OutError) const;
+
+private:
+	bool ReadString(uint32 BlobRelativeOffset, FString& OutString) const;
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	/** Used when the platform cannot memory-map the file. */
+	TArray64<uint8> FallbackBuffer;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+
+	int32 TurnCount = 0;
+	int32 AttachmentCount = 0;
+	uint32 SystemPromptOffset = 0;
+	int64 TurnTableOffset = 0;
+	int64 AttachmentTableOffset = 0;
+	int64 BlobOffset = 0;
+	int64 BlobSize = 0;
+	uint32 PayloadCrc = 0;
+};
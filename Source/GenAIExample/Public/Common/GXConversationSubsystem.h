@@ -0,0 +1,271 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Http.h"
+#include "Common/GXChatTypes.h"
+#include "Common/GXModelRouter.h"
+#include "Common/GXRequestWatchdog.h"
+#include "GXConversationSubsystem.generated.h"
+
+/** Lightweight reference to a session. Goes stale when the session is destroyed and its slot reused. */
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXConversationHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Conversations")
+	int32 Index = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Conversations")
+	int32 Generation = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+	bool operator==(const FGXConversationHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+};
+
+/** Counters shared by every session of a world. */
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXConversationStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Conversations")
+	int32 LiveSessions = 0;
+
+	/** Idle sessions whose history was moved to disk. They are restored on the next message. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Conversations")
+	int32 ArchivedSessions = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Conversations")
+	int32 InFlightRequests = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Conversations")
+	int32 QueuedRequests = 0;
+
+	/** UTF-8 bytes held by resident histories. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Conversations")
+	int64 HistoryBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Conversations")
+	int32 CompletedRequests = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Conversations")
+	int32 FailedRequests = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Conversations")
+	int32 CacheHits = 0;
+
+	/** EWMA of the time from dispatch to completion. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Conversations")
+	float AverageLatencyMs = 0.f;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnGXConversationReply, FGXConversationHandle, Handle, const FString&, Response, bool, bSuccess);
+
+/**
+ * Holds many lightweight NPC conversations per world without an actor per conversation.
+ *
+ * Sessions live in structure-of-arrays storage indexed by FGXConversationHandle. Histories are
+ * compact UTF-8 turn records, system prompts and routing policies are interned and shared, and
+ * sessions idle for ArchiveAfterIdleSeconds are swapped out to disk. All sessions share one request
+ * scheduler (a concurrency cap with a FIFO queue), the model router and its circuit breakers,
+ * per-slot deadline watchdogs, a first-turn response cache and one set of counters.
+ *
+ * Sessions are text only. Archived sessions are swap files owned by this subsystem and are deleted
+ * with the session; use FGXConversationArchive directly to persist a conversation.
+ */
+UCLASS(Config = Game)
+class GENAIEXAMPLE_API UGXConversationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static UGXConversationSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * @brief Creates a session. Cheap: no request is sent until the first message.
+	 * @param SystemPrompt Persona for the session. Identical prompts are stored once.
+	 * @param Policy Routing policy used for every message of the session.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Conversations")
+	FGXConversationHandle CreateSession(const FString& SystemPrompt, const FGXRoutingPolicy& Policy);
+
+	/** Destroys a session, cancelling its request if one is in flight. */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Conversations")
+	void DestroySession(FGXConversationHandle Handle);
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Conversations")
+	bool IsValidSession(FGXConversationHandle Handle) const;
+
+	/** True while a message of the session is queued or in flight. */
+	UFUNCTION(BlueprintPure, Category = "GenAI|Conversations")
+	bool IsBusy(FGXConversationHandle Handle) const;
+
+	/**
+	 * @brief Queues a user message. The reply arrives through OnConversationReply.
+	 * @return False if the handle is stale, the session is busy or the queue is full.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Conversations")
+	bool SendMessage(FGXConversationHandle Handle, const FString& UserMessage);
+
+	/** Decodes the session's history. Restores the session from disk if it was archived. */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Conversations")
+	TArray<FGXChatTurn> GetHistory(FGXConversationHandle Handle);
+
+	/** Moves an idle session's history to disk now. */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Conversations")
+	bool ArchiveSession(FGXConversationHandle Handle);
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Conversations")
+	FGXConversationStats GetStats() const { return Stats; }
+
+	/** Fired for every completed message, successful or not. */
+	UPROPERTY(BlueprintAssignable, Category = "GenAI|Conversations")
+	FOnGXConversationReply OnConversationReply;
+
+	/** Requests in flight at once across all sessions. Further messages wait in a FIFO queue. */
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Conversations", meta = (ClampMin = "1"))
+	int32 MaxConcurrentRequests = 8;
+
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Conversations", meta = (ClampMin = "0"))
+	int32 MaxQueuedRequests = 4096;
+
+	/** Oldest turns beyond this are dropped, bounding both memory and prompt size. */
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Conversations", meta = (ClampMin = "2"))
+	int32 MaxHistoryTurns = 24;
+
+	/** Idle time after which a session's history is swapped to disk. Zero disables archiving. */
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Conversations", meta = (ClampMin = "0.0", Units = "s"))
+	float ArchiveAfterIdleSeconds = 120.f;
+
+	/** Opening lines are often identical across NPCs sharing a persona; their replies are cached. Zero disables. */
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Conversations", meta = (ClampMin = "0"))
+	int32 ResponseCacheCapacity = 256;
+
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Conversations")
+	FGXRequestTimeouts RequestTimeouts;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum ESessionFlags : uint8
+	{
+		Session_Live     = 1 << 0,
+		Session_Queued   = 1 << 1,
+		Session_InFlight = 1 << 2,
+		Session_Archived = 1 << 3
+	};
+
+	/** Everything an opening reply depends on. Compared in full on lookup, so hash collisions cannot mix up replies. */
+	struct FResponseCacheKey
+	{
+		int32 PromptId = INDEX_NONE;
+		int32 PolicyId = INDEX_NONE;
+		FString UserMessage;
+
+		bool operator==(const FResponseCacheKey& Other) const
+		{
+			return PromptId == Other.PromptId && PolicyId == Other.PolicyId && UserMessage.Equals(Other.UserMessage, ESearchCase::CaseSensitive);
+		}
+
+		friend uint32 GetTypeHash(const FResponseCacheKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.PromptId), GetTypeHash(Key.PolicyId)), GetTypeHash(Key.UserMessage));
+		}
+	};
+
+	/** One concurrent request. Slots are allocated once and reused. */
+	struct FRequestSlot
+	{
+		int32 Session = INDEX_NONE;
+		uint32 SessionGeneration = 0;
+		FGXModelEndpoint Endpoint;
+		FHttpRequestPtr Request;
+		FGXRequestWatchdog Watchdog;
+		double StartSeconds = 0.0;
+		bool bFirstTokenReported = false;
+		/** Set if the reply may be stored in the response cache under CacheKey. */
+		bool bCacheable = false;
+		FResponseCacheKey CacheKey;
+	};
+
+	struct FQueuedMessage
+	{
+		int32 Session = INDEX_NONE;
+		uint32 Generation = 0;
+	};
+
+	struct FCachedReply
+	{
+		FGXConversationHandle Handle;
+		FString Response;
+	};
+
+	bool ResolveHandle(FGXConversationHandle Handle, int32& OutIndex) const;
+	FGXConversationHandle MakeHandle(int32 Index) const;
+
+	int32 InternPrompt(const FString& SystemPrompt);
+	int32 InternPolicy(const FGXRoutingPolicy& Policy);
+
+	void AppendTurn(int32 Index, bool bAssistant, const FString& Text);
+	void RemoveLastTurn(int32 Index);
+	void TrimHistory(int32 Index);
+	void DecodeHistory(int32 Index, TArray<FGXChatTurn>& OutTurns) const;
+	FString GetLastTurnText(int32 Index) const;
+	void FreeHistory(int32 Index);
+
+	bool ArchiveSessionIndex(int32 Index);
+	bool EnsureResident(int32 Index);
+	FString GetArchivePath(int32 Index) const;
+
+	FResponseCacheKey MakeCacheKey(int32 Index, const FString& UserMessage) const;
+
+	/** Starts queued messages while request slots are free. */
+	void PumpQueue();
+	bool StartRequest(FRequestSlot& Slot, int32 SlotIndex, int32 Index);
+	void CompleteRequest(int32 SlotIndex, const FString& Response, const FString& Error, bool bSuccess, bool bTimedOut);
+	void CancelSlot(FRequestSlot& Slot);
+
+	float GetNowSeconds() const { return static_cast<float>(FPlatformTime::Seconds() - StartTimeSeconds); }
+
+	// -- Session storage, one element per session slot --
+	TArray<uint32> Generations;
+	TArray<uint8> Flags;
+	TArray<uint16> TurnCounts;
+	TArray<int32> PromptIds;
+	TArray<int32> PolicyIds;
+	TArray<float> LastActiveSeconds;
+	/** [uint8 bAssistant][uint32 ByteLength][UTF-8] records, oldest first. */
+	TArray<TArray<uint8>> Histories;
+	TArray<int32> FreeIndices;
+
+	// -- Interned, shared between sessions --
+	TArray<FString> SharedPrompts;
+	TMap<FString, int32> PromptLookup;
+	TArray<FGXRoutingPolicy> SharedPolicies;
+
+	// -- Scheduler --
+	TArray<TUniquePtr<FRequestSlot>> Slots;
+	TArray<FQueuedMessage> Queue;
+	int32 QueueHead = 0;
+	bool bPumpingQueue = false;
+
+	// -- Response cache (FIFO eviction) --
+	TMap<FResponseCacheKey, FString> ResponseCache;
+	TArray<FResponseCacheKey> CacheOrder;
+	/** Cache hits are delivered on the next tick so replies never fire from inside SendMessage. */
+	TArray<FCachedReply> PendingCachedReplies;
+
+	FGXConversationStats Stats;
+	double StartTimeSeconds = 0.0;
+	float ArchiveScanAccumulator = 0.f;
+};
@@ -0,0 +1,57 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture2D.h"
+
+/**
+ * Persistent, content-addressed cache of generated images.
+ *
+ * Entries are keyed by a SHA1 of the canonicalised request (provider, model, prompt and settings) and stored
+ * as a complete mip chain in the texture's pixel format, so a hit needs neither the network nor an image decode.
+ *
+ * File layout (little endian), Saved/GenAI/ImageCache/<key>.gxtex:
+ *   FHeader     32 bytes              (checksum of itself and the mip table)
+ *   FMipEntry   24 bytes x MipCount   (offset, size and checksum, largest mip first)
+ *   Mip payloads
+ *
+ * Every level's size is checked against its pixel format and dimensions, and each loaded level against its
+ * checksum; an entry that fails is deleted and reported as a miss, so the image is generated again.
+ *
+ * Loads can skip the top mips with MaxDimension, reading only the levels that are needed from disk.
+ * Files are touched on every hit and the least recently used ones are deleted past MaxCacheBytes.
+ */
+struct GENAIEXAMPLE_API FGXImageCache
+{
+	static constexpr uint32 Magic = 0x58545847; // "GXTX"
+	static constexpr uint16 Version = 2;
+
+	/** Disk budget for the whole cache. */
+	static constexpr int64 MaxCacheBytes = 1024ll * 1024 * 1024;
+
+	/** Saved/GenAI/ImageCache/ */
+	static FString GetDirectory();
+
+	/**
+	 * @brief Builds the cache key of a request. Whitespace in the prompt is collapsed and the model name is case-folded,
+	 *        so trivially different spellings of the same request share an entry.
+	 * @param Settings Every other setting that changes the output (size, quality, aspect ratio, ...), in a fixed order.
+	 */
+	static FString MakeKey(const FString& Provider, const FString& Model, const FString& Prompt, const TArray<FString>& Settings);
+
+	static bool Contains(const FString& Key);
+
+	/**
+	 * @brief Builds the mip chain and writes the entry on a worker. Safe to call from any thread.
+	 * @param Pixels BGRA8 pixels of the full-size image.
+	 */
+	static void StoreAsync(const FString& Key, TArray64<uint8> Pixels, int32 Width, int32 Height);
+
+	/**
+	 * @brief Reads an entry on a worker and creates the texture on the game thread.
+	 * @param MaxDimension Mips larger than this are not read. Zero loads the full chain.
+	 * @param OnComplete Called on the game thread once the texture is ready on the GPU, with null on a miss or a damaged entry.
+	 */
+	static void LoadAsync(const FString& Key, int32 MaxDimension, TFunction<void(UTexture2D*)> OnComplete);
+};
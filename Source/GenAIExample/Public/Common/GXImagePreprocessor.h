@@ -0,0 +1,148 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture2D.h"
+#include "Common/GXChatTypes.h"
+
+#if WITH_GENAI_MODULE
+#include "Data/GenAIMessageStructs.h"
+#endif
+
+#include "GXImagePreprocessor.generated.h"
+
+UENUM(BlueprintType)
+enum class EGXImageDetailPolicy : uint8
+{
+	/** Low detail when the prepared image would fit the low-detail size anyway, high detail otherwise. */
+	Auto,
+	/** Always low detail: the image is shrunk to 512 px and billed at the flat low-detail rate. */
+	Low,
+	High
+};
+
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXImagePreprocessSettings
+{
+	GENERATED_BODY()
+
+	/** Resize images to what the model actually looks at before sending them. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Preprocessing")
+	bool bEnabled = true;
+
+	/** Detail level requested from providers that have one (OpenAI). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Preprocessing")
+	EGXImageDetailPolicy Detail = EGXImageDetailPolicy::Auto;
+
+	/** Upper bound on the longer edge, below the model's own limit. Zero uses the model's limit. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Preprocessing", meta = (ClampMin = "0"))
+	int32 MaxLongEdge = 0;
+
+	/**
+	 * Shrink an image by up to this fraction when that saves a whole tile of the model's tile grid,
+	 * e.g. 1100 px becomes 1024 px and drops a row of 512 px tiles.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Preprocessing", meta = (ClampMin = "0", ClampMax = "0.5"))
+	float TileSnapTolerance = 0.15f;
+};
+
+/** What preprocessing one image saved. Byte counts are uncompressed pixels; the encoded upload shrinks roughly in proportion. */
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXImagePreprocessStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Image Preprocessing")
+	FIntPoint OriginalSize = FIntPoint::ZeroValue;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Image Preprocessing")
+	FIntPoint SentSize = FIntPoint::ZeroValue;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Image Preprocessing")
+	int64 OriginalBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Image Preprocessing")
+	int64 SentBytes = 0;
+
+	/** Estimated vision tokens for the original image at the detail level a plain FromTexture2D(Auto) would get. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Image Preprocessing")
+	int32 OriginalTokens = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Image Preprocessing")
+	int32 SentTokens = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Image Preprocessing")
+	bool bLowDetail = false;
+
+	/** The texture that was attached: a resized copy, or the original. Whoever keeps the message must keep this alive. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Image Preprocessing")
+	TObjectPtr<UTexture2D> SentTexture;
+
+	int64 GetBytesSaved() const { return OriginalBytes - SentBytes; }
+	int32 GetTokensSaved() const { return OriginalTokens - SentTokens; }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnImagePreprocessed, const FGXImagePreprocessStats&, Stats);
+
+/** Called on the game thread with one entry per non-null source image, in order. */
+using FGXOnImagesPrepared = TFunction<void(TArray<FGXImagePreprocessStats>&& Prepared)>;
+
+/** The size and detail level an image should be sent at. */
+struct GENAIEXAMPLE_API FGXImagePlan
+{
+	int32 Width = 0;
+	int32 Height = 0;
+	bool bLowDetail = false;
+	int32 EstimatedTokens = 0;
+};
+
+/**
+ * Shrinks chat image attachments to the smallest size that keeps what the model would see.
+ *
+ * Every provider downsamples large images on its side and bills vision tokens by the size it keeps, so
+ * pixels above that size only cost upload time. The plan follows each provider's published sizing rules:
+ *   OpenAI     Fit 2048 px, shortest side 768 px, 512 px tiles at 170 tokens plus 85 (low detail: 85, 512 px).
+ *              Patch-billed models (gpt-4.1-mini/nano, o4-mini) count 32 px patches, up to 1536.
+ *   Anthropic  Long edge 1568 px and about 1.15 megapixels; width x height / 750 tokens.
+ *   Google     258 tokens up to 384 px, otherwise 258 per 768 px tile.
+ *   xAI        No published formula; estimated with OpenAI's tile model and a 1024 px limit.
+ * Token counts are estimates for reporting, not billing.
+ */
+struct GENAIEXAMPLE_API FGXImagePreprocessor
+{
+	static FGXImagePlan PlanImage(EGXChatProvider Provider, const FString& Model, int32 Width, int32 Height, const FGXImagePreprocessSettings& Settings);
+
+	static int32 EstimateTokens(EGXChatProvider Provider, const FString& Model, int32 Width, int32 Height, bool bLowDetail);
+
+	/**
+	 * @brief Returns the texture to send for an image: a resized transient copy, or Source itself if it is already small
+	 *        enough or its pixels cannot be read. Prepared copies are cached per source texture, contents and size.
+	 *        Only CPU-resident pixels are read here; GPU-only textures need PrepareAllAsync and are sent unchanged.
+	 */
+	static UTexture2D* Prepare(UTexture2D* Source, EGXChatProvider Provider, const FString& Model,
+		const FGXImagePreprocessSettings& Settings, FGXImagePreprocessStats* OutStats = nullptr);
+
+	/**
+	 * @brief Prepares several images at once without blocking the game thread. Each image is resized in its own task;
+	 *        the results are joined on the task graph and OnComplete runs on a later game-thread tick.
+	 * @param WorldContextObject Lets GPU-only textures be read back; may be null.
+	 */
+	static void PrepareAllAsync(UObject* WorldContextObject, const TArray<UTexture2D*>& Sources, EGXChatProvider Provider, const FString& Model,
+		const FGXImagePreprocessSettings& Settings, FGXOnImagesPrepared OnComplete);
+
+	/** Area-averaging BGRA8 downscale. Destination dimensions must not exceed the source's. */
+	static void Downscale(const TArray64<uint8>& Source, int32 SourceWidth, int32 SourceHeight, TArray64<uint8>& OutDest, int32 DestWidth, int32 DestHeight);
+
+	/** Drops all cached prepared images. */
+	static void ClearCache();
+
+#if WITH_GENAI_MODULE
+	/** Prepare() followed by FGenAIMessageContent::FromTexture2D with the planned detail level. */
+	static FGenAIMessageContent MakeImageContent(UTexture2D* Source, EGXChatProvider Provider, const FString& Model,
+		const FGXImagePreprocessSettings& Settings, FGXImagePreprocessStats* OutStats = nullptr);
+
+	/** FromTexture2D for an image already prepared by Prepare or PrepareAllAsync. */
+	static FGenAIMessageContent MakeImageContent(const FGXImagePreprocessStats& Prepared, EGXChatProvider Provider, const FGXImagePreprocessSettings& Settings);
+#endif
+};
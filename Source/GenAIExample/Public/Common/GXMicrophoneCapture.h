@@ -0,0 +1,95 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+namespace Audio
+{
+	class FAudioCapture;
+}
+
+/**
+ * Records the default microphone straight into memory for transcription.
+ *
+ * The mono sample buffer is allocated once when recording starts, sized for the longest take, and the
+ * capture callback only downmixes into it: nothing is locked, reallocated or written to disk while
+ * recording. Stop() resamples and encodes the take as a 16-bit WAV in a single pass, so the result can go
+ * to RequestTranscriptionFromData the moment the user stops talking.
+ */
+class GENAIEXAMPLE_API FGXMicrophoneCapture
+{
+public:
+	FGXMicrophoneCapture();
+	~FGXMicrophoneCapture();
+
+	FGXMicrophoneCapture(const FGXMicrophoneCapture&) = delete;
+	FGXMicrophoneCapture& operator=(const FGXMicrophoneCapture&) = delete;
+
+	/**
+	 * @brief Opens the default input device and starts recording. Any previous take is discarded.
+	 * @param MaxSeconds Longest take kept; audio past it is dropped and WasTruncated() becomes true.
+	 * @return False if no input device could be opened.
+	 */
+	bool Start(float MaxSeconds);
+
+	/**
+	 * @brief Stops recording and encodes the take as a mono 16-bit PCM WAV.
+	 * @param SampleRate Rate of the WAV; the take is resampled if the device runs at another rate.
+	 * @return False if nothing was recorded.
+	 */
+	bool Stop(int32 SampleRate, TArray<uint8>& OutWav);
+
+	/** Stops recording and keeps the take, for readers of GetSamples(). */
+	void Stop();
+
+	/** Stops recording and discards the take. */
+	void Cancel();
+
+	bool IsRecording() const { return bRecording; }
+
+	/** True if the last take hit its length limit. */
+	bool WasTruncated() const { return bTruncated.load(std::memory_order_relaxed); }
+
+	float GetRecordedSeconds() const;
+
+	/**
+	 * The take so far, mono at GetSampleRate(). Safe to read up to GetNumSamples() while recording: samples
+	 * below it are never written again and the buffer does not move until the next Start().
+	 */
+	const float* GetSamples() const { return Samples.GetData(); }
+	int32 GetNumSamples() const { return NumSamples.load(std::memory_order_acquire); }
+	/** The rate the capture callback reports, or the opened stream's rate until the first buffer arrives. */
+	int32 GetSampleRate() const { return DeviceSampleRate.load(std::memory_order_acquire); }
+
+	/** Rate and channel count the default input device captures at. */
+	static bool GetDefaultDeviceFormat(int32& OutSampleRate, int32& OutNumChannels);
+
+	/**
+	 * @brief Encodes mono float samples as a 16-bit PCM WAV.
+	 *        Downsampling averages the source samples under each output sample; upsampling interpolates linearly.
+	 */
+	static void EncodeWav(const float* Samples, int32 NumSamples, int32 SourceRate, int32 SampleRate, TArray<uint8>& OutWav);
+
+private:
+	/** Capture thread. */
+	void OnAudioCaptured(const float* Audio, int32 NumFrames, int32 NumChannels, int32 SampleRate);
+
+	void CloseStream();
+
+	TUniquePtr<Audio::FAudioCapture> Capture;
+
+	/** Sized for the whole take up front; only [0, NumSamples) is valid. */
+	TArray<float> Samples;
+	std::atomic<int32> NumSamples{ 0 };
+	std::atomic<bool> bTruncated{ false };
+
+	/** Set if the device changed rate mid-take; later buffers are dropped rather than mixed into the take at the wrong speed. */
+	std::atomic<bool> bRateChanged{ false };
+
+	/** Taken from the first buffer of a take, which is what the samples are actually at. */
+	std::atomic<int32> DeviceSampleRate{ 0 };
+	bool bReceivedAudio = false;
+	bool bRecording = false;
+};
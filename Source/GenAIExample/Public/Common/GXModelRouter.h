@@ -0,0 +1,215 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Common/GXChatTypes.h"
+#include "Common/GXCircuitBreaker.h"
+#include "GXModelRouter.generated.h"
+
+/** A provider/model pair the router may pick, with its static properties. */
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXModelEndpoint
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	EGXChatProvider Provider = EGXChatProvider::OpenAI;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	FString Model;
+
+	/** Bitmask of EGXModelCapability. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing", meta = (Bitmask, BitmaskEnum = "/Script/GenAIExample.EGXModelCapability"))
+	int32 Capabilities = 0;
+
+	/** Blended price in USD per 1k tokens. Only used for ranking against the policy cost ceiling. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	float CostPer1kTokens = 0.f;
+
+	/** Small models are preferred for short classification-style prompts. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	bool bIsSmallModel = false;
+
+	/** Time-to-first-token assumed before any measurement exists. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	float PriorTtftMs = 800.f;
+
+	bool HasCapabilities(int32 Required) const { return (Capabilities & Required) == Required; }
+	FString GetKey() const { return GXChatProviderToString(Provider) + TEXT(":") + Model; }
+	bool IsValid() const { return !Model.IsEmpty(); }
+};
+
+/** What a caller needs from a request. Zero means "no constraint". */
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXRoutingPolicy
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	float LatencyTargetMs = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	float CostCeilingPer1kTokens = 0.f;
+
+	/** Bitmask of EGXModelCapability every candidate must have. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing", meta = (Bitmask, BitmaskEnum = "/Script/GenAIExample.EGXModelCapability"))
+	int32 RequiredCapabilities = 0;
+
+	/** Prompts up to this length with no reasoning requirement are treated as quick classification calls. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	int32 ShortPromptMaxChars = 280;
+};
+
+/** Rolling health of one endpoint, updated from real request outcomes. */
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXEndpointHealth
+{
+	GENERATED_BODY()
+
+	/** EWMA of time to first token (or full response for non-streaming providers). */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Routing")
+	float TtftMs = 0.f;
+
+	/** EWMA of the error rate, in [0, 1]. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Routing")
+	float ErrorRate = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Routing")
+	int32 SampleCount = 0;
+
+	/** FPlatformTime::Seconds() of the last failed request, or zero if none failed. */
+	double LastFailureSeconds = 0.0;
+
+	void AddLatencySample(float Ms, float Alpha)
+	{
+		TtftMs = (SampleCount == 0 && TtftMs <= 0.f) ? Ms : FMath::Lerp(TtftMs, Ms, Alpha);
+	}
+
+	void AddOutcome(bool bSuccess, float Alpha, double NowSeconds)
+	{
+		ErrorRate = FMath::Lerp(ErrorRate, bSuccess ? 0.f : 1.f, Alpha);
+		++SampleCount;
+		if (!bSuccess)
+		{
+			LastFailureSeconds = NowSeconds;
+		}
+	}
+
+	/**
+	 * ErrorRate halved for every HalfLifeSeconds since the last failure. An endpoint the router avoids gets no
+	 * new samples, so without this one bad spell would keep it penalised for good.
+	 */
+	float GetDecayedErrorRate(double NowSeconds, float HalfLifeSeconds) const
+	{
+		if (HalfLifeSeconds <= 0.f || LastFailureSeconds <= 0.0)
+		{
+			return ErrorRate;
+		}
+		const double Elapsed = FMath::Max(0.0, NowSeconds - LastFailureSeconds);
+		return ErrorRate * static_cast<float>(FMath::Pow(2.0, -Elapsed / HalfLifeSeconds));
+	}
+};
+
+/** The kind of work a prompt represents, as guessed by the router. */
+UENUM(BlueprintType)
+enum class EGXPromptClass : uint8
+{
+	Classification,
+	General,
+	Reasoning
+};
+
+/**
+ * Picks a provider and model per request from a declared policy, using EWMA measurements of
+ * time-to-first-token and error rate for every endpoint it has routed to.
+ */
+UCLASS(Config = Game)
+class GENAIEXAMPLE_API UGXModelRouter : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Convenience accessor from any world context object. */
+	static UGXModelRouter* Get(const UObject* WorldContextObject);
+
+	/**
+	 * @brief Chooses the endpoint for a prompt.
+	 * @param Policy Latency, cost and capability constraints.
+	 * @param Prompt The user prompt, used to classify the workload.
+	 * @param OutEndpoint The selected endpoint.
+	 * @return False if no registered endpoint satisfies the capability requirements.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Routing")
+	bool SelectEndpoint(const FGXRoutingPolicy& Policy, const FString& Prompt, FGXModelEndpoint& OutEndpoint) const;
+
+	/** Same as SelectEndpoint, but skips endpoints whose keys are in Excluded. Open circuits are always skipped. */
+	bool SelectEndpointExcluding(const FGXRoutingPolicy& Policy, const FString& Prompt, const TSet<FString>& Excluded, FGXModelEndpoint& OutEndpoint) const;
+
+	/** Records the time to first token for an endpoint. */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Routing")
+	void ReportFirstToken(const FGXModelEndpoint& Endpoint, float TtftMs);
+
+	/**
+	 * @brief Records whether a request against an endpoint finished successfully.
+	 * @param bTimedOut True if the request failed because a deadline expired.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Routing")
+	void ReportOutcome(const FGXModelEndpoint& Endpoint, bool bSuccess, bool bTimedOut = false);
+
+	/**
+	 * @brief Asks the endpoint's circuit breaker for permission to send a request.
+	 * Every granted request must be followed by exactly one ReportOutcome.
+	 * @return False while the breaker is open, or half-open with its probes in use.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Routing")
+	bool TryAcquireEndpoint(const FGXModelEndpoint& Endpoint);
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Routing")
+	EGXCircuitState GetCircuitState(const FGXModelEndpoint& Endpoint) const;
+
+	/** TryAcquireEndpoint for examples that only know a provider and a model name. Allows the request if there is no router. */
+	static bool TryAcquireFor(const UObject* WorldContextObject, EGXChatProvider Provider, const FString& Model);
+
+	/** ReportOutcome for examples that only know a provider and a model name. */
+	static void ReportOutcomeFor(const UObject* WorldContextObject, EGXChatProvider Provider, const FString& Model, bool bSuccess, bool bTimedOut = false);
+
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Routing")
+	void RegisterEndpoint(const FGXModelEndpoint& Endpoint);
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Routing")
+	FGXEndpointHealth GetEndpointHealth(const FGXModelEndpoint& Endpoint) const;
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Routing")
+	const TArray<FGXModelEndpoint>& GetEndpoints() const { return Endpoints; }
+
+	/** Heuristic workload classification used by SelectEndpoint. Reasoning hints match whole words only. */
+	UFUNCTION(BlueprintPure, Category = "GenAI|Routing")
+	static EGXPromptClass ClassifyPrompt(const FGXRoutingPolicy& Policy, const FString& Prompt);
+
+	/** Weight of the newest sample in every EWMA. */
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Routing", meta = (ClampMin = "0.01", ClampMax = "1.0"))
+	float EwmaAlpha = 0.2f;
+
+	/** Time for an endpoint's error penalty to halve once it stops failing. Zero keeps the penalty until new samples arrive. */
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Routing", meta = (ClampMin = "0.0", Units = "s"))
+	float ErrorRateHalfLifeSeconds = 60.f;
+
+	/** Shared by every endpoint's breaker. */
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Routing")
+	FGXCircuitBreakerSettings CircuitBreakerSettings;
+
+	/** Endpoints loaded from config. When empty, a built-in table is used. */
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Routing")
+	TArray<FGXModelEndpoint> Endpoints;
+
+private:
+	/** Expected latency adjusted for the recent failure rate. Lower is better. */
+	float ScoreEndpoint(const FGXModelEndpoint& Endpoint) const;
+
+	TMap<FString, FGXEndpointHealth> Health;
+	TMap<FString, FGXCircuitBreaker> Breakers;
+};
@@ -0,0 +1,37 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Http.h"
+
+/** Callbacks for a progressive image request. All of them run on the game thread. */
+struct GENAIEXAMPLE_API FGXProgressiveImageCallbacks
+{
+	/** Called with the encoded bytes of each partial image, lowest index first. Stale partials are dropped. */
+	TFunction<void(TArray<uint8>&& ImageBytes, int32 PartialIndex)> OnPartialImage;
+
+	/** Called exactly once with the final image, or with an error. */
+	TFunction<void(TArray<uint8>&& ImageBytes, const FString& Error, bool bSuccess)> OnComplete;
+
+	/** Called whenever data arrives, for deadline tracking. */
+	TFunction<void()> OnActivity;
+};
+
+/**
+ * Streams an OpenAI image generation (gpt-image-1 with partial_images) over server-sent events.
+ *
+ * The GenAI plugin only exposes complete images, so this talks to /v1/images/generations directly.
+ * Event payloads carry megabytes of base64; JSON parsing and base64 decoding run on a worker and the
+ * game thread only scans the response for event boundaries.
+ */
+struct GENAIEXAMPLE_API FGXProgressiveImageRequest
+{
+	/**
+	 * @param PartialImages Number of previews the server should send before the final image (1-3).
+	 * @param Size E.g. "1024x1024".
+	 * @param Quality E.g. "low", "medium", "high" or "auto".
+	 * @return The in-flight request, for cancellation. Null if no API key is configured; no callback is called then.
+	 */
+	static FHttpRequestPtr Send(const FString& Prompt, const FString& Model, int32 PartialImages, const FString& Size, const FString& Quality, FGXProgressiveImageCallbacks Callbacks);
+};
@@ -0,0 +1,193 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sound/SoundWaveProcedural.h"
+#include "Common/GXSpscRingBuffer.h"
+#include <atomic>
+#include "GXRealtimeSpeechWave.generated.h"
+
+/** How much streamed speech is held back before playing, and how gaps in it are covered. */
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXSpeechPlayoutSettings
+{
+	GENERATED_BODY()
+
+	/** Speech buffered before a response starts playing on a steady connection. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Speech Playout", meta = (ClampMin = "0", Units = "ms"))
+	float MinBufferMs = 40.f;
+
+	/** Upper bound for the buffer on a jittery connection. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Speech Playout", meta = (ClampMin = "0", Units = "ms"))
+	float MaxBufferMs = 300.f;
+
+	/** When speech runs out mid-response, the last few milliseconds are repeated and faded out over this long. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Speech Playout", meta = (ClampMin = "0", Units = "ms"))
+	float ConcealmentMs = 60.f;
+};
+
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXSpeechPlayoutStats
+{
+	GENERATED_BODY()
+
+	/** Speech received but not played yet. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Speech Playout")
+	float BufferedMs = 0.f;
+
+	/** Buffer a response waits for before it starts, from the measured jitter. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Speech Playout")
+	float TargetMs = 0.f;
+
+	/** Smoothed lateness of chunks that arrived after the previous one would have finished playing. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Speech Playout")
+	float JitterMs = 0.f;
+
+	/** Times playback ran dry and more speech followed shortly after. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Speech Playout")
+	int32 Underruns = 0;
+
+	/** Total audio synthesised to cover those gaps. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Speech Playout")
+	float ConcealedMs = 0.f;
+
+	/** Responses cut short by Interrupt(). */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Speech Playout")
+	int32 Interruptions = 0;
+
+	/** Latency of the most recent interruption; see FGXSpeechInterruption::LatencyMs. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Speech Playout")
+	float LastInterruptionLatencyMs = 0.f;
+};
+
+/** What was cut off when a response was interrupted. */
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXSpeechInterruption
+{
+	GENERATED_BODY()
+
+	/** Speech of the response that was actually heard; what the conversation should be truncated to. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Speech Playout")
+	float PlayedMs = 0.f;
+
+	/** Speech that had arrived but was thrown away unheard. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Speech Playout")
+	float DiscardedMs = 0.f;
+
+	/** From the moment passed to Interrupt(), e.g. when the user started talking, to the playout going silent. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Speech Playout")
+	float LatencyMs = 0.f;
+};
+
+/**
+ * Procedural sound for streamed speech that the audio render thread pulls straight from the network thread.
+ *
+ * Received PCM16 goes into a lock-free ring and OnGeneratePCMAudio() reads it on the audio render thread,
+ * so a response chunk is never copied into a game-thread task, and a slow or hitching frame cannot starve
+ * playback. While the ring is empty the wave plays silence instead of finishing, so its audio component can
+ * keep playing for the whole session and the first chunk of a response is heard on the next audio callback.
+ *
+ * The ring doubles as an adaptive jitter buffer. Enqueue() tracks how late chunks arrive relative to the
+ * audio already queued and picks a start-up depth between MinBufferMs and MaxBufferMs from that. If playback
+ * still runs dry, the last 10 ms are played back and forth with a fade so the gap is not a click, and
+ * the next chunk fades in.
+ */
+UCLASS()
+class GENAIEXAMPLE_API UGXRealtimeSpeechWave : public USoundWaveProcedural
+{
+	GENERATED_BODY()
+
+public:
+	/** Audio render thread, when queued speech has all been played. */
+	using FOnDrained = TFunction<void()>;
+
+	/** Audio render thread, when Interrupt() cut a response short. */
+	using FOnInterrupted = TFunction<void(const FGXSpeechInterruption& Interruption)>;
+
+	/** Audio render thread, when a response's first audio is handed to the mixer. */
+	using FOnStarted = TFunction<void()>;
+
+	UGXRealtimeSpeechWave(const FObjectInitializer& ObjectInitializer);
+
+	/**
+	 * @brief Sets up mono playback and allocates the ring. Call on the game thread before playing.
+	 * @param BufferSeconds Speech that can be queued ahead of playback; responses stream faster than real time.
+	 */
+	void Initialize(int32 InSampleRate, float BufferSeconds, const FGXSpeechPlayoutSettings& InSettings,
+		FOnDrained InOnDrained = nullptr, FOnInterrupted InOnInterrupted = nullptr, FOnStarted InOnStarted = nullptr);
+
+	/**
+	 * @brief Queues mono PCM16 for playback. One producer thread at a time; never blocks or allocates.
+	 * @return False if the ring was full and some of the audio was dropped.
+	 */
+	bool Enqueue(const uint8* PCM, int32 NumBytes);
+
+	/**
+	 * @brief Any thread. Silences playout from the next audio callback and discards all queued speech, e.g. when
+	 *        the user barges in. Reports what was heard through the OnInterrupted callback if a response was playing.
+	 * @param StartSeconds FPlatformTime::Seconds() the interruption is measured from; now if zero. A request made before
+	 *        the next audio callback keeps the earlier of the two starts.
+	 */
+	void Interrupt(double StartSeconds = 0.0);
+
+	/** Any thread. Buffer depth is approximate off the audio render thread. */
+	FGXSpeechPlayoutStats GetStats() const;
+
+	//~ USoundWaveProcedural
+	virtual int32 OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 NumSamples) override;
+
+private:
+	enum class EPlayout : uint8
+	{
+		Idle,
+		Buffering,
+		Playing,
+		Concealing
+	};
+
+	/** Audio render thread helpers. */
+	void FadeIn(int16* Samples, int32 Count);
+	void RememberTail(const int16* Samples, int32 Count);
+	void Conceal(int16* Out, int32 Count);
+
+	TGXSpscRingBuffer<int16> Ring;
+	FOnDrained OnDrained;
+	FOnInterrupted OnInterrupted;
+	FOnStarted OnStarted;
+	FGXSpeechPlayoutSettings Settings;
+	int32 StreamSampleRate = 0;
+
+	std::atomic<bool> bInterruptRequested{ false };
+	std::atomic<double> InterruptStartSeconds{ 0.0 };
+
+	/** Producer thread. */
+	double LastArrivalSeconds = 0.0;
+	double LastChunkSeconds = 0.0;
+	double JitterSeconds = 0.0;
+
+	/** Written by the producer, read by the audio render thread. */
+	std::atomic<int32> TargetSamples{ 0 };
+	std::atomic<float> PublishedJitterMs{ 0.f };
+
+	/** Written by the audio render thread. */
+	std::atomic<int32> Underruns{ 0 };
+	std::atomic<int64> ConcealedSamples{ 0 };
+	std::atomic<int32> Interruptions{ 0 };
+	std::atomic<float> LastInterruptionLatencyMs{ 0.f };
+
+	/** Audio render thread only. */
+	EPlayout Playout = EPlayout::Idle;
+	int32 IdleSamples = 0;
+	int32 BufferingSamples = 0;
+	int32 FadeInPosition = 0;
+	int32 ConcealPosition = 0;
+	int32 ConcealSamples = 0;
+	int32 FadeSamples = 0;
+
+	/** Speech played since the current response started. */
+	int32 ResponsePlayedSamples = 0;
+
+	/** The last 10 ms played, the source for concealment. */
+	TArray<int16> Tail;
+};
@@ -0,0 +1,109 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Http.h"
+#include "GXRequestWatchdog.generated.h"
+
+/** Per-request deadlines. A value of zero disables that deadline. */
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXRequestTimeouts
+{
+	GENERATED_BODY()
+
+	/** Time allowed until the server responds at all (response headers or first chunk). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts", meta = (ClampMin = "0.0", Units = "s"))
+	float ConnectSeconds = 15.f;
+
+	/** Streaming only: time allowed until the first chunk arrives. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts", meta = (ClampMin = "0.0", Units = "s"))
+	float FirstByteSeconds = 45.f;
+
+	/** Streaming only: longest allowed gap between two chunks. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts", meta = (ClampMin = "0.0", Units = "s"))
+	float IdleSeconds = 20.f;
+
+	/** Hard limit for the whole request. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts", meta = (ClampMin = "0.0", Units = "s"))
+	float TotalSeconds = 120.f;
+};
+
+UENUM(BlueprintType)
+enum class EGXTimeoutKind : uint8
+{
+	None,
+	Connect,
+	FirstByte,
+	Idle,
+	Total
+};
+
+/**
+ * Enforces FGXRequestTimeouts on one in-flight request at a time.
+ *
+ * Usage: call Begin() before sending and capture the returned generation in the response callbacks;
+ * call Watch() with the request once it exists; call NotifyActivity() for every streamed chunk and
+ * Stop() when the request finishes. When a deadline expires the watchdog cancels the request, bumps
+ * the generation so late callbacks from it can be recognised with IsCurrent(), and calls OnExpired
+ * on the game thread so the owner can reset its state.
+ */
+class GENAIEXAMPLE_API FGXRequestWatchdog
+{
+public:
+	FGXRequestWatchdog() = default;
+	~FGXRequestWatchdog();
+
+	FGXRequestWatchdog(const FGXRequestWatchdog&) = delete;
+	FGXRequestWatchdog& operator=(const FGXRequestWatchdog&) = delete;
+
+	/** Starts a new request generation. Any callback holding an older generation is stale from now on. */
+	uint32 Begin();
+
+	/** True if Generation belongs to the request currently being watched (or last finished normally). */
+	bool IsCurrent(uint32 Generation) const { return Generation == CurrentGeneration; }
+
+	/**
+	 * @brief Starts enforcing deadlines on an HTTP request.
+	 * @param bStreaming Enables the first-byte and idle deadlines, which need NotifyActivity() calls.
+	 */
+	void Watch(FHttpRequestPtr Request, const FGXRequestTimeouts& Timeouts, bool bStreaming, TFunction<void(EGXTimeoutKind)> OnExpired);
+
+	/** Same as above for requests that are not a bare IHttpRequest (e.g. async actions). Cancel is called on expiry. */
+	void Watch(TFunction<void()> Cancel, const FGXRequestTimeouts& Timeouts, bool bStreaming, TFunction<void(EGXTimeoutKind)> OnExpired);
+
+	/** Records that data arrived. Ends the connect and first-byte phases and resets the idle deadline. */
+	void NotifyActivity();
+
+	/** Stops watching without cancelling. Call when the request finished on its own. */
+	void Stop();
+
+	bool IsWatching() const { return TickerHandle.IsValid(); }
+
+	static FString DescribeTimeout(EGXTimeoutKind Kind);
+
+	/**
+	 * True if a request that was just sent is still waiting on the server. A send can fail, or its callback can
+	 * run, before the send call returns; Watch() only belongs after a send for which this holds, and a request
+	 * handle should only be kept in that case, since the callback has already released the slot otherwise.
+	 */
+	static bool IsInFlight(const FHttpRequestPtr& Request) { return Request.IsValid() && Request->GetStatus() == EHttpRequestStatus::Processing; }
+
+private:
+	bool Tick(float DeltaTime);
+	void StartTicker();
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FHttpRequestPtr Request;
+	TFunction<void()> CancelFunction;
+	TFunction<void(EGXTimeoutKind)> OnExpiredFunction;
+	FGXRequestTimeouts Timeouts;
+
+	double StartSeconds = 0.0;
+	double LastActivitySeconds = 0.0;
+	bool bStreaming = false;
+	bool bConnected = false;
+	bool bHasActivity = false;
+	uint32 CurrentGeneration = 0;
+};
@@ -0,0 +1,129 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Http.h"
+#include "GXSegmentedTranscriber.generated.h"
+
+class FGXMicrophoneCapture;
+
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXSegmentedTranscriptionSettings
+{
+	GENERATED_BODY()
+
+	/** A pause only ends a segment once the segment is at least this long; shorter segments lose context. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Segmented Transcription", meta = (ClampMin = "1.0", Units = "s"))
+	float MinSegmentSeconds = 4.f;
+
+	/** Segments are cut at their quietest point once they reach this length, pause or not. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Segmented Transcription", meta = (ClampMin = "2.0", Units = "s"))
+	float MaxSegmentSeconds = 15.f;
+
+	/** How long the level must stay below SilenceThresholdDb to count as a pause. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Segmented Transcription", meta = (ClampMin = "0.05", Units = "s"))
+	float SilenceSeconds = 0.35f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Segmented Transcription", meta = (ClampMax = "0.0"))
+	float SilenceThresholdDb = -40.f;
+
+	/** Segments waiting beyond this many uploads are queued. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Segmented Transcription", meta = (ClampMin = "1", ClampMax = "8"))
+	int32 MaxConcurrentUploads = 3;
+
+	/** A segment upload is cancelled and counted as failed after this long. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Segmented Transcription", meta = (ClampMin = "1.0", Units = "s"))
+	float SegmentTimeoutSeconds = 30.f;
+
+	/** Tail of the transcript so far passed as each segment's prompt, so words and style carry across cuts. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Segmented Transcription", meta = (ClampMin = "0"))
+	int32 PromptCharacters = 200;
+};
+
+/**
+ * Transcribes a recording in segments while it is still being recorded.
+ *
+ * Every tick the new audio in an FGXMicrophoneCapture is scanned in 10 ms frames; a segment ends in the
+ * middle of the first long enough pause past MinSegmentSeconds, or at its quietest frame once it reaches
+ * MaxSegmentSeconds. Each finished segment is encoded and uploaded right away, up to MaxConcurrentUploads
+ * at a time. Finish() sends whatever is left after the last cut, so only that tail is uploaded after the
+ * user stops speaking. Results are stitched in recording order.
+ *
+ * A segment's prompt is the transcript of the segments before it that have already come back, which is
+ * usually all of them; uploads are not held back waiting for the previous text. Game thread only.
+ */
+class GENAIEXAMPLE_API FGXSegmentedTranscriber
+{
+public:
+	/** Called with the transcript of one segment, or the error. */
+	using FOnSegmentDone = TFunction<void(bool bSuccess, const FString& TextOrError)>;
+
+	/** Sends one WAV segment for transcription and returns the request so it can be cancelled. */
+	using FSendSegment = TFunction<FHttpRequestPtr(TArray<uint8>&& WavData, const FString& Prompt, FOnSegmentDone OnDone)>;
+
+	/** Called once with the stitched transcript, or the first segment error. */
+	using FOnTranscriptComplete = TFunction<void(bool bSuccess, const FString& TranscriptOrError)>;
+
+	FGXSegmentedTranscriber() = default;
+	~FGXSegmentedTranscriber();
+
+	FGXSegmentedTranscriber(const FGXSegmentedTranscriber&) = delete;
+	FGXSegmentedTranscriber& operator=(const FGXSegmentedTranscriber&) = delete;
+
+	/**
+	 * @brief Starts cutting and sending segments of a recording that has already started.
+	 * @param Capture Must outlive the transcription, or Cancel() must be called first.
+	 * @param SampleRate Rate segments are encoded at.
+	 */
+	void Start(FGXMicrophoneCapture& Capture, const FGXSegmentedTranscriptionSettings& Settings, int32 SampleRate, FSendSegment Send);
+
+	/** Call after the recording has stopped. Sends the remaining audio and calls OnComplete when every segment is back. */
+	void Finish(FOnTranscriptComplete OnComplete);
+
+	/** Cancels every upload. No callback is called afterwards. */
+	void Cancel();
+
+	bool IsActive() const { return Capture != nullptr; }
+
+private:
+	struct FSegment
+	{
+		int32 FirstSample = 0;
+		int32 NumSamples = 0;
+		FHttpRequestPtr Request;
+		double SentSeconds = 0.0;
+		bool bSent = false;
+		bool bDone = false;
+		bool bSuccess = false;
+		FString Text;
+	};
+
+	bool Tick(float DeltaTime);
+	void ScanForCuts(bool bFinal);
+	void AddSegment(int32 EndSample);
+	void SendPending();
+	void OnSegmentDone(int32 Index, uint32 Generation, bool bSuccess, const FString& TextOrError);
+	void CompleteIfDone();
+	FString StitchedPrefix() const;
+
+	FGXMicrophoneCapture* Capture = nullptr;
+	FGXSegmentedTranscriptionSettings Settings;
+	int32 SampleRate = 0;
+	FSendSegment SendFunction;
+	FOnTranscriptComplete OnCompleteFunction;
+	FTSTicker::FDelegateHandle TickerHandle;
+	TArray<FSegment> Segments;
+
+	/** Start of the segment being recorded, and how far the pause detector has read. */
+	int32 SegmentStart = 0;
+	int32 ScanPosition = 0;
+	int32 SilentFrames = 0;
+	int32 VoicedFrames = 0;
+	int32 QuietestFrameEnd = 0;
+	float QuietestFrameEnergy = TNumericLimits<float>::Max();
+
+	bool bFinishing = false;
+	uint32 Generation = 0;
+};
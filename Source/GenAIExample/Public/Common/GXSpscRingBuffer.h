@@ -0,0 +1,105 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Fixed-capacity, lock-free ring buffer for exactly one producer thread and one consumer thread.
+ *
+ * Storage is allocated by Reserve() and never again, so neither side allocates, locks or waits. Each
+ * side owns one index and only reads the other's: the producer publishes with a release store after
+ * copying in, the consumer acquires before copying out. Call Reserve() and Reset() only while neither
+ * side is running.
+ */
+template <typename ElementType>
+class TGXSpscRingBuffer
+{
+	static_assert(TIsPODType<ElementType>::Value, "TGXSpscRingBuffer copies elements with memcpy");
+
+public:
+	/** Allocates room for at least Capacity elements, rounded up to a power of two. Empties the buffer. */
+	void Reserve(int32 Capacity)
+	{
+		const uint32 Size = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(Capacity, 2)));
+		Storage.SetNumUninitialized(Size);
+		Mask = Size - 1;
+		Reset();
+	}
+
+	void Reset()
+	{
+		Head.store(0, std::memory_order_relaxed);
+		Tail.store(0, std::memory_order_relaxed);
+	}
+
+	int32 GetCapacity() const { return Storage.Num(); }
+
+	/** Elements ready to read. Exact on the consumer thread, a lower bound elsewhere. */
+	int32 Num() const
+	{
+		return static_cast<int32>(Head.load(std::memory_order_acquire) - Tail.load(std::memory_order_acquire));
+	}
+
+	/**
+	 * @brief Producer only. Copies in as many elements as fit.
+	 * @return Elements written; the rest were dropped because the consumer fell behind.
+	 */
+	int32 Write(const ElementType* Elements, int32 Count)
+	{
+		const uint32 WriteIndex = Head.load(std::memory_order_relaxed);
+		const uint32 Free = Storage.Num() - (WriteIndex - Tail.load(std::memory_order_acquire));
+		const int32 ToWrite = FMath::Min(Count, static_cast<int32>(Free));
+		if (ToWrite > 0)
+		{
+			const int32 Start = static_cast<int32>(WriteIndex & Mask);
+			const int32 First = FMath::Min(ToWrite, Storage.Num() - Start);
+			FMemory::Memcpy(Storage.GetData() + Start, Elements, First * sizeof(ElementType));
+			FMemory::Memcpy(Storage.GetData(), Elements + First, (ToWrite - First) * sizeof(ElementType));
+		}
+		Head.store(WriteIndex + ToWrite, std::memory_order_release);
+		return ToWrite;
+	}
+
+	/**
+	 * @brief Consumer only. Copies out up to Count elements.
+	 * @return Elements read.
+	 */
+	int32 Read(ElementType* OutElements, int32 Count)
+	{
+		const uint32 ReadIndex = Tail.load(std::memory_order_relaxed);
+		const uint32 Available = Head.load(std::memory_order_acquire) - ReadIndex;
+		const int32 ToRead = FMath::Min(Count, static_cast<int32>(Available));
+		if (ToRead > 0)
+		{
+			const int32 Start = static_cast<int32>(ReadIndex & Mask);
+			const int32 First = FMath::Min(ToRead, Storage.Num() - Start);
+			FMemory::Memcpy(OutElements, Storage.GetData() + Start, First * sizeof(ElementType));
+			FMemory::Memcpy(OutElements + First, Storage.GetData(), (ToRead - First) * sizeof(ElementType));
+		}
+		Tail.store(ReadIndex + ToRead, std::memory_order_release);
+		return ToRead;
+	}
+
+	/**
+	 * @brief Consumer only. Discards up to Count elements without copying them.
+	 * @return Elements discarded.
+	 */
+	int32 Skip(int32 Count)
+	{
+		const uint32 ReadIndex = Tail.load(std::memory_order_relaxed);
+		const uint32 Available = Head.load(std::memory_order_acquire) - ReadIndex;
+		const int32 ToSkip = FMath::Min(Count, static_cast<int32>(Available));
+		Tail.store(ReadIndex + ToSkip, std::memory_order_release);
+		return ToSkip;
+	}
+
+private:
+	TArray<ElementType> Storage;
+	uint32 Mask = 0;
+
+	/** Free-running counters; their difference is the fill level even across wrap-around. */
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Head{ 0 };
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Tail{ 0 };
+};
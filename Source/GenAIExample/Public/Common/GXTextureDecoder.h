@@ -0,0 +1,90 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture2D.h"
+#include "Common/GXBlockCompressor.h"
+
+/** Where the time went while turning an encoded image into a texture. */
+struct GENAIEXAMPLE_API FGXTextureDecodeTiming
+{
+	/** Worker-thread decode of the PNG/JPEG bytes. */
+	float DecodeMs = 0.f;
+
+	/** Worker-thread mip generation and block compression. Zero when the image is left uncompressed. */
+	float CompressMs = 0.f;
+
+	/** Game-thread work: creating the texture object and handing the pixels to the render thread. This is the hitch. */
+	float GameThreadMs = 0.f;
+
+	/** From the decode request until the texture was ready on the GPU. */
+	float TotalMs = 0.f;
+
+	int32 Width = 0;
+	int32 Height = 0;
+
+	/** Size of the texture's mips in their final pixel format. */
+	int64 TextureBytes = 0;
+};
+
+class UTexture2DArray;
+
+/** Called on the game thread. Texture is null and Error is set if the image could not be decoded. */
+using FGXOnTextureDecoded = TFunction<void(UTexture2D* Texture, const FString& Error, const FGXTextureDecodeTiming& Timing)>;
+
+/** Called on the decode worker right after decoding, before the texture is created. Must not touch UObjects. */
+using FGXOnPixelsReady = TFunction<void(const TArray64<uint8>& Pixels, int32 Width, int32 Height)>;
+
+/** Creates (or recycles) the texture for decoded BGRA8 pixels on the game thread, e.g. through UGXTexturePool. */
+using FGXTextureFactory = TFunction<UTexture2D*(TArray64<uint8>&& Pixels, int32 Width, int32 Height)>;
+
+/** Called on the game thread with BGRA8 pixels. Pixels is empty and Error is set if the image could not be decoded. */
+using FGXOnPixelsDecoded = TFunction<void(TArray64<uint8>&& Pixels, int32 Width, int32 Height, const FString& Error)>;
+
+/**
+ * Turns encoded image bytes into a UTexture2D without decoding on the game thread.
+ *
+ * The bytes are decoded to BGRA8 on a worker. The game thread then only creates the transient texture,
+ * copies the pixels into its mip and queues resource creation; OnComplete fires once a render fence shows
+ * the texture exists on the GPU, so a widget that binds it never samples an empty resource.
+ */
+struct GENAIEXAMPLE_API FGXTextureDecoder
+{
+	/**
+	 * @brief Decodes any format IImageWrapper can detect (PNG, JPEG, BMP, ...).
+	 * @param OnWorkerPixels (Optional) Sees the decoded pixels on the worker, e.g. to write them to a cache.
+	 * @param TextureFactory (Optional) Supplies the texture instead of CreateTexture. Not used for block-compressed images.
+	 * @param Compression (Optional) Block compression and mips, applied on the worker after OnWorkerPixels. Images whose
+	 *        size is not a multiple of 4 stay uncompressed.
+	 */
+	static void DecodeAsync(TArray<uint8> EncodedBytes, FGXOnTextureDecoded OnComplete, FGXOnPixelsReady OnWorkerPixels = nullptr, FGXTextureFactory TextureFactory = nullptr,
+		const FGXTextureCompressionSettings& Compression = FGXTextureCompressionSettings());
+
+	/** Decodes to BGRA8 on a worker without creating a texture, for callers that combine several images. */
+	static void DecodePixelsAsync(TArray<uint8> EncodedBytes, FGXOnPixelsDecoded OnComplete);
+
+	/**
+	 * @brief Creates a texture from already decoded BGRA8 pixels. Must be called on the game thread.
+	 * @param OutGameThreadMs Receives the game-thread cost of the call.
+	 */
+	static UTexture2D* CreateTexture(const TArray64<uint8>& Pixels, int32 Width, int32 Height, float* OutGameThreadMs = nullptr);
+
+	/**
+	 * @brief Replaces the pixels of a texture made by CreateTexture, reusing its GPU resource. Must be called on the game thread.
+	 * @return False if the texture is missing or its size or format differ; create a new one then.
+	 */
+	static bool UpdateTexture(UTexture2D* Texture, TArray64<uint8>&& Pixels, int32 Width, int32 Height);
+
+	/** Same as CreateTexture for a texture array. Pixels holds SliceCount tightly packed BGRA8 slices. */
+	static UTexture2DArray* CreateTextureArray(const TArray64<uint8>& Pixels, int32 Width, int32 Height, int32 SliceCount, float* OutGameThreadMs = nullptr);
+
+	/**
+	 * @brief Creates a texture from a complete, largest-first mip chain in any pixel format. Must be called on the game thread.
+	 * @param Mips Mip payloads, consumed. Sizes must match Format and the halved dimensions of each level.
+	 */
+	static UTexture2D* CreateTextureFromMips(EPixelFormat Format, int32 Width, int32 Height, TArray<TArray64<uint8>>& Mips, float* OutGameThreadMs = nullptr);
+
+	/** Calls OnReady on the game thread once all render commands queued so far, including Texture's creation, have run. */
+	static void WhenRenderResourceReady(UTexture* Texture, TFunction<void(UTexture*)> OnReady);
+};
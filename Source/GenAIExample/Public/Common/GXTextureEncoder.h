@@ -0,0 +1,44 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture2D.h"
+
+/** Called on the game thread. PNG is empty and Error is set if the texture could not be encoded. */
+using FGXOnTextureEncoded = TFunction<void(const TArray<uint8>& PNG, const FString& Error)>;
+
+/** Called on a worker thread. Pixels is empty if the texture could not be read. */
+using FGXOnPixelsRead = TFunction<void(TArray64<uint8>&& Pixels, int32 Width, int32 Height)>;
+
+/**
+ * Encodes textures to PNG for upload without compressing on the game thread.
+ *
+ * Pixels are read from the first source that has them:
+ *   1. The platform mip, if it is CPU resident and BGRA8, RGBA8 or G8 (e.g. generated textures).
+ *   2. The editor source data, in editor builds (covers block-compressed and 16-bit assets).
+ *   3. A render target the texture is drawn into, for anything else. It is copied back with a GPU readback that
+ *      is polled once a frame, so neither the game nor the render thread waits on the GPU; the pixels arrive
+ *      a few frames later.
+ * The CPU sources are copied on the game thread; conversion and compression always run on a worker.
+ *
+ * Results are cached per texture and keyed by a hash of its pixels, so repeated edits of the same
+ * image skip the encode and a modified texture is never served a stale PNG.
+ */
+struct GENAIEXAMPLE_API FGXTextureEncoder
+{
+	static void EncodePNGAsync(UObject* WorldContextObject, UTexture2D* Texture, FGXOnTextureEncoded OnComplete);
+
+	/**
+	 * @brief Reads a texture's top mip as BGRA8 from the same sources as EncodePNGAsync. Must be called on the game thread.
+	 * @param WorldContextObject Needed only for the render-target fallback; without it, GPU-only textures cannot be read.
+	 * @param OnComplete Runs on a worker thread, after the conversion.
+	 */
+	static void ReadPixelsBGRA8Async(UObject* WorldContextObject, UTexture2D* Texture, FGXOnPixelsRead OnComplete);
+
+	/** ReadPixelsBGRA8Async for CPU-resident textures only, returning at once. Must be called on the game thread. */
+	static bool ReadPixelsBGRA8(UTexture2D* Texture, TArray64<uint8>& OutPixels, int32& OutWidth, int32& OutHeight);
+
+	/** Drops all cached encodes. */
+	static void ClearCache();
+};
@@ -0,0 +1,112 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/Texture2D.h"
+#include "Common/GXTextureDecoder.h"
+#include "GXTexturePool.generated.h"
+
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXTexturePoolStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Texture Pool")
+	int32 InUseTextures = 0;
+
+	/** Released textures kept for reuse by a result of the same size. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Texture Pool")
+	int32 FreeTextures = 0;
+
+	/** GPU memory plus the CPU copy runtime textures keep, for every pooled texture. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Texture Pool")
+	int64 ResidentBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Texture Pool")
+	int64 BudgetBytes = 0;
+
+	/** Results written into a free texture instead of a new one. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Texture Pool")
+	int32 Reuses = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Texture Pool")
+	int32 Evictions = 0;
+};
+
+USTRUCT()
+struct FGXPooledTexture
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UTexture2D> Texture;
+
+	int64 Bytes = 0;
+	double LastUsedSeconds = 0.0;
+	bool bInUse = true;
+};
+
+/**
+ * Owns the textures created for generated images and keeps them within a memory budget.
+ *
+ * A texture is in use from creation until ReleaseTexture(). Released textures stay resident and are
+ * the first to be reused: a new result of the same size is written into one of them, reusing its
+ * GPU resource. Past the budget, the least recently used free textures are dropped first; if that is
+ * not enough, the least recently touched in-use textures are dropped from the pool too, and their
+ * memory is returned once their last user lets go of them.
+ */
+UCLASS(Config = Game)
+class GENAIEXAMPLE_API UGXTexturePool : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	static UGXTexturePool* Get(const UObject* WorldContextObject);
+
+	/** A texture factory for FGXTextureDecoder::DecodeAsync that creates through the pool, or directly if there is none. */
+	static FGXTextureFactory MakeFactory(const UObject* WorldContextObject);
+
+	/** Writes BGRA8 pixels into a free texture of the same size, or creates and registers a new one. */
+	UTexture2D* CreateTexture(TArray64<uint8>&& Pixels, int32 Width, int32 Height);
+
+	/** Adds a texture created elsewhere (e.g. loaded from the image cache) to the pool's accounting. */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Texture Pool")
+	void RegisterTexture(UTexture2D* Texture);
+
+	/** Marks a texture as recently used, moving it to the back of the eviction order. */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Texture Pool")
+	void TouchTexture(UTexture2D* Texture);
+
+	/** Tells the pool the texture is no longer displayed. Its resource may be reused for a later result. */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Texture Pool")
+	void ReleaseTexture(UTexture2D* Texture);
+
+	/** Drops every free texture. */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Texture Pool")
+	void Trim();
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Texture Pool")
+	FGXTexturePoolStats GetStats() const;
+
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Texture Pool", meta = (ClampMin = "16", Units = "MB"))
+	int32 BudgetMegabytes = 512;
+
+private:
+	int32 FindEntry(const UTexture2D* Texture) const;
+	void AddEntry(UTexture2D* Texture);
+	void RemoveEntryAt(int32 Index);
+	void EnforceBudget();
+
+	static int64 CalcTextureBytes(UTexture2D* Texture);
+
+	UPROPERTY()
+	TArray<FGXPooledTexture> Entries;
+
+	int64 ResidentBytes = 0;
+	int32 Reuses = 0;
+	int32 Evictions = 0;
+};
@@ -0,0 +1,109 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Common/GXSpscRingBuffer.h"
+
+/** Tuning for FGXVoiceActivityDetector. The defaults suit close-talking headset and desk microphones. */
+struct FGXVoiceActivityConfig
+{
+	/** Rate of the mono PCM16 that is fed in. */
+	int32 SampleRate = 24000;
+
+	/** Frames quieter than this are never speech, however quiet the room is. */
+	float ThresholdDb = -45.f;
+
+	/** Frames must also be this much louder than the tracked noise floor. */
+	float NoiseMarginDb = 9.f;
+
+	/** Speech must last this long before a turn starts, so clicks and taps are ignored. */
+	int32 StartMs = 30;
+
+	/** Silence that ends a turn; speech that resumes sooner continues it. */
+	int32 SilenceMs = 400;
+
+	/** Audio from before the detected start that is sent with the turn, so the first syllable is not cut. */
+	int32 PrefixPaddingMs = 300;
+};
+
+enum class EGXVoiceActivityEvent : uint8
+{
+	SpeechStarted,
+	SpeechStopped
+};
+
+/**
+ * Cheap, local voice activity detection for streamed microphone audio.
+ *
+ * Audio is judged in 10 ms frames on three features: level against both a fixed threshold and an adaptive
+ * noise floor, the share of energy in the 300-3400 Hz speech band (rejects hum and hiss), and the
+ * zero-crossing rate (rejects broadband noise). A turn starts after StartMs of speech and ends after
+ * SilenceMs without it. Only the turn, its prefix padding and its trailing silence are passed on, so
+ * silence between turns never leaves the machine.
+ *
+ * Not thread safe; everything runs on the thread that calls Process(), normally the audio thread. Buffers
+ * are allocated by Configure() only.
+ */
+class GENAIEXAMPLE_API FGXVoiceActivityDetector
+{
+public:
+	using FEmitAudio = TFunctionRef<void(const int16* Samples, int32 NumSamples)>;
+	using FOnEvent = TFunctionRef<void(EGXVoiceActivityEvent Event)>;
+
+	/** Applies the config, allocates the frame and padding buffers and resets the state. */
+	void Configure(const FGXVoiceActivityConfig& InConfig);
+
+	/** Ends any turn without an event and forgets the padding and noise estimate. */
+	void Reset();
+
+	/**
+	 * @brief Analyses a buffer of any length and forwards the audio that belongs to a turn.
+	 * @param Emit Receives audio to send, in order. SpeechStarted is raised after the padding is emitted.
+	 * @param OnEvent Receives turn boundaries; SpeechStopped follows the last emitted audio of the turn.
+	 */
+	void Process(const int16* Samples, int32 NumSamples, FEmitAudio Emit, FOnEvent OnEvent);
+
+	bool IsSpeaking() const { return bSpeaking; }
+
+	/** How long speech has been going on when SpeechStarted is raised. */
+	int32 GetStartDelayMs() const;
+
+	/** How long the user has been quiet when SpeechStopped is raised. */
+	int32 GetStopDelayMs() const;
+
+	/** RMS of the most recent frame, 0..1. */
+	float GetLevel() const { return LastRms; }
+
+private:
+	void ProcessFrame(FEmitAudio Emit, FOnEvent OnEvent);
+	bool IsSpeechFrame(const int16* Frame);
+
+	FGXVoiceActivityConfig Config;
+
+	int32 FrameSamples = 0;
+	int32 StartFrames = 1;
+	int32 HangoverFrames = 1;
+
+	/** The frame being filled; analysed once full. */
+	TArray<int16> Frame;
+	int32 NumFrame = 0;
+
+	/** The last PrefixPaddingMs plus StartMs of audio while idle, replayed when a turn starts. */
+	TGXSpscRingBuffer<int16> Padding;
+	int32 PaddingLimit = 0;
+	TArray<int16> Scratch;
+
+	/** One-pole low-pass states at the top and bottom of the speech band. */
+	float BandTop = 0.f;
+	float BandBottom = 0.f;
+	float BandTopAlpha = 0.f;
+	float BandBottomAlpha = 0.f;
+
+	float NoiseFloorDb = -60.f;
+	float LastRms = 0.f;
+
+	bool bSpeaking = false;
+	int32 SpeechRun = 0;
+	int32 SilenceRun = 0;
+};
@@ -0,0 +1,164 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Common/GXAudioConverter.h"
+#include <atomic>
+#include "GXVoiceCaptureSubsystem.generated.h"
+
+namespace Audio
+{
+	class FAudioCapture;
+}
+
+/** One converted microphone buffer, shared by every session it is delivered to. */
+struct GENAIEXAMPLE_API FGXCapturedFrame
+{
+	/** Mono 16-bit PCM at UGXVoiceCaptureSubsystem::OutputSampleRate. */
+	TArray<uint8> PCM;
+
+	/** RMS level of PCM, 0..1. */
+	float Rms = 0.f;
+
+	/** FPlatformTime::Seconds() when the buffer arrived from the device. */
+	double CaptureSeconds = 0.0;
+
+	const int16* GetSamples() const { return reinterpret_cast<const int16*>(PCM.GetData()); }
+	int32 GetNumSamples() const { return PCM.Num() / sizeof(int16); }
+};
+
+using FGXCapturedFrameRef = TSharedRef<const FGXCapturedFrame, ESPMode::ThreadSafe>;
+
+/**
+ * Owns the world's one microphone stream and shares it between realtime voice sessions.
+ *
+ * The stream is open while at least one listener is registered. Each capture buffer is converted to mono
+ * 24 kHz PCM16 once, into a pooled frame, and that frame is handed by reference to the focused listeners
+ * only: the one owned by the actor passed to SetFocusedActor, or else the MaxFocusedSessions listeners
+ * nearest the first local player's view within FocusRadius. A lone session is focused at any distance.
+ * Unfocused sessions receive nothing, so the capture cost does not grow with the number of voice NPCs.
+ * A pooled frame is reused once no listener holds a reference to it, so a steady stream does not allocate.
+ *
+ * Frame and focus callbacks run on the capture thread, one listener at a time and never after
+ * RemoveListener has returned. Listeners must not add or remove listeners from them.
+ */
+UCLASS(Config = Game)
+class GENAIEXAMPLE_API UGXVoiceCaptureSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	using FOnFrame = TFunction<void(const FGXCapturedFrameRef& Frame)>;
+	using FOnFocusChanged = TFunction<void(bool bFocused)>;
+
+	virtual ~UGXVoiceCaptureSubsystem() override;
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static UGXVoiceCaptureSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * @brief Registers a session, opening the microphone if it is the first. Game thread.
+	 * @param Owner Placed in the world for proximity focus; null counts as always in range.
+	 * @param OnFocusChanged Called before the first frame after focus is gained and in place of the next frame
+	 *        after it is lost, e.g. to end a user turn in progress.
+	 * @return Id for RemoveListener, or INDEX_NONE if no input device could be opened.
+	 */
+	int32 AddListener(const AActor* Owner, FOnFrame OnFrame, FOnFocusChanged OnFocusChanged = nullptr);
+
+	/** Unregisters a session, waiting out a delivery in progress, and closes the microphone after the last. */
+	void RemoveListener(int32 ListenerId);
+
+	/** Sends the microphone to this actor's sessions only. Null returns to proximity focus. */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Voice Capture")
+	void SetFocusedActor(AActor* Actor);
+
+	/** True if a session owned by this actor currently receives the microphone. */
+	UFUNCTION(BlueprintPure, Category = "GenAI|Voice Capture")
+	bool IsFocused(const AActor* Actor) const;
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Voice Capture")
+	int32 GetNumListeners() const { return Listeners.Num(); }
+
+	/**
+	 * @brief Replaces the microphone with InjectAudio, e.g. for an offline replay. Game thread.
+	 * While set, the device is closed and listeners added do not open it; clearing it reopens the device for
+	 * the listeners still registered.
+	 */
+	void SetInjectedInput(bool bInjected);
+
+	bool IsInjectedInput() const { return bInjectedInput; }
+
+	/**
+	 * @brief Delivers float audio to the focused listeners exactly as a device buffer would be: converted,
+	 *        pooled and focus-gated on the calling thread. Only while SetInjectedInput is set, from one thread.
+	 * @param Audio NumFrames interleaved frames of NumChannels samples each.
+	 */
+	void InjectAudio(const float* Audio, int32 NumFrames, int32 NumChannels, int32 SampleRate);
+
+	/**
+	 * Sessions further than this from the player's view are never picked by proximity, unless only one is registered.
+	 * Zero means any distance.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Voice Capture", meta = (ClampMin = "0.0", Units = "cm"))
+	float FocusRadius = 1000.f;
+
+	/** Nearest sessions that receive the microphone at once under proximity focus. */
+	UPROPERTY(Config, EditAnywhere, Category = "GenAI|Voice Capture", meta = (ClampMin = "1"))
+	int32 MaxFocusedSessions = 1;
+
+	static constexpr int32 OutputSampleRate = 24000;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FListener
+	{
+		int32 Id = INDEX_NONE;
+		TWeakObjectPtr<const AActor> Owner;
+		bool bHasOwner = false;
+		FOnFrame OnFrame;
+		FOnFocusChanged OnFocusChanged;
+		/** Set on the game thread; the capture thread reports changes against bDeliveredFocus. */
+		std::atomic<bool> bFocused{ false };
+		bool bDeliveredFocus = false;
+	};
+
+	bool OpenStream();
+	void CloseStream();
+
+	/** Fills the frame pool before the first buffer, so the capture path starts without allocating. */
+	void ReserveFramePool();
+
+	/** Capture thread. */
+	void OnAudioCaptured(const float* Audio, int32 NumFrames, int32 NumChannels, int32 SampleRate);
+
+	/** Game thread: picks the focused listeners. */
+	void UpdateFocus();
+
+	/** Capture thread: a pooled frame no listener still holds, or a new one. */
+	TSharedRef<FGXCapturedFrame, ESPMode::ThreadSafe> AcquireFrame();
+
+	TUniquePtr<Audio::FAudioCapture> Capture;
+
+	/** Game thread. */
+	bool bInjectedInput = false;
+
+	/** Capture thread only while the stream is open, or the injecting thread while input is injected. */
+	FGXAudioConverter Converter;
+	TArray<TSharedRef<FGXCapturedFrame, ESPMode::ThreadSafe>> FramePool;
+	int32 NextPoolFrame = 0;
+
+	/** Written on the game thread and walked on the capture thread, under ListenersLock. */
+	TArray<TUniquePtr<FListener>> Listeners;
+	FCriticalSection ListenersLock;
+	int32 NextListenerId = 0;
+
+	TWeakObjectPtr<AActor> FocusedActor;
+	float FocusUpdateAccumulator = 0.f;
+};
@@ -0,0 +1,112 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include "GXVoiceLatencyTracker.generated.h"
+
+/** Points in a voice turn, from the user going quiet to the reply being heard. */
+enum class EGXVoiceStage : uint8
+{
+	/** The user stopped talking; stamped by the local VAD, back-dated by its hangover. */
+	UserSpeechEnd,
+	/** The turn's last audio and the commit went out to the server. */
+	TurnCommitted,
+	/** The server's own VAD reported the end of speech. */
+	ServerSpeechStopped,
+	/** Anything of the reply arrived: audio or transcript. */
+	FirstResponseByte,
+	/** The reply's first audio was queued for playback. */
+	FirstAudioQueued,
+	/** The reply's first audio left the jitter buffer for the mixer. */
+	FirstAudioAudible,
+
+	Num
+};
+
+/**
+ * Where the time went in one voice turn. Each stage runs from the previous stamped point, so when the points
+ * arrive in order the stages add up to TotalMs. A stage the session does not have (e.g. ServerVADMs without
+ * server VAD) is 0.
+ */
+USTRUCT(BlueprintType)
+struct GENAIEXAMPLE_API FGXVoiceTurnTimings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Voice Latency")
+	int32 TurnIndex = 0;
+
+	/** User speech end to the turn being committed: VAD hangover plus the last send. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Voice Latency")
+	float EndOfTurnMs = 0.f;
+
+	/** User speech end, or the commit, to the server reporting the end of speech. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Voice Latency")
+	float ServerVADMs = 0.f;
+
+	/** To the first byte of the reply: network round trip plus model time to first token. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Voice Latency")
+	float ResponseMs = 0.f;
+
+	/** First byte to first audio, e.g. when the transcript streams ahead of the audio. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Voice Latency")
+	float FirstAudioMs = 0.f;
+
+	/** First audio queued to first audio played: jitter buffering and the audio render period. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Voice Latency")
+	float PlayoutMs = 0.f;
+
+	/** User speech end, or the earliest stamped point, to the reply being heard. */
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Voice Latency")
+	float TotalMs = 0.f;
+};
+
+/**
+ * Stamps the stages of each voice turn on whichever thread reaches them (capture, sender, network, audio
+ * render) and reports the breakdown once the reply is audible.
+ *
+ * Stamps are lock-free and only the first of each stage per turn counts. The turn usually completes on the
+ * audio render thread, so completing it only copies its stamps. PublishCompletedTurn, called on the game thread,
+ * logs the breakdown, sets the "stat GXVoice" counters, writes the CSV profiler's GXVoice category and hands it
+ * to the OnTurnComplete callback.
+ */
+class GENAIEXAMPLE_API FGXVoiceLatencyTracker
+{
+public:
+	using FOnTurnComplete = TFunction<void(const FGXVoiceTurnTimings& Timings)>;
+
+	/** Set before the session starts. Called on the game thread, from PublishCompletedTurn. */
+	void SetOnTurnComplete(FOnTurnComplete InOnTurnComplete) { OnTurnComplete = MoveTemp(InOnTurnComplete); }
+
+	/** Any thread. Starts a new turn at the given FPlatformTime::Seconds(), abandoning an unfinished one. */
+	void BeginTurn(double UserSpeechEndSeconds);
+
+	/**
+	 * @brief Any thread. Stamps a stage of the current turn if it has not been stamped yet.
+	 *        ServerSpeechStopped begins a turn when none is open; FirstAudioAudible completes it.
+	 */
+	void Mark(EGXVoiceStage Stage, double Seconds = 0.0);
+
+	/** Abandons the current turn and restarts the turn count. */
+	void Reset();
+
+	/** Game thread, e.g. every tick. Reports the turn completed since the last call, if any. */
+	void PublishCompletedTurn();
+
+private:
+	/** Any thread, including the audio render thread: copies the stamps for PublishCompletedTurn, nothing more. */
+	void Complete();
+
+	std::atomic<double> Stamps[static_cast<int32>(EGXVoiceStage::Num)] = {};
+	std::atomic<bool> bTurnOpen{ false };
+	std::atomic<int32> TurnCount{ 0 };
+
+	/** Written by Complete while bCompletedPending is clear and read by PublishCompletedTurn while it is set. */
+	double CompletedStamps[static_cast<int32>(EGXVoiceStage::Num)] = {};
+	int32 CompletedTurnIndex = 0;
+	std::atomic<bool> bCompletedPending{ false };
+
+	FOnTurnComplete OnTurnComplete;
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GenAIExampleDelegates.h"
 #include "GameFramework/Actor.h"
+#include "Common/GXRequestWatchdog.h"
 #include "Http.h"
 
 #if WITH_GENAI_MODULE
@@ -35,6 +36,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "GenAI | UI Example")
     void ClearConversation();
 
+    /** Deadlines applied to every chat request. Streaming requests also use the first-byte and idle limits. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+    FGXRequestTimeouts RequestTimeouts;
+
     // -- DELEGATES FOR BLUEPRINT UI --
 
     UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
@@ -57,11 +62,16 @@ private:
      * @param Payload The FString data associated with the event (delta content, full message, or error).
      * @param bSuccess True if the stream is still considered successful.
      */
-    void OnStreamingChatEvent(EDeepSeekStreamEventType EventType, const FString& Payload, bool bSuccess);
+    void OnStreamingChatEvent(EDeepSeekStreamEventType EventType, const FString& Payload, bool bSuccess, uint32 RequestGeneration);
 
     // -- STATE MANAGEMENT --
     TArray<FGenChatMessage> ConversationHistory;
     FHttpRequestPtr ActiveRequestNonStreaming;
     FHttpRequestPtr ActiveRequestStreaming;
+    FString ActiveStreamingModel;
+
+    /** Enforce RequestTimeouts; one per request slot. */
+    FGXRequestWatchdog NonStreamingWatchdog;
+    FGXRequestWatchdog StreamingWatchdog;
 #endif
 };
\ No newline at end of file
@@ -18,6 +18,18 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUIStreamingError, const FString&,
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnImageGenerated, UTexture2D*, GeneratedTexture, bool, bSuccess);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnImageGenerationError, const FString&, ErrorMessage);
 
+/** A preview of an image still being generated. The texture is updated in place by later previews. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnImageGenerationProgress, UTexture2D*, PreviewTexture, int32, PartialIndex);
+
+/**
+ * Reports what turning a generated image into a texture cost.
+ * @param DecodeMs Worker-thread decode time.
+ * @param CompressMs Worker-thread block compression time, zero for uncompressed images.
+ * @param GameThreadMs Game-thread time, i.e. the hitch the image caused.
+ * @param TotalMs Time from receiving the bytes until the texture was ready.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnImageDecodeTimings, float, DecodeMs, float, CompressMs, float, GameThreadMs, float, TotalMs);
+
 
 // -- Text-to-Speech/Transcription Delegates --
 
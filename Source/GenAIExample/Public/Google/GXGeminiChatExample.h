@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GenAIExampleDelegates.h"
 #include "GameFramework/Actor.h"
+#include "Common/GXRequestWatchdog.h"
 #include "Http.h"
 
 #if WITH_GENAI_MODULE
@@ -46,6 +47,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "GenAI | UI Example")
     void ClearConversation();
 
+    /** Deadlines applied to every chat request. Streaming requests also use the first-byte and idle limits. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+    FGXRequestTimeouts RequestTimeouts;
+
     // -- DELEGATES FOR BLUEPRINT UI --
 
     UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
@@ -65,7 +70,7 @@ private:
     // -- CORE PLUGIN INTEGRATION --
 
     /** Handles the response from the streaming chat request. */
-    void OnStreamingChatEvent(EGoogleGeminiStreamEventType EventType, const FGeminiGenerateContentResponseChunk& Chunk, const FString& ErrorMessage, bool bSuccess);
+    void OnStreamingChatEvent(EGoogleGeminiStreamEventType EventType, const FGeminiGenerateContentResponseChunk& Chunk, const FString& ErrorMessage, bool bSuccess, uint32 RequestGeneration);
 
     // -- STATE MANAGEMENT --
 
@@ -75,6 +80,13 @@ private:
     /** Keeps track of the active HTTP requests to allow cancellation. */
     FHttpRequestPtr ActiveRequestNonStreaming;
     FHttpRequestPtr ActiveRequestStreaming;
+
+    /** Model of the in-flight streaming request, for circuit breaker reporting. */
+    FString ActiveStreamingModel;
+
+    /** Enforce RequestTimeouts; one per request slot. */
+    FGXRequestWatchdog NonStreamingWatchdog;
+    FGXRequestWatchdog StreamingWatchdog;
     
     /** Accumulates the full response from a streaming request. */
     FString AccumulatedStreamedResponse;
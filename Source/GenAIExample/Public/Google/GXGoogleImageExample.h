@@ -5,8 +5,12 @@
 #include "CoreMinimal.h"
 #include "GenAIExampleDelegates.h"
 #include "GameFramework/Actor.h"
+#include "Common/GXRequestWatchdog.h"
+#include "Common/GXBlockCompressor.h"
 #if WITH_GENAI_MODULE
 #include "Http.h"
+
+struct FGenGoogleImageSettings;
 #endif
 #include "GXGoogleImageExample.generated.h"
 
@@ -39,16 +43,57 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GenAI|Google Examples")
 	void RequestGoogleImageEdit(const FString& Prompt, UTexture2D* Image, const FString& ModelName);
 
+	/** Deadlines for generation and edit requests. Image models are slow, so the total limit defaults higher than chat. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+	FGXRequestTimeouts RequestTimeouts;
+
+	/** Reuse images generated earlier for the same prompt and settings, across sessions. Edits are never cached. See FGXImageCache. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Cache")
+	bool bUseImageCache = true;
+
+	/** Cached images are loaded without the mips larger than this. Zero loads full resolution. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Cache", meta = (ClampMin = "0"))
+	int32 CacheMaxDimension = 0;
+
+	/** Block-compresses generated images on the decode worker, cutting their GPU memory 4-8x at some cost in quality. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Texture Compression")
+	FGXTextureCompressionSettings TextureCompression;
+
+	/**
+	 * The texture belongs to UGXTexturePool. It is released back to the pool when the next result replaces it and on
+	 * EndPlay, after which the pool may write a later result of the same size into it; copy it to keep it longer.
+	 */
 	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
 	FOnImageGenerated OnImageGenerated;
 
 	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
 	FOnImageGenerationError OnImageGenerationError;
 
+	/** Fired before OnImageGenerated with the decode and upload cost of the image. */
+	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+	FOnImageDecodeTimings OnImageDecodeTimings;
+
+private:
+	/** Last texture passed to OnImageGenerated, released to the pool when it is replaced. */
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> DeliveredTexture;
+
 #if WITH_GENAI_MODULE
 private:
-	void OnImageResponse(const TArray<uint8>& ImageBytes, const FString& Error, bool bSuccess);
+	void SendImageRequest(const FGenGoogleImageSettings& Settings);
+	void SendImageEditRequest(const FString& Prompt, const FString& ModelName, const TArray<uint8>& PNG, uint32 Generation);
+	void OnImageResponse(const TArray<uint8>& ImageBytes, const FString& Error, bool bSuccess, uint32 RequestGeneration);
+	void OnRequestTimedOut(EGXTimeoutKind Kind);
+
+	/** Broadcasts a result and releases the one it replaces to the pool. */
+	void DeliverImage(UTexture2D* Texture);
 
 	FHttpRequestPtr ActiveRequest;
+	FGXRequestWatchdog Watchdog;
+	/** True while the edit source image is being encoded on a worker. */
+	bool bEncodingEditSource = false;
+	/** Image cache key of the current request. Empty if the result is not cached. */
+	FString ActiveCacheKey;
+	bool bLoadingFromCache = false;
 #endif
 };
@@ -0,0 +1,129 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenAIExampleDelegates.h"
+#include "GameFramework/Actor.h"
+#include "Http.h"
+#include "Common/GXChatTypes.h"
+#include "Common/GXRequestWatchdog.h"
+#include "GXImageBatchExample.generated.h"
+
+class UTexture;
+
+/** How the images of a batch are delivered. */
+UENUM(BlueprintType)
+enum class EGXImageBatchPacking : uint8
+{
+	/** One UTexture2D with the images laid out in a grid. Usable directly in UMG. */
+	Atlas,
+	/** One UTexture2DArray with an image per slice. For materials. */
+	TextureArray
+};
+
+/**
+ * @param PackedTexture A UTexture2D atlas or a UTexture2DArray, depending on the requested packing. Null if every image failed.
+ * @param Regions UV rectangle of each image in the atlas, in arrival order. For texture arrays every region is the full slice.
+ * @param FailedCount Number of requested images that failed or timed out.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnImageBatchGenerated, UTexture*, PackedTexture, const TArray<FBox2D>&, Regions, int32, FailedCount);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnImageBatchProgress, int32, FinishedCount, int32, TotalCount);
+
+/**
+ * Generates many variations of one prompt at once, e.g. portrait or icon candidates.
+ *
+ * The image APIs return one image per response, so a batch fans out into single-image requests,
+ * at most MaxConcurrentRequests at a time. Each image is decoded on a worker as soon as it arrives,
+ * and when the last one is in, all of them are packed on a worker into one atlas or texture array:
+ * a single texture object and a single upload for the whole batch.
+ */
+UCLASS()
+class GENAIEXAMPLE_API AGXImageBatchExample : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AGXImageBatchExample();
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	/**
+	 * @brief Requests Count images for the same prompt.
+	 * @param Provider OpenAI or Google. Other providers have no image generation API.
+	 * @param Prompt A description of the desired images.
+	 * @param ModelName The model to use (e.g., "dall-e-3" or "imagen-3.0-generate-002").
+	 * @param Count Number of images to generate.
+	 * @param Packing Whether to deliver an atlas or a texture array.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Image Batch Examples")
+	void RequestImageBatch(EGXChatProvider Provider, const FString& Prompt, const FString& ModelName, int32 Count = 8, EGXImageBatchPacking Packing = EGXImageBatchPacking::Atlas);
+
+	/** Cancels the running batch. Images that already arrived are discarded. */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Image Batch Examples")
+	void CancelImageBatch();
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Image Batch Examples")
+	bool IsBatchRunning() const { return bBatchRunning; }
+
+	/** Requests in flight at once. Providers rate-limit image generation well below chat. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Batch Examples", meta = (ClampMin = "1"))
+	int32 MaxConcurrentRequests = 4;
+
+	/** Largest atlas edge in pixels. Images are box-filtered down to fit. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Batch Examples", meta = (ClampMin = "256", ClampMax = "16384"))
+	int32 MaxAtlasSize = 8192;
+
+	/** Deadlines for each image request. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+	FGXRequestTimeouts RequestTimeouts;
+
+	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+	FOnImageBatchGenerated OnImageBatchGenerated;
+
+	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+	FOnImageBatchProgress OnImageBatchProgress;
+
+	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+	FOnImageGenerationError OnImageGenerationError;
+
+private:
+	/** One concurrent request. Slots are reused for the next queued image. */
+	struct FRequestSlot
+	{
+		FHttpRequestPtr Request;
+		FGXRequestWatchdog Watchdog;
+		bool bBusy = false;
+	};
+
+	struct FDecodedImage
+	{
+		TArray64<uint8> Pixels;
+		int32 Width = 0;
+		int32 Height = 0;
+	};
+
+	void StartPendingRequests();
+	void StartRequest(int32 SlotIndex);
+	void OnImageResponse(const TArray<uint8>& ImageBytes, const FString& Error, bool bSuccess, int32 SlotIndex, uint32 RequestGeneration);
+	void OnImageFinished(TArray64<uint8>&& Pixels, int32 Width, int32 Height);
+	void PackBatch();
+	void ResetBatch();
+
+	EGXChatProvider BatchProvider = EGXChatProvider::OpenAI;
+	FString BatchPrompt;
+	FString BatchModel;
+	EGXImageBatchPacking BatchPacking = EGXImageBatchPacking::Atlas;
+	int32 BatchCount = 0;
+	int32 RequestsStarted = 0;
+	int32 ImagesFinished = 0;
+	int32 ImagesFailed = 0;
+	/** Bumped per batch so decodes and packs from a cancelled batch are ignored. */
+	uint32 BatchGeneration = 0;
+	bool bBatchRunning = false;
+
+	TArray<TUniquePtr<FRequestSlot>> Slots;
+	TArray<FDecodedImage> Decoded;
+};
@@ -0,0 +1,129 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenAIExampleDelegates.h"
+#include "GameFramework/Actor.h"
+#include "Http.h"
+#include "Common/GXChatTypes.h"
+#include "Common/GXModelRouter.h"
+#include "Common/GXRequestWatchdog.h"
+#include "GXRoutedChatExample.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUIRouteSelected, EGXChatProvider, Provider, const FString&, ModelName);
+
+/**
+ * Chat example that does not take a model name. Every request is routed by UGXModelRouter
+ * to the provider and model that best fit the policy and the prompt.
+ * If the chosen endpoint fails before producing any output, the conversation is replayed
+ * against the next endpoint instead of surfacing the error.
+ */
+UCLASS()
+class GENAIEXAMPLE_API AGXRoutedChatExample : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AGXRoutedChatExample();
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	/**
+	 * @brief Sends a user message to whichever endpoint the router picks.
+	 * @param UserMessage The text from the user.
+	 * @param Policy Latency target, cost ceiling and required capabilities for this request.
+	 * @param SystemPrompt (Optional) Replaces the current system prompt.
+	 * @param Image (Optional) A UTexture2D asset; adds the Vision requirement to the policy.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Routing Examples")
+	void RequestRoutedChat(const FString& UserMessage, FGXRoutingPolicy Policy, const FString& SystemPrompt = TEXT(""), UTexture2D* Image = nullptr);
+
+	/**
+	 * @brief Sends a user message to the first healthy endpoint of an explicit, ordered failover chain.
+	 * @param UserMessage The text from the user.
+	 * @param FailoverChain Endpoints in order of preference. Endpoints with an open circuit are skipped.
+	 * @param SystemPrompt (Optional) Replaces the current system prompt.
+	 * @param Image (Optional) A UTexture2D asset for multimodal chat.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Routing Examples")
+	void RequestChatWithFailover(const FString& UserMessage, const TArray<FGXModelEndpoint>& FailoverChain, const FString& SystemPrompt = TEXT(""), UTexture2D* Image = nullptr);
+
+	/** Clears the chat history. */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Routing Examples")
+	void ClearConversation();
+
+	/**
+	 * @brief Saves the system prompt and history to Saved/GenAI/Conversations/<SlotName>.gxconv.
+	 * @return False if the archive could not be written or a request is in flight.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Routing Examples")
+	bool SaveConversation(const FString& SlotName);
+
+	/**
+	 * @brief Replaces the history with a previously saved conversation so it can be continued.
+	 * @return False if the slot does not exist or is not a valid archive.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Routing Examples")
+	bool ResumeConversation(const FString& SlotName);
+
+	/** Maximum number of endpoints tried for a single user message. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing Examples", meta = (ClampMin = "1"))
+	int32 MaxAttempts = 3;
+
+	/** Deadlines for each attempt. A timed-out attempt fails over like any other error. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+	FGXRequestTimeouts RequestTimeouts;
+
+	// -- DELEGATES FOR BLUEPRINT UI --
+
+	/** Fired for every attempt, so failovers show up as a second route. */
+	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+	FOnUIRouteSelected OnUIRouteSelected;
+
+	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+	FOnUIStreamingResponseDelta OnUIStreamingResponseDelta;
+
+	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+	FOnUIStreamingResponseCompleted OnUIStreamingResponseCompleted;
+
+	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+	FOnUIStreamingError OnUIStreamingError;
+
+private:
+	/** Adds the user turn and starts the first attempt. */
+	void BeginRequest(const FString& UserMessage, const FString& InSystemPrompt, UTexture2D* Image);
+
+	/** Picks the next endpoint whose breaker admits a request and dispatches to it. Returns false if none is left. */
+	bool StartNextAttempt();
+
+	void HandleDelta(const FString& Delta);
+	void HandleComplete(const FString& Response, const FString& Error, bool bSuccess);
+	void HandleTimeout(EGXTimeoutKind Kind);
+	void FailRequest(const FString& Error);
+
+	/** Provider-neutral history. Holds the image attachments alive. */
+	UPROPERTY()
+	TArray<FGXChatTurn> ConversationHistory;
+
+	FString SystemPrompt;
+
+	// -- Per-request failover state --
+	bool bUseExplicitChain = false;
+	TArray<FGXModelEndpoint> ExplicitChain;
+	int32 NextChainIndex = 0;
+	FGXRoutingPolicy ActivePolicy;
+	FString ActivePrompt;
+	TSet<FString> TriedEndpoints;
+	int32 AttemptCount = 0;
+	FString LastError;
+
+	/** The endpoint serving the in-flight request, for health reporting. */
+	FGXModelEndpoint ActiveEndpoint;
+	FHttpRequestPtr ActiveRequest;
+	double RequestStartSeconds = 0.0;
+	bool bFirstTokenReported = false;
+	FGXRequestWatchdog Watchdog;
+};
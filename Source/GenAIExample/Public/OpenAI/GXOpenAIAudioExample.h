@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "GenAIExampleDelegates.h"
 #include "GameFramework/Actor.h"
+#include "Common/GXRequestWatchdog.h"
+#include "Common/GXMicrophoneCapture.h"
+#include "Common/GXSegmentedTranscriber.h"
 #if WITH_GENAI_MODULE
 #include "Http.h"
 #endif
@@ -64,11 +67,36 @@ public:
     UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI Examples")
     void RequestTranscriptionFromData(const TArray<uint8>& AudioData, const FString& ModelName = TEXT("whisper-1"), const FString& Prompt = TEXT(""), const FString& Language = TEXT(""));
 
+    /** Deadlines applied to TTS and transcription requests. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+    FGXRequestTimeouts RequestTimeouts;
+
     //~=============================================================================
     //~ Live Audio Recording
     //~=============================================================================
 
-    /** The submix to capture audio from for transcription. This must be assigned in the editor. */
+    /**
+     * Records the microphone straight into memory and sends it the moment recording stops.
+     * Turn off to record RecordingSubmix to a WAV file in Saved/BouncedWavFiles and read it back instead.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI Examples")
+    bool bUseInMemoryCapture = true;
+
+    /** Longest in-memory recording. Its buffer is allocated when recording starts; later audio is dropped. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI Examples", meta = (ClampMin = "1.0", ClampMax = "600.0", Units = "s", EditCondition = "bUseInMemoryCapture"))
+    float MaxRecordingSeconds = 120.f;
+
+    /**
+     * Transcribes in-memory recordings in segments cut at pauses while the user is still talking,
+     * so only the last segment is left to upload when recording stops.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI Examples", meta = (EditCondition = "bUseInMemoryCapture"))
+    bool bSegmentedTranscription = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI Examples", meta = (EditCondition = "bUseInMemoryCapture && bSegmentedTranscription"))
+    FGXSegmentedTranscriptionSettings SegmentedTranscription;
+
+    /** The submix to capture audio from for transcription when bUseInMemoryCapture is off. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI Examples", meta = (ToolTip = "The submix to capture audio from for transcription."))
     USoundSubmix* RecordingSubmix;
 
@@ -103,10 +131,25 @@ private:
     /** The actual file processing logic, called after a delay to avoid race conditions. */
     void ProcessRecordedFile(FString BaseFileName);
 
+    void OnTranscriptionTimedOut(EGXTimeoutKind Kind);
+
+    /** Sends one segment of a segmented transcription with the current model, prompt and language. */
+    FHttpRequestPtr SendTranscriptionSegment(TArray<uint8>&& WavData, const FString& Prompt, FGXSegmentedTranscriber::FOnSegmentDone OnDone);
+
     /** Keeps track of active HTTP requests to allow cancellation */
     TSharedPtr<IHttpRequest> ActiveTTSRequest;
     TSharedPtr<IHttpRequest> ActiveTranscriptionRequest;
 
+    /** Enforce RequestTimeouts; one per request slot. */
+    FGXRequestWatchdog TTSWatchdog;
+    FGXRequestWatchdog TranscriptionWatchdog;
+
+    /** In-memory recording used when bUseInMemoryCapture is on. */
+    FGXMicrophoneCapture MicCapture;
+
+    /** Uploads MicCapture in segments when bSegmentedTranscription is on. */
+    FGXSegmentedTranscriber SegmentTranscriber;
+
     /** Timer handle for the delay between stopping recording and processing the file. */
     FTimerHandle FileWriteDelayTimer;
     
@@ -5,6 +5,8 @@
 #include "GenAIExampleDelegates.h"
 #include "GameFramework/Actor.h"
 #include "Http.h"
+#include "Common/GXRequestWatchdog.h"
+#include "Common/GXImagePreprocessor.h"
 
 #if WITH_GENAI_MODULE
 #include "Data/GenAIMessageStructs.h"
@@ -35,6 +37,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI Examples")
     void RequestNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt = TEXT(""), UTexture2D* Image = nullptr);
 
+    /**
+     * @brief Sends a user message with any number of images for a complete, non-streaming response.
+     *        The images are prepared in parallel and the request is sent once all of them are ready.
+     * @param Images Textures to attach, in order. Null entries are skipped.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI Examples")
+    void RequestNonStreamingChatWithImages(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<UTexture2D*>& Images);
+
     /**
      * @brief Sends a user message for a streaming response.
      * @param UserMessage The text from the user.
@@ -43,16 +53,36 @@ public:
      */
     UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI Examples")
     void RequestStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt = TEXT(""), UTexture2D* Image = nullptr);
+
+    /**
+     * @brief Sends a user message with any number of images for a streaming response.
+     *        The images are prepared in parallel and the request is sent once all of them are ready.
+     * @param Images Textures to attach, in order. Null entries are skipped.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI Examples")
+    void RequestStreamingChatWithImages(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<UTexture2D*>& Images);
     
     /** Clears the chat history. */
     UFUNCTION(BlueprintCallable, Category = "GenAI | UI Example")
     void ClearConversation();
 
+    /** Deadlines applied to every chat request. Streaming requests also use the first-byte and idle limits. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+    FGXRequestTimeouts RequestTimeouts;
+
+    /** Resizes attached images to what the model actually looks at before sending them. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Preprocessing")
+    FGXImagePreprocessSettings ImagePreprocessing;
+
     // -- DELEGATES FOR BLUEPRINT UI --
 
     UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
     FOnUINonStreamingResponse OnUINonStreamingResponse;
 
+    /** Fired for each attached image with the bytes and estimated vision tokens preprocessing saved. */
+    UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+    FOnImagePreprocessed OnImagePreprocessed;
+
     UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
     FOnUIStreamingResponseDelta OnUIStreamingResponseDelta;
 
@@ -62,12 +92,20 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
     FOnUIStreamingError OnUIStreamingError;
 
-#if WITH_GENAI_MODULE
 private:
+    /** Resized attachments; ConversationHistory refers to them but does not keep them alive. */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UTexture2D>> SentImages;
+
+#if WITH_GENAI_MODULE
     // -- CORE PLUGIN INTEGRATION --
 
+    /** Builds and sends the user turn once its images are prepared. */
+    void SendNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<FGXImagePreprocessStats>& Images);
+    void SendStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<FGXImagePreprocessStats>& Images);
+
     /** Handles the response from the streaming chat request. */
-    void OnStreamingChatEvent(const FGenOpenAIStreamEvent& StreamEvent);
+    void OnStreamingChatEvent(const FGenOpenAIStreamEvent& StreamEvent, uint32 RequestGeneration);
 
     // -- STATE MANAGEMENT --
 
@@ -77,5 +115,15 @@ private:
     /** Keeps track of the active HTTP requests to allow cancellation. */
     FHttpRequestPtr ActiveRequestNonStreaming;
     FHttpRequestPtr ActiveRequestStreaming;
+
+    /** Model of the in-flight streaming request, for circuit breaker reporting. */
+    FString ActiveStreamingModel;
+
+    /** Enforce RequestTimeouts; one per request slot. */
+    FGXRequestWatchdog NonStreamingWatchdog;
+    FGXRequestWatchdog StreamingWatchdog;
+
+    /** Bumped by every send and by ClearConversation; a turn whose images finish preparing after that is dropped. */
+    uint32 PrepareGeneration = 0;
 #endif
 };
\ No newline at end of file
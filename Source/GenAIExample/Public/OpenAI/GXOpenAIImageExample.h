@@ -5,8 +5,12 @@
 #include "CoreMinimal.h"
 #include "GenAIExampleDelegates.h"
 #include "GameFramework/Actor.h"
+#include "Common/GXRequestWatchdog.h"
+#include "Common/GXBlockCompressor.h"
 #if WITH_GENAI_MODULE
 #include "Http.h"
+
+struct FGenOAIImageSettings;
 #endif
 #include "GXOpenAIImageExample.generated.h"
 
@@ -30,16 +34,75 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI Examples")
 	void RequestOpenAIImage(const FString& Prompt, const FString& ModelName);
 
+	/**
+	 * @brief Requests an image and shows partial previews while it is being generated (gpt-image-1 only).
+	 * Previews are written into one texture that is reused across progressive requests of the same size and passed
+	 * to OnImageGenerationProgress; the final image is a pooled texture of its own, passed to OnImageGenerated.
+	 * @param Prompt A description of the desired image.
+	 * @param ModelName The name of the model to use. Only gpt-image-1 streams partial images.
+	 * @param PartialImages Number of previews before the final image (1-3).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI Examples")
+	void RequestOpenAIImageProgressive(const FString& Prompt, const FString& ModelName = TEXT("gpt-image-1"), int32 PartialImages = 2);
+
+	/** Deadlines for the generation request. Image models are slow, so the total limit defaults higher than chat. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+	FGXRequestTimeouts RequestTimeouts;
+
+	/** Reuse images generated earlier for the same prompt and settings, across sessions. See FGXImageCache. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Cache")
+	bool bUseImageCache = true;
+
+	/** Cached images are loaded without the mips larger than this. Zero loads full resolution. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Cache", meta = (ClampMin = "0"))
+	int32 CacheMaxDimension = 0;
+
+	/** Block-compresses generated images on the decode worker, cutting their GPU memory 4-8x at some cost in quality. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Texture Compression")
+	FGXTextureCompressionSettings TextureCompression;
+
+	/**
+	 * The texture belongs to UGXTexturePool. It is released back to the pool when the next result replaces it and on
+	 * EndPlay, after which the pool may write a later result of the same size into it; copy it to keep it longer.
+	 */
 	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
 	FOnImageGenerated OnImageGenerated;
 
 	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
 	FOnImageGenerationError OnImageGenerationError;
 
+	/** Fired before OnImageGenerated with the decode and upload cost of the image. */
+	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+	FOnImageDecodeTimings OnImageDecodeTimings;
+
+	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+	FOnImageGenerationProgress OnImageGenerationProgress;
+
+private:
+	/** Preview target of the current progressive request, updated in place; the final image is a separate pooled texture. */
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> ProgressiveTexture;
+
+	/** Last texture passed to OnImageGenerated, released to the pool when it is replaced. */
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> DeliveredTexture;
+
 #if WITH_GENAI_MODULE
 private:
-	void OnImageResponse(const TArray<uint8>& ImageBytes, const FString& Error, bool bSuccess);
+	void SendImageRequest(const FGenOAIImageSettings& Settings);
+	void OnImageResponse(const TArray<uint8>& ImageBytes, const FString& Error, bool bSuccess, uint32 RequestGeneration);
+	/** Decodes a preview (PartialIndex >= 0) into ProgressiveTexture, or the final image (INDEX_NONE) into a pooled texture. */
+	void ApplyProgressiveImage(TArray<uint8>&& ImageBytes, int32 PartialIndex, uint32 RequestGeneration);
+
+	/** Broadcasts a result and releases the one it replaces to the pool. */
+	void DeliverImage(UTexture2D* Texture);
 
 	FHttpRequestPtr ActiveRequest;
+	FGXRequestWatchdog Watchdog;
+	/** Image cache key of the current request. Empty if the result is not cached. */
+	FString ActiveCacheKey;
+	bool bLoadingFromCache = false;
+	/** Newest preview shown for the current progressive request; MAX_int32 once the final image is in. */
+	int32 LastProgressiveIndex = INDEX_NONE;
 #endif
 };
@@ -6,19 +6,24 @@
 #include "GameFramework/Actor.h"
 #include "Components/AudioComponent.h"
 #include "Containers/Queue.h"
+#include "Common/GXRequestWatchdog.h"
+#include "Common/GXAudioFrameSender.h"
+#include "Common/GXVoiceActivityDetector.h"
+#include "Common/GXRealtimeSpeechWave.h"
+#include "Common/GXVoiceLatencyTracker.h"
+#include "Common/GXVoiceCaptureSubsystem.h"
 #include <atomic>
 
 #if WITH_GENAI_MODULE
-#include "Components/RealtimeAudioCaptureComponent.h"
 #include "Models/OpenAI/GenOAIRealtime.h"
 #endif
 
 #include "GXOpenAIRealtimeExample.generated.h"
 
-class URealtimeAudioCaptureComponent;
 class UGenOAIRealtime;
-class USoundWaveProcedural;
 class USoundSubmix;
+class FGXRealtimeReplayHarness;
+struct FGXReplayBudgets;
 
 UENUM(BlueprintType)
 enum class ERealtimeConversationState : uint8
@@ -34,6 +39,8 @@ enum class ERealtimeConversationState : uint8
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRealtimeStateChanged, ERealtimeConversationState, NewState);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUserTranscriptUpdated, const FString&, Transcript);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAssistantTranscriptUpdated, const FString&, Transcript);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAssistantInterrupted, const FGXSpeechInterruption&, Interruption);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVoiceTurnTimings, const FGXVoiceTurnTimings&, Timings);
 
 
 UCLASS()
@@ -52,6 +59,14 @@ protected:
 public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Audio Settings")
     USoundSubmix* RecordingSubmix;
+
+    /** Microphone audio is sent to the server in frames of this length instead of once per capture callback. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Audio Settings", meta = (ClampMin = "10", ClampMax = "200", Units = "ms"))
+    int32 MicFrameMs = 40;
+
+    /** Jitter buffering and gap concealment for the assistant's speech. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Audio Settings")
+    FGXSpeechPlayoutSettings SpeechPlayout;
     
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GenAI|VAD Settings")
     bool bEnableServerVAD = true;
@@ -71,6 +86,24 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GenAI|VAD Settings")
     bool bServerVADInterruptResponse = true;
 
+    /**
+     * Detect speech on this machine and send only the user's turns, committing each one when they pause.
+     * Uses ServerVADSilenceMs and ServerVADPrefixPaddingMs, and bServerVADCreateResponse to ask for a reply.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GenAI|VAD Settings")
+    bool bEnableLocalVAD = true;
+
+    /** Quietest level that can count as speech. Raise it in noisy rooms. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GenAI|VAD Settings", meta = (EditCondition = "bEnableLocalVAD", ClampMin = "-80", ClampMax = "0", Units = "dB"))
+    float LocalVADThresholdDb = -45.f;
+
+    /**
+     * Deadlines for the realtime session. ConnectSeconds bounds the WebSocket handshake and FirstByteSeconds
+     * bounds the wait for the first audio of a response. The session itself has no total limit.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+    FGXRequestTimeouts RequestTimeouts;
+
     UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI|Realtime Example")
     void ToggleConversation(bool bShouldStart, const FString& Model = TEXT("gpt-4o"), const FString& SystemPrompt = TEXT("You are a helpful and friendly voice assistant."));
 
@@ -82,8 +115,47 @@ public:
     
     UPROPERTY(BlueprintAssignable, Category="GenAI|OpenAI|Realtime Example")
     FOnAssistantTranscriptUpdated OnAssistantTranscriptUpdated;
+
+    /**
+     * The user talked over the assistant and its speech was cut off. PlayedMs is how much of the reply was heard:
+     * the point to truncate the assistant's conversation item to (conversation.item.truncate, audio_end_ms) on
+     * sessions that can send it. The plugin's realtime service has no truncate call, so this example only reports it.
+     */
+    UPROPERTY(BlueprintAssignable, Category="GenAI|OpenAI|Realtime Example")
+    FOnAssistantInterrupted OnAssistantInterrupted;
+
+    /**
+     * Per-turn latency breakdown, from the user going quiet to the reply being heard. The same numbers are
+     * shown by "stat GXVoice" and recorded in CSV profiles (csvprofile start) under GXVoice.
+     */
+    UPROPERTY(BlueprintAssignable, Category="GenAI|OpenAI|Realtime Example")
+    FOnVoiceTurnTimings OnVoiceTurnTimings;
+
+    /** Microphone RMS level (0..1) of the latest captured audio, for a level meter. */
+    UFUNCTION(BlueprintPure, Category = "GenAI|OpenAI|Realtime Example")
+    float GetMicLevel() const { return DisplayMicRms.load(std::memory_order_relaxed); }
+
+    /** Buffer depth, jitter and underrun counters for the assistant's speech. */
+    UFUNCTION(BlueprintPure, Category = "GenAI|OpenAI|Realtime Example")
+    FGXSpeechPlayoutStats GetSpeechPlayoutStats() const;
+
+    /**
+     * Replays a recorded session instead of connecting: the WAV stands in for the microphone and the event
+     * script for the server (see FGXRealtimeReplayHarness). Only starts from Idle; ends on its own or via StopReplay.
+     * @param Speed Feed rate relative to real time. Latency stages still measure real elapsed time.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI|Realtime Example")
+    bool StartReplay(const FString& WavPath, const FString& EventScriptPath, float Speed = 1.f);
+
+    /** StartReplay that checks the run against latency, CPU and turn budgets, e.g. to fail a CI job. */
+    bool StartReplayWithBudgets(const FString& WavPath, const FString& EventScriptPath, float Speed, const FGXReplayBudgets& Budgets);
+
+    UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI|Realtime Example")
+    void StopReplay();
     
 private:
+    friend class FGXRealtimeReplayHarness;
+
     UFUNCTION() void HandleRealtimeConnected(const FString& SessionId);
     UFUNCTION() void HandleRealtimeConnectionError(int32 StatusCode, const FString& Reason, bool bWasClean);
     UFUNCTION() void HandleRealtimeDisconnected();
@@ -94,25 +166,74 @@ private:
     UFUNCTION() void HandleServerSpeechStopped(const FString& ItemId);
     UFUNCTION() void OnAIAudioFinished();
 
-    void HandleAudioGenerated(const float* InAudio, int32 NumSamples);
+    /** Network thread: stamps a response delta and returns false while it belongs to an interrupted response. */
+    bool AcceptResponseDelta();
+
+    /** Capture thread: 24 kHz mono PCM16 from the shared capture, live or injected by a replay. */
+    void HandleMicPCM(const int16* PCM, int32 NumPCM);
+
+    /** Capture thread: this session gained or lost the shared microphone. */
+    void HandleCaptureFocusChanged(bool bFocused);
+
+    /** Sets up playout, VAD and the sender for a new session. */
+    void StartSession();
+
+    /** Joins the shared capture. @return False if it could not be joined, e.g. without an input device. */
+    bool AcquireCapture();
+
+    /** Leaves the shared capture. Waits out a frame being delivered to this actor. */
+    void ReleaseCapture();
+
+    /** Sender thread: one outbound frame, and the end of a user turn. Go to the replay harness while one runs. */
+    void SendMicFrame(const TArray<uint8>& Frame);
+    void CommitUserTurn();
+
     void SetState(ERealtimeConversationState NewState);
 
     UPROPERTY()
     TObjectPtr<UObject> RealtimeService;
     
-    UPROPERTY(VisibleAnywhere, Category = "Components")
-    TObjectPtr<URealtimeAudioCaptureComponent> AudioCapture;
+    /** Registration with the world's UGXVoiceCaptureSubsystem while connected. */
+    int32 CaptureListener = INDEX_NONE;
     
     UPROPERTY()
     TObjectPtr<UAudioComponent> AIAudioPlayer;
-    UPROPERTY() TObjectPtr<USoundWaveProcedural> AIResponseWave;
+    UPROPERTY() TObjectPtr<UGXRealtimeSpeechWave> AIResponseWave;
 
     UPROPERTY() ERealtimeConversationState CurrentState;
     FString FullUserTranscript;
     FString AssistantTranscript;
     
-    std::atomic<float> DisplayMicRms;
+    std::atomic<float> DisplayMicRms{ 0.f };
+
+    /** Batches microphone PCM into MicFrameMs frames and sends them off the capture thread while connected. */
+    FGXAudioFrameSender MicSender;
+
+    /** Gates MicSender to the user's turns when bEnableLocalVAD is set. Capture thread only once configured. */
+    FGXVoiceActivityDetector MicVAD;
+
+    /** Stamped from the capture, sender, network and audio render threads. */
+    FGXVoiceLatencyTracker TurnLatency;
+
+    /**
+     * Set when the user barges in. The plugin cannot cancel or truncate a response, so the interrupted one keeps
+     * streaming; its audio and transcript are dropped until the reply to the user's committed turn starts.
+     */
+    std::atomic<bool> bDiscardResponseAudio{ false };
+
+    /** FPlatformTime::Seconds() the barged-in turn was committed, or zero while it is still open. */
+    std::atomic<double> DiscardTurnCommittedSeconds{ 0.0 };
+
+    /** FPlatformTime::Seconds() of the last response audio or transcript delta, kept or dropped. */
+    std::atomic<double> LastResponseDeltaSeconds{ 0.0 };
+
     TQueue<FString, EQueueMode::Mpsc> PendingUserTranscriptDeltas;
     TQueue<FString, EQueueMode::Mpsc> PendingAssistantTranscriptDeltas;
 
+    /** Guards the Connecting and WaitingForAI states; driven from SetState. */
+    FGXRequestWatchdog StateWatchdog;
+
+    /** Set while a replay stands in for the microphone and the server. */
+    TSharedPtr<FGXRealtimeReplayHarness> Replay;
+
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "GenAIExampleDelegates.h" // Include our central delegates
+#include "Common/GXRequestWatchdog.h"
 #if WITH_GENAI_MODULE
 #include "Models/OpenAI/GenOAIStructuredOpService.h" // Required for the async action
 #endif
@@ -32,6 +33,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI Examples")
 	void RequestStructuredOperation(const FString& UserMessage, const FString& ModelName, const FString& Schema, const FString& SystemPrompt = TEXT(""));
 
+	/** Deadlines for the structured operation. On expiry the async action is cancelled and a failure is broadcast. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+	FGXRequestTimeouts RequestTimeouts;
+
 	/** Delegate for Blueprints to receive the result of the structured operation. */
 	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
 	FOnUIStructuredOpResponse OnUIStructuredOpResponse;
@@ -49,5 +54,10 @@ private:
 #if WITH_GENAI_MODULE
 	/** A handle to the active async action, used for cancellation. */
 	TWeakObjectPtr<UGenOAIStructuredOpService> ActiveStructuredOpRequest;
+
+	/** Cancels the active action and unbinds from it so a late completion cannot reach the UI. */
+	void CancelActiveRequest();
+
+	FGXRequestWatchdog Watchdog;
 #endif
 };
\ No newline at end of file
@@ -0,0 +1,157 @@
+// Copyright 2025, Muddy Terrain Games, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Ticker.h"
+#include <atomic>
+
+class AGXOpenAIRealtimeExample;
+class UGXVoiceCaptureSubsystem;
+class FRunnableThread;
+struct FGXVoiceTurnTimings;
+
+/** Pass/fail limits for a replay, so an unattended run can gate CI. Zero disables a limit. */
+struct GENAIEXAMPLE_API FGXReplayBudgets
+{
+    /** Worst turn's TotalMs, from the user's speech end to the reply being heard. */
+    float MaxTurnMs = 0.f;
+
+    /** Capture path CPU time as a percentage of the replayed audio's duration. */
+    float MaxCapturePercent = 0.f;
+
+    /** Fails the run if any scripted turn was never triggered or never became audible. */
+    bool bRequireAllTurns = false;
+
+    /** Quits once the replay ends, with exit code 0 if every budget held and 1 otherwise. */
+    bool bExitWhenDone = false;
+};
+
+/**
+ * Replays a realtime voice session offline, for repeatable latency and CPU measurements without a microphone
+ * or the live endpoint.
+ *
+ * A WAV file is fed through UGXVoiceCaptureSubsystem::InjectAudio from its own thread, in capture-sized buffers,
+ * at real time or faster, so it takes the same conversion and delivery path as the microphone. The example's
+ * outbound audio and turn commits are routed here instead of to the realtime service, and a recorded event script
+ * plays the server's side back into the example's handlers:
+ *
+ *   { "turns": [ { "events": [ { "t_ms": 420, "type": "response.audio.delta", "delta": "<base64 PCM16>" }, ... ] } ] }
+ *
+ * Each turn starts when the example commits a user turn, or at "at_ms" into the replay if given, and its events
+ * follow at "t_ms" after that. Supported types are input_audio_buffer.speech_started / speech_stopped (with
+ * "item_id"), conversation.item.input_audio_transcription.delta, response.audio_transcript.delta and
+ * response.audio.delta. The feed CPU time and the uplink are reported at the end; per-turn latency comes from the
+ * example's latency tracker as usual, and allocations on the capture path show up under the feed thread in an
+ * Insights trace with -trace=memalloc. At speeds above 1 the playout stage still runs in real time.
+ *
+ * Run with GenAI.Realtime.Replay <WavPath> <ScriptPath> [Speed] [-MaxTurnMs=N] [-MaxCapturePercent=N]
+ * [-RequireAllTurns] [-ExitWhenDone]. With budgets, a run fails when one is exceeded; from a CI job pass the
+ * command through -ExecCmds with -ExitWhenDone and check the process exit code.
+ */
+class GENAIEXAMPLE_API FGXRealtimeReplayHarness : public FRunnable
+{
+public:
+    explicit FGXRealtimeReplayHarness(AGXOpenAIRealtimeExample* InExample);
+    virtual ~FGXRealtimeReplayHarness() override;
+
+    /** Reads a 16-bit PCM WAV and an event script. */
+    bool Load(const FString& WavPath, const FString& ScriptPath, FString& OutError);
+
+    int32 GetSampleRate() const { return SampleRate; }
+    int32 GetNumChannels() const { return NumChannels; }
+
+    /**
+     * Starts the feed thread and the server stand-in. Call on the game thread once the example's session is up
+     * and listening to the world's capture subsystem with injected input.
+     * @return False if the feed thread could not be created; nothing was started.
+     */
+    bool Start(float InSpeed, const FGXReplayBudgets& InBudgets);
+
+    /** Stops both and joins the feed thread. Safe to call more than once. */
+    void Shutdown();
+
+    /** Server stand-in. Sender thread, in place of the realtime service's SendAudioToServer. */
+    void ReceiveAudio(const TArray<uint8>& Frame);
+
+    /** Server stand-in. Sender thread, in place of CommitAudioBuffer. */
+    void ReceiveCommit();
+
+    /** Game thread. A turn's latency breakdown from the example's tracker, checked against the budgets. */
+    void ReceiveTurnTimings(const FGXVoiceTurnTimings& Timings);
+
+    //~ FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    enum class EEventType : uint8
+    {
+        SpeechStarted,
+        SpeechStopped,
+        UserTranscriptDelta,
+        AssistantTranscriptDelta,
+        AudioDelta
+    };
+
+    struct FScriptedEvent
+    {
+        double OffsetSeconds = 0.0;
+        EEventType Type = EEventType::AudioDelta;
+        FString Text;
+        TArray<uint8> Audio;
+    };
+
+    struct FScriptedTurn
+    {
+        /** Seconds into the replay, or negative to start on the next commit. */
+        double AtSeconds = -1.0;
+        TArray<FScriptedEvent> Events;
+    };
+
+    bool LoadScript(const FString& ScriptPath, FString& OutError);
+
+    /** Game thread: dispatches due server events and ends the replay once everything has played. */
+    bool Tick(float DeltaTime);
+    void Dispatch(const FScriptedEvent& Event);
+    /** Logs the results and checks them against the budgets. @return True if every budget held. */
+    bool Report() const;
+
+    AGXOpenAIRealtimeExample* Example = nullptr;
+
+    /** Fed from the feed thread. The example ends the replay in its EndPlay, before the world goes away. */
+    UGXVoiceCaptureSubsystem* Capture = nullptr;
+
+    TArray<float> Samples;
+    int32 SampleRate = 0;
+    int32 NumChannels = 0;
+    TArray<FScriptedTurn> Turns;
+
+    float Speed = 1.f;
+    FGXReplayBudgets Budgets;
+    TArray<float> TurnTotalsMs;
+    double StartSeconds = 0.0;
+    FTSTicker::FDelegateHandle TickerHandle;
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bStopping{ false };
+    std::atomic<bool> bFeedDone{ false };
+    double FeedDoneSeconds = 0.0;
+
+    /** Server stand-in state; the game thread replays one turn at a time. */
+    std::atomic<int32> CommitsReceived{ 0 };
+    int32 CommitsUsed = 0;
+    int32 NextTurn = 0;
+    int32 NextEvent = 0;
+    double TurnStartSeconds = -1.0;
+
+    /** Uplink, written by the sender thread. */
+    std::atomic<int64> UplinkBytes{ 0 };
+    std::atomic<int32> UplinkFrames{ 0 };
+
+    /** Feed thread. */
+    uint64 FeedCycles = 0;
+    uint64 MaxCallbackCycles = 0;
+    int32 Callbacks = 0;
+    double FeedWallSeconds = 0.0;
+};
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "GenAIExampleDelegates.h"
 #include "GameFramework/Actor.h"
+#include "Common/GXRequestWatchdog.h"
+#include "Common/GXImagePreprocessor.h"
 #if WITH_GENAI_MODULE
 #include "Data/XAI/GenXAIChatStructs.h" // For XAI-specific structs
 #include "Http.h"
@@ -33,6 +35,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GenAI|XAI Examples")
 	void RequestNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt = TEXT(""), UTexture2D* Image = nullptr);
 
+	/**
+	 * @brief Sends a user message with any number of images for a complete, non-streaming response.
+	 *        The images are prepared in parallel and the request is sent once all of them are ready.
+	 * @param Images Textures to attach, in order. Null entries are skipped.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|XAI Examples")
+	void RequestNonStreamingChatWithImages(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<UTexture2D*>& Images);
+
 	/**
 	 * @brief Sends a user message for a streaming response.
 	 * @param UserMessage The text from the user.
@@ -42,15 +52,35 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GenAI|XAI Examples")
 	void RequestStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt = TEXT(""), UTexture2D* Image = nullptr);
 
+	/**
+	 * @brief Sends a user message with any number of images for a streaming response.
+	 *        The images are prepared in parallel and the request is sent once all of them are ready.
+	 * @param Images Textures to attach, in order. Null entries are skipped.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|XAI Examples")
+	void RequestStreamingChatWithImages(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<UTexture2D*>& Images);
+
 	/** Clears the chat history and resets the system prompt. */
 	UFUNCTION(BlueprintCallable, Category = "GenAI | UI Example")
 	void ClearConversation();
 
+	/** Deadlines applied to every chat request. Streaming requests also use the first-byte and idle limits. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Timeouts")
+	FGXRequestTimeouts RequestTimeouts;
+
+	/** Resizes attached images to what the model actually looks at before sending them. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Image Preprocessing")
+	FGXImagePreprocessSettings ImagePreprocessing;
+
 	// -- DELEGATES FOR BLUEPRINT UI --
 
 	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
 	FOnUINonStreamingResponse OnUINonStreamingResponse;
 
+	/** Fired for each attached image with the bytes and estimated vision tokens preprocessing saved. */
+	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
+	FOnImagePreprocessed OnImagePreprocessed;
+
 	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
 	FOnUIStreamingResponseDelta OnUIStreamingResponseDelta;
 
@@ -60,15 +90,23 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "GenAI | Events")
 	FOnUIStreamingError OnUIStreamingError;
 
-#if WITH_GENAI_MODULE
 private:
+	/** Resized attachments; ConversationHistory refers to them but does not keep them alive. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UTexture2D>> SentImages;
+
+#if WITH_GENAI_MODULE
+	/** Builds and sends the user turn once its images are prepared. */
+	void SendNonStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<FGXImagePreprocessStats>& Images);
+	void SendStreamingChat(const FString& UserMessage, const FString& ModelName, const FString& SystemPrompt, const TArray<FGXImagePreprocessStats>& Images);
+
 	/**
 	 * @brief Handles raw streaming events directly from the GenXAIChatStream class.
 	 * @param EventType The kind of event (e.g., ContentDelta, Completion).
 	 * @param Payload The FString data associated with the event.
 	 * @param bSuccess True if the stream is still considered successful.
 	 */
-	void OnStreamingChatEvent(EXAIStreamEventType EventType, const FString& Payload, bool bSuccess);
+	void OnStreamingChatEvent(EXAIStreamEventType EventType, const FString& Payload, bool bSuccess, uint32 RequestGeneration);
 
 	// -- STATE MANAGEMENT --
 
@@ -78,5 +116,15 @@ private:
 	/** Keeps track of active requests to allow for cancellation. */
 	FHttpRequestPtr ActiveRequestNonStreaming;
 	FHttpRequestPtr ActiveRequestStreaming;
+
+	/** Model of the in-flight streaming request, for circuit breaker reporting. */
+	FString ActiveStreamingModel;
+
+	/** Enforce RequestTimeouts; one per request slot. */
+	FGXRequestWatchdog NonStreamingWatchdog;
+	FGXRequestWatchdog StreamingWatchdog;
+
+	/** Bumped by every send and by ClearConversation; a turn whose images finish preparing after that is dropped. */
+	uint32 PrepareGeneration = 0;
 #endif
 };